@@ -36,6 +36,7 @@ namespace Gloop {
 class Attribute : public Variable {
 // Friends
     friend class Program;
+    friend class ProgramReflection;
 private:
 // Methods
     Attribute(GLint location, const std::string& name, GLuint program, GLint size, GLenum type);
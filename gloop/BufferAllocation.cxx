@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/BufferAllocation.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs an allocation handle.
+ *
+ * @param buffer Buffer object the bytes are in
+ * @param offset Offset of the first byte in the buffer object
+ * @param size Number of bytes
+ */
+BufferAllocation::BufferAllocation(const BufferObject& buffer,
+                                   const GLintptr offset,
+                                   const GLsizeiptr size) :
+        _buffer(buffer),
+        _offset(offset),
+        _size(size) {
+    // empty
+}
+
+/**
+ * Returns the buffer object the bytes are in.
+ */
+BufferObject BufferAllocation::buffer() const {
+    return _buffer;
+}
+
+/**
+ * Returns the offset of the first byte in the buffer object.
+ */
+GLintptr BufferAllocation::offset() const {
+    return _offset;
+}
+
+/**
+ * Checks if another allocation is the same range of the same buffer object.
+ *
+ * @param allocation Other allocation to check
+ * @return `true` if buffer object, offset and size are the same
+ */
+bool BufferAllocation::operator==(const BufferAllocation& allocation) const {
+    return (_buffer == allocation._buffer)
+            && (_offset == allocation._offset)
+            && (_size == allocation._size);
+}
+
+/**
+ * Checks if another allocation is not the same range of the same buffer object.
+ *
+ * @param allocation Other allocation to check
+ * @return `true` if buffer object, offset or size are different
+ */
+bool BufferAllocation::operator!=(const BufferAllocation& allocation) const {
+    return !((*this) == allocation);
+}
+
+/**
+ * Returns the number of bytes.
+ */
+GLsizeiptr BufferAllocation::size() const {
+    return _size;
+}
+
+} /* namespace Gloop */
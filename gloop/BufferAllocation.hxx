@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_BUFFERALLOCATION_HXX
+#define GLOOP_BUFFERALLOCATION_HXX
+#include "gloop/common.h"
+#include "gloop/BufferObject.hxx"
+namespace Gloop {
+
+
+/**
+ * Range of bytes in a buffer object handed out by a @ref BufferHeap.
+ *
+ * An allocation is just a handle, so it can be copied freely.  It stays valid
+ * until it is given back with @ref BufferHeap::release or the heap is disposed.
+ */
+class BufferAllocation {
+public:
+// Methods
+    BufferAllocation(const BufferObject& buffer, GLintptr offset, GLsizeiptr size);
+    BufferObject buffer() const;
+    GLintptr offset() const;
+    bool operator==(const BufferAllocation& allocation) const;
+    bool operator!=(const BufferAllocation& allocation) const;
+    GLsizeiptr size() const;
+private:
+// Attributes
+    BufferObject _buffer;
+    GLintptr _offset;
+    GLsizeiptr _size;
+};
+
+} /* namespace Gloop */
+#endif
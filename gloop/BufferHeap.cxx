@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/BufferHeap.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Creates an empty heap.
+ *
+ * @param target Buffer target to bind pages to when allocating their storage
+ * @param pageSize Size of each page in bytes
+ * @param usage Hint for how pages will be used, e.g. `GL_STATIC_DRAW`
+ * @throws std::invalid_argument if page size is not positive
+ */
+BufferHeap::BufferHeap(const BufferTarget& target, const GLsizeiptr pageSize, const GLenum usage) :
+        _pageSize(pageSize),
+        _target(target),
+        _unused(0),
+        _usage(usage) {
+    if (pageSize <= 0) {
+        throw invalid_argument("[BufferHeap] Page size is not positive!");
+    }
+}
+
+/**
+ * Makes a page that has not been used yet.
+ *
+ * @param size Size of the page in bytes
+ */
+void BufferHeap::addPage(const GLsizeiptr size) {
+
+    // Allocate storage
+    const BufferObject buffer = BufferObject::generate();
+    _target.bind(buffer);
+    _target.data(size, NULL, _usage);
+
+    // Make all of it unused
+    _pages.push_back(Page(buffer, size));
+    insertUnused(_pages.size() - 1, 0, size);
+}
+
+/**
+ * Reserves a range of one of the pages.
+ *
+ * @param size Number of bytes to reserve
+ * @param alignment Multiple the offset must be, e.g. the size of a vertex or `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT`
+ * @return Handle for the reserved range
+ * @throws std::invalid_argument if size or alignment is not positive
+ */
+BufferAllocation BufferHeap::allocate(const GLsizeiptr size, const GLsizeiptr alignment) {
+
+    // Check arguments
+    if (size <= 0) {
+        throw invalid_argument("[BufferHeap] Size is not positive!");
+    } else if (alignment <= 0) {
+        throw invalid_argument("[BufferHeap] Alignment is not positive!");
+    }
+
+    // Find the smallest unused range that fits once aligned
+    SizeIndex::const_iterator it = _sizes.lower_bound(size);
+    GLintptr aligned = 0;
+    while (it != _sizes.end()) {
+        const GLintptr start = it->second.second;
+        aligned = ((start + alignment - 1) / alignment) * alignment;
+        if ((aligned - start) + size <= it->first) {
+            break;
+        }
+        ++it;
+    }
+
+    // Add a page if none do, whose start is always aligned
+    if (it == _sizes.end()) {
+        addPage(max(size, _pageSize));
+        it = _sizes.find(_pages.back().size);
+        while (it->second.first != _pages.size() - 1) {
+            ++it;
+        }
+        aligned = 0;
+    }
+
+    // Split the range, giving back the parts before and after
+    const size_t page = it->second.first;
+    const GLintptr start = it->second.second;
+    const GLsizeiptr length = it->first;
+    removeUnused(page, start, length);
+    if (aligned > start) {
+        insertUnused(page, start, aligned - start);
+    }
+    if (aligned + size < start + length) {
+        insertUnused(page, aligned + size, (start + length) - (aligned + size));
+    }
+
+    // Remember it so it can be released
+    const BufferObject& buffer = _pages[page].buffer;
+    _allocations[make_pair(buffer.id(), aligned)] = make_pair(page, size);
+    return BufferAllocation(buffer, aligned, size);
+}
+
+/**
+ * Returns the number of ranges currently reserved.
+ */
+size_t BufferHeap::allocations() const {
+    return _allocations.size();
+}
+
+/**
+ * Deletes all of the pages, which invalidates every allocation.
+ */
+void BufferHeap::dispose() {
+    for (size_t i = 0; i < _pages.size(); ++i) {
+        _pages[i].buffer.dispose();
+    }
+    _pages.clear();
+    _sizes.clear();
+    _allocations.clear();
+    _unused = 0;
+}
+
+/**
+ * Measures how scattered the unused space is.
+ *
+ * @return Zero if all unused space is in one range, approaching one the more ranges it is split into
+ */
+double BufferHeap::fragmentation() const {
+    if (_unused == 0) {
+        return 0.0;
+    }
+    return 1.0 - ((double) largestUnused()) / _unused;
+}
+
+/**
+ * Adds a range to the unused ranges of a page, merging it with its neighbors.
+ *
+ * @param page Index of the page
+ * @param offset Offset of the range in the page
+ * @param size Size of the range in bytes
+ */
+void BufferHeap::insertUnused(const size_t page, GLintptr offset, GLsizeiptr size) {
+
+    map<GLintptr,GLsizeiptr>& ranges = _pages[page].unused;
+
+    // Merge with the range after it
+    map<GLintptr,GLsizeiptr>::iterator next = ranges.lower_bound(offset);
+    if ((next != ranges.end()) && (next->first == offset + size)) {
+        const GLsizeiptr length = next->second;
+        removeUnused(page, next->first, length);
+        size += length;
+    }
+
+    // Merge with the range before it
+    next = ranges.lower_bound(offset);
+    if (next != ranges.begin()) {
+        map<GLintptr,GLsizeiptr>::iterator previous = next;
+        --previous;
+        if (previous->first + previous->second == offset) {
+            const GLintptr start = previous->first;
+            const GLsizeiptr length = previous->second;
+            removeUnused(page, start, length);
+            offset = start;
+            size += length;
+        }
+    }
+
+    // Index it by offset and size
+    ranges[offset] = size;
+    _sizes.insert(make_pair(size, make_pair(page, offset)));
+    _unused += size;
+}
+
+/**
+ * Returns the size of the largest range that could be reserved without adding a page.
+ */
+GLsizeiptr BufferHeap::largestUnused() const {
+    if (_sizes.empty()) {
+        return 0;
+    }
+    return _sizes.rbegin()->first;
+}
+
+/**
+ * Returns the number of buffer objects made so far.
+ */
+size_t BufferHeap::pages() const {
+    return _pages.size();
+}
+
+/**
+ * Returns the size each page is made with, unless an allocation needs more.
+ */
+GLsizeiptr BufferHeap::pageSize() const {
+    return _pageSize;
+}
+
+/**
+ * Gives back a range so it can be reserved again.
+ *
+ * @param allocation Handle for a range reserved from this heap
+ * @throws std::invalid_argument if the range is not currently reserved from this heap
+ */
+void BufferHeap::release(const BufferAllocation& allocation) {
+
+    // Find it
+    const AllocationMap::iterator it = _allocations.find(make_pair(allocation.buffer().id(), allocation.offset()));
+    if ((it == _allocations.end()) || (it->second.second != allocation.size())) {
+        throw invalid_argument("[BufferHeap] Allocation is not from this heap!");
+    }
+
+    // Make it unused again
+    insertUnused(it->second.first, allocation.offset(), allocation.size());
+    _allocations.erase(it);
+}
+
+/**
+ * Removes a range from the unused ranges of a page.
+ *
+ * @param page Index of the page
+ * @param offset Offset of the range in the page
+ * @param size Size of the range in bytes
+ */
+void BufferHeap::removeUnused(const size_t page, const GLintptr offset, const GLsizeiptr size) {
+
+    // Remove from the size index
+    SizeIndex::iterator it = _sizes.lower_bound(size);
+    while ((it->second.first != page) || (it->second.second != offset)) {
+        ++it;
+    }
+    _sizes.erase(it);
+
+    // Remove from the page
+    _pages[page].unused.erase(offset);
+    _unused -= size;
+}
+
+/**
+ * Returns the number of bytes not currently reserved in all pages.
+ */
+GLsizeiptr BufferHeap::unused() const {
+    return _unused;
+}
+
+/**
+ * Returns the number of bytes currently reserved in all pages.
+ */
+GLsizeiptr BufferHeap::used() const {
+    GLsizeiptr total = 0;
+    for (size_t i = 0; i < _pages.size(); ++i) {
+        total += _pages[i].size;
+    }
+    return total - _unused;
+}
+
+// TYPES
+
+/**
+ * Constructs a page.
+ *
+ * @param buffer Buffer object of the page
+ * @param size Size of the page in bytes
+ */
+BufferHeap::Page::Page(const BufferObject& buffer, const GLsizeiptr size) : buffer(buffer), size(size) {
+    // empty
+}
+
+} /* namespace Gloop */
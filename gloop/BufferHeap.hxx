@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_BUFFERHEAP_HXX
+#define GLOOP_BUFFERHEAP_HXX
+#include "gloop/common.h"
+#include <map>
+#include <utility>
+#include <vector>
+#include "gloop/BufferAllocation.hxx"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+namespace Gloop {
+
+
+/**
+ * Hands out ranges of a few large buffer objects instead of many small ones.
+ *
+ * Making a buffer object for every mesh costs a name and a driver allocation
+ * each, and a bind for every draw.  A _BufferHeap_ instead makes buffer objects
+ * in large _pages_, and @ref allocate hands out aligned ranges of them, so
+ * many meshes can share one buffer object and be drawn from it by offset.
+ *
+ * ~~~
+ *     BufferHeap heap(BufferTarget::arrayBuffer(), 4 * 1024 * 1024, GL_STATIC_DRAW);
+ *     const BufferAllocation a = heap.allocate(count * sizeof(Vertex), sizeof(Vertex));
+ *     target.bind(a.buffer());
+ *     target.subData(a.offset(), a.size(), vertices);
+ *     ...
+ *     heap.release(a);
+ * ~~~
+ *
+ * Unused ranges are kept sorted by size, and each allocation takes the smallest
+ * one that fits, which keeps large ranges whole for as long as possible.  When
+ * an allocation is released, it is merged with the unused ranges on either side
+ * of it.  How scattered the unused space has become is reported by
+ * @ref fragmentation.
+ *
+ * Requests larger than a page get a page of their own.  Pages are never given
+ * back before the heap is disposed.  Heaps cannot be copied, since each one
+ * owns its pages.
+ */
+class BufferHeap {
+public:
+// Methods
+    BufferHeap(const BufferTarget& target, GLsizeiptr pageSize, GLenum usage);
+    BufferAllocation allocate(GLsizeiptr size, GLsizeiptr alignment);
+    size_t allocations() const;
+    void dispose();
+    double fragmentation() const;
+    GLsizeiptr largestUnused() const;
+    size_t pages() const;
+    GLsizeiptr pageSize() const;
+    void release(const BufferAllocation& allocation);
+    GLsizeiptr unused() const;
+    GLsizeiptr used() const;
+private:
+// Types
+    struct Page {
+        BufferObject buffer;
+        GLsizeiptr size;
+        std::map<GLintptr,GLsizeiptr> unused;
+        Page(const BufferObject& buffer, GLsizeiptr size);
+    };
+    typedef std::multimap<GLsizeiptr,std::pair<size_t,GLintptr> > SizeIndex;
+    typedef std::map<std::pair<GLuint,GLintptr>,std::pair<size_t,GLsizeiptr> > AllocationMap;
+// Attributes
+    AllocationMap _allocations;
+    std::vector<Page> _pages;
+    GLsizeiptr _pageSize;
+    SizeIndex _sizes;
+    BufferTarget _target;
+    GLsizeiptr _unused;
+    GLenum _usage;
+// Methods
+    BufferHeap(const BufferHeap& heap);
+    BufferHeap& operator=(const BufferHeap& heap);
+    void addPage(GLsizeiptr size);
+    void insertUnused(size_t page, GLintptr offset, GLsizeiptr size);
+    void removeUnused(size_t page, GLintptr offset, GLsizeiptr size);
+};
+
+} /* namespace Gloop */
+#endif
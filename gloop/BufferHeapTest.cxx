@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/BufferHeap.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for `BufferHeap`.
+ */
+class BufferHeapTest {
+public:
+
+    /**
+     * Ensures allocations are aligned, share a page, and do not overlap.
+     */
+    void testAllocate() {
+
+        BufferHeap heap(BufferTarget::arrayBuffer(), 1024, GL_STATIC_DRAW);
+        const BufferAllocation a = heap.allocate(10, 4);
+        const BufferAllocation b = heap.allocate(12, 12);
+        const BufferAllocation c = heap.allocate(100, 256);
+
+        // Check alignment and placement
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 0, a.offset());
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 12, b.offset());
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 256, c.offset());
+        CPPUNIT_ASSERT(a.buffer() == b.buffer());
+        CPPUNIT_ASSERT(a.buffer() == c.buffer());
+        CPPUNIT_ASSERT_EQUAL((size_t) 1, heap.pages());
+        CPPUNIT_ASSERT_EQUAL((size_t) 3, heap.allocations());
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 122, heap.used());
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) (1024 - 122), heap.unused());
+
+        // Check data can be written to an allocation
+        const BufferTarget target = BufferTarget::arrayBuffer();
+        const GLfloat values[3] = { 1, 2, 3 };
+        target.bind(b.buffer());
+        target.subData(b.offset(), b.size(), values);
+        GLfloat actual[3];
+        glGetBufferSubData(GL_ARRAY_BUFFER, b.offset(), sizeof(actual), actual);
+        CPPUNIT_ASSERT_EQUAL(3.0f, actual[2]);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Check bad arguments
+        CPPUNIT_ASSERT_THROW(heap.allocate(0, 4), invalid_argument);
+        CPPUNIT_ASSERT_THROW(heap.allocate(4, 0), invalid_argument);
+        heap.dispose();
+    }
+
+    /**
+     * Ensures new pages are added when full, and large requests get their own page.
+     */
+    void testAllocateWhenFull() {
+
+        BufferHeap heap(BufferTarget::arrayBuffer(), 256, GL_STATIC_DRAW);
+        const BufferAllocation a = heap.allocate(200, 4);
+        const BufferAllocation b = heap.allocate(200, 4);
+        CPPUNIT_ASSERT(a.buffer() != b.buffer());
+        CPPUNIT_ASSERT_EQUAL((size_t) 2, heap.pages());
+
+        // Make one bigger than a page
+        const BufferAllocation c = heap.allocate(1000, 4);
+        CPPUNIT_ASSERT_EQUAL((size_t) 3, heap.pages());
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 0, c.offset());
+
+        // Small ones still fit in the first pages
+        const BufferAllocation d = heap.allocate(56, 4);
+        CPPUNIT_ASSERT(d.buffer() == a.buffer() || d.buffer() == b.buffer());
+        CPPUNIT_ASSERT_EQUAL((size_t) 3, heap.pages());
+        heap.dispose();
+    }
+
+    /**
+     * Ensures released ranges are merged with their neighbors.
+     */
+    void testRelease() {
+
+        BufferHeap heap(BufferTarget::arrayBuffer(), 300, GL_STATIC_DRAW);
+        const BufferAllocation a = heap.allocate(100, 1);
+        const BufferAllocation b = heap.allocate(100, 1);
+        const BufferAllocation c = heap.allocate(100, 1);
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 0, heap.unused());
+
+        // Release the outer ones, which leaves two holes
+        heap.release(a);
+        heap.release(c);
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 200, heap.unused());
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 100, heap.largestUnused());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, heap.fragmentation(), 1e-9);
+
+        // Release the middle one, which joins them all
+        heap.release(b);
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 300, heap.largestUnused());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, heap.fragmentation(), 1e-9);
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, heap.allocations());
+
+        // Check the whole page can be reused, and double releases are caught
+        const BufferAllocation d = heap.allocate(300, 4);
+        CPPUNIT_ASSERT_EQUAL((size_t) 1, heap.pages());
+        CPPUNIT_ASSERT_THROW(heap.release(a), invalid_argument);
+        heap.release(d);
+        heap.dispose();
+    }
+
+    /**
+     * Ensures the smallest range that fits is used.
+     */
+    void testReleaseThenAllocate() {
+
+        BufferHeap heap(BufferTarget::arrayBuffer(), 1000, GL_STATIC_DRAW);
+        const BufferAllocation a = heap.allocate(400, 1);
+        heap.allocate(100, 1);
+        const BufferAllocation c = heap.allocate(50, 1);
+        heap.allocate(100, 1);
+        heap.release(a);
+        heap.release(c);
+
+        // Should go in the hole left by the 50 bytes, not the 400
+        const BufferAllocation d = heap.allocate(40, 1);
+        CPPUNIT_ASSERT_EQUAL(c.offset(), d.offset());
+        heap.dispose();
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    BufferHeapTest test;
+    try {
+        test.testAllocate();
+        test.testAllocateWhenFull();
+        test.testRelease();
+        test.testReleaseThenAllocate();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/BufferMapping.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs a mapping of a buffer object that has just been mapped.
+ *
+ * @param target Buffer target the buffer object was mapped through, e.g. `GL_ARRAY_BUFFER`
+ * @param key Enumeration for querying the binding of the target
+ * @param buffer ID of the mapped buffer object
+ * @param data Pointer to the mapped memory
+ * @param offset Offset of the mapped range in the buffer object
+ * @param size Size of the mapped range in bytes
+ * @param access Access flags the range was mapped with, as for `glMapBufferRange`
+ */
+BufferMapping::BufferMapping(const GLenum target,
+                             const GLenum key,
+                             const GLuint buffer,
+                             GLvoid* data,
+                             const GLintptr offset,
+                             const GLsizeiptr size,
+                             const GLbitfield access) :
+        _access(access),
+        _buffer(buffer),
+        _data(data),
+        _key(key),
+        _offset(offset),
+        _size(size),
+        _target(target) {
+    // empty
+}
+
+/**
+ * Takes over a mapping from another mapping, which is left empty.
+ *
+ * @param mapping Mapping to take over
+ */
+BufferMapping::BufferMapping(const BufferMapping& mapping) :
+        _access(mapping._access),
+        _buffer(mapping._buffer),
+        _data(mapping._data),
+        _key(mapping._key),
+        _offset(mapping._offset),
+        _size(mapping._size),
+        _target(mapping._target) {
+    mapping._data = NULL;
+}
+
+/**
+ * Unmaps the buffer object, if still mapped.
+ */
+BufferMapping::~BufferMapping() {
+    unmap();
+}
+
+/**
+ * Returns the access flags the range was mapped with.
+ *
+ * @return Bitfield of `GL_MAP_*_BIT` flags
+ */
+GLbitfield BufferMapping::access() const {
+    return _access;
+}
+
+/**
+ * Binds the mapped buffer object to its target again, if something else was bound since.
+ */
+void BufferMapping::bind() const {
+    Context& context = Context::current();
+    if (context.integer(_key) != (GLint) _buffer) {
+        glBindBuffer(_target, _buffer);
+        context.integer(_key, _buffer);
+    }
+}
+
+/**
+ * Returns a pointer to the mapped memory.
+ *
+ * @return Pointer to the start of the mapped range, or `NULL` if not mapped
+ */
+GLvoid* BufferMapping::data() const {
+    return _data;
+}
+
+/**
+ * Tells OpenGL part of the mapped range was written to.
+ *
+ * @param offset Offset of the written bytes from the start of the mapped range
+ * @param length Number of bytes written
+ * @throws std::logic_error if not mapped with `GL_MAP_FLUSH_EXPLICIT_BIT`
+ * @throws std::out_of_range if checking and the bytes are outside the mapped range
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glFlushMappedBufferRange.xml
+ */
+void BufferMapping::flush(const GLintptr offset, const GLsizeiptr length) const {
+    if ((_data == NULL) || !(_access & GL_MAP_FLUSH_EXPLICIT_BIT)) {
+        throw logic_error("[BufferMapping] Not mapped for explicit flushing!");
+    } else if (GLOOP_CHECKS && ((offset < 0) || (length < 0) || (offset + length > _size))) {
+        throw out_of_range("[BufferMapping] Range is outside mapping!");
+    }
+    bind();
+    glFlushMappedBufferRange(_target, offset, length);
+}
+
+/**
+ * Checks if this mapping still owns mapped memory.
+ *
+ * @return `true` if not unmapped or copied yet
+ */
+bool BufferMapping::mapped() const {
+    return _data != NULL;
+}
+
+/**
+ * Unmaps the current mapping, if any, and takes over another mapping.
+ *
+ * @param mapping Mapping to take over, which is left empty
+ * @return Reference to this mapping
+ */
+BufferMapping& BufferMapping::operator=(const BufferMapping& mapping) {
+    if (this != &mapping) {
+        unmap();
+        _access = mapping._access;
+        _buffer = mapping._buffer;
+        _data = mapping._data;
+        _key = mapping._key;
+        _offset = mapping._offset;
+        _size = mapping._size;
+        _target = mapping._target;
+        mapping._data = NULL;
+    }
+    return (*this);
+}
+
+/**
+ * Returns the offset of the mapped range in the buffer object.
+ *
+ * @return Offset in bytes
+ */
+GLintptr BufferMapping::offset() const {
+    return _offset;
+}
+
+/**
+ * Returns the size of the mapped range.
+ *
+ * @return Size in bytes
+ */
+GLsizeiptr BufferMapping::size() const {
+    return _size;
+}
+
+/**
+ * Unmaps the buffer object before this mapping goes out of scope.
+ *
+ * @return `false` if the contents of the buffer object were lost while mapped
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glMapBuffer.xml
+ */
+bool BufferMapping::unmap() {
+    if (_data == NULL) {
+        return true;
+    }
+    bind();
+    _data = NULL;
+    return glUnmapBuffer(_target) == GL_TRUE;
+}
+
+} /* namespace Gloop */
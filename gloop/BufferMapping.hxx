@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_BUFFERMAPPING_HXX
+#define GLOOP_BUFFERMAPPING_HXX
+#include "gloop/common.h"
+#include <stdexcept>
+#include "gloop/Context.hxx"
+namespace Gloop {
+
+
+/**
+ * Typed view of memory in a mapped buffer object.
+ *
+ * A _BufferSpan_ does not own anything, and is only valid while the
+ * @ref BufferMapping it came from is still mapped.
+ */
+template<typename T>
+class BufferSpan {
+public:
+// Methods
+    BufferSpan(T* data, size_t size);
+    T* begin() const;
+    T* data() const;
+    bool empty() const;
+    T* end() const;
+    T& operator[](size_t i) const;
+    size_t size() const;
+private:
+// Attributes
+    T* _data;
+    size_t _size;
+};
+
+/**
+ * Buffer object mapped into memory, which is unmapped when it goes out of scope.
+ *
+ * Mappings are made by @ref BufferTarget::map and @ref BufferTarget::mapRange
+ * from the buffer object bound to a target.  Data can then be written or read
+ * in place, instead of being staged in memory and copied by OpenGL.
+ *
+ * ~~~
+ *     const BufferTarget target = BufferTarget::arrayBuffer();
+ *     target.bind(bo);
+ *     target.data(count * sizeof(Vertex), NULL, GL_STATIC_DRAW);
+ *     {
+ *         BufferMapping mapping = target.mapRange(0, count * sizeof(Vertex), GL_MAP_WRITE_BIT);
+ *         BufferSpan<Vertex> vertices = mapping.span<Vertex>();
+ *         for (size_t i = 0; i < vertices.size(); ++i) {
+ *             decode(vertices[i]);
+ *         }
+ *     }
+ * ~~~
+ *
+ * Like `std::auto_ptr`, copying a mapping transfers it, leaving the original
+ * empty, so that only one of them unmaps the buffer object.  If the buffer
+ * object is no longer bound to the target when it is unmapped or flushed, it is
+ * bound again first.
+ */
+class BufferMapping {
+// Friends
+    friend class BufferTarget;
+public:
+// Methods
+    BufferMapping(const BufferMapping& mapping);
+    ~BufferMapping();
+    GLbitfield access() const;
+    GLvoid* data() const;
+    void flush(GLintptr offset, GLsizeiptr length) const;
+    bool mapped() const;
+    BufferMapping& operator=(const BufferMapping& mapping);
+    GLintptr offset() const;
+    GLsizeiptr size() const;
+    template<typename T> BufferSpan<T> span() const;
+    bool unmap();
+private:
+// Attributes
+    GLbitfield _access;
+    GLuint _buffer;
+    mutable GLvoid* _data;
+    GLenum _key;
+    GLintptr _offset;
+    GLsizeiptr _size;
+    GLenum _target;
+// Methods
+    BufferMapping(GLenum target, GLenum key, GLuint buffer, GLvoid* data,
+                  GLintptr offset, GLsizeiptr size, GLbitfield access);
+    void bind() const;
+};
+
+/**
+ * Constructs a span over an array.
+ *
+ * @param data Pointer to the first element
+ * @param size Number of elements
+ */
+template<typename T>
+BufferSpan<T>::BufferSpan(T* data, size_t size) : _data(data), _size(size) {
+    // empty
+}
+
+/**
+ * Returns a pointer to the first element.
+ */
+template<typename T>
+T* BufferSpan<T>::begin() const {
+    return _data;
+}
+
+/**
+ * Returns a pointer to the first element.
+ */
+template<typename T>
+T* BufferSpan<T>::data() const {
+    return _data;
+}
+
+/**
+ * Checks if the span has no elements.
+ */
+template<typename T>
+bool BufferSpan<T>::empty() const {
+    return _size == 0;
+}
+
+/**
+ * Returns a pointer past the last element.
+ */
+template<typename T>
+T* BufferSpan<T>::end() const {
+    return _data + _size;
+}
+
+/**
+ * Returns a reference to an element.
+ *
+ * @param i Index of the element
+ * @throws std::out_of_range if checking and index is past the end
+ */
+template<typename T>
+T& BufferSpan<T>::operator[](const size_t i) const {
+    if (GLOOP_CHECKS && (i >= _size)) {
+        throw std::out_of_range("[BufferSpan] Index is out of range!");
+    }
+    return _data[i];
+}
+
+/**
+ * Returns the number of elements.
+ */
+template<typename T>
+size_t BufferSpan<T>::size() const {
+    return _size;
+}
+
+/**
+ * Returns a typed view of the mapped memory.
+ *
+ * @return Span over as many whole elements of type _T_ as fit in the mapping
+ * @throws std::logic_error if not mapped
+ */
+template<typename T>
+BufferSpan<T> BufferMapping::span() const {
+    if (_data == NULL) {
+        throw std::logic_error("[BufferMapping] Not mapped!");
+    }
+    return BufferSpan<T>((T*) _data, _size / sizeof(T));
+}
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include <GL/glfw.h>
+#include "gloop/BufferMapping.hxx"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for BufferMapping.
+ */
+class BufferMappingTest {
+public:
+
+    /**
+     * Checks if a buffer object is mapped according to OpenGL.
+     */
+    static bool isMapped(const BufferTarget& bt) {
+        GLint mapped;
+        glGetBufferParameteriv(bt.toEnum(), GL_BUFFER_MAPPED, &mapped);
+        return mapped == GL_TRUE;
+    }
+
+    /**
+     * Ensures copying a mapping transfers it, so the buffer is only unmapped once.
+     */
+    void testCopy() {
+
+        // Make a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        bt.data(16, NULL, GL_STATIC_DRAW);
+
+        // Copy a mapping
+        {
+            BufferMapping original = bt.map(GL_WRITE_ONLY);
+            BufferMapping copy(original);
+            CPPUNIT_ASSERT(!original.mapped());
+            CPPUNIT_ASSERT(copy.mapped());
+            CPPUNIT_ASSERT(original.unmap());
+            CPPUNIT_ASSERT(isMapped(bt));
+        }
+        CPPUNIT_ASSERT(!isMapped(bt));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        bo.dispose();
+    }
+
+    /**
+     * Ensures flushing part of a range writes it to the buffer object.
+     */
+    void testFlush() {
+
+        // Make a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        const GLint zeroes[4] = { 0, 0, 0, 0 };
+        bt.data(sizeof(zeroes), zeroes, GL_STATIC_DRAW);
+
+        // Write the last two elements and flush them
+        {
+            BufferMapping mapping = bt.mapRange(
+                    2 * sizeof(GLint),
+                    2 * sizeof(GLint),
+                    GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+            BufferSpan<GLint> span = mapping.span<GLint>();
+            CPPUNIT_ASSERT_EQUAL((size_t) 2, span.size());
+            span[0] = 3;
+            span[1] = 4;
+            mapping.flush(0, 2 * sizeof(GLint));
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Check the data
+        GLint actual[4];
+        glGetBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(actual), actual);
+        CPPUNIT_ASSERT_EQUAL(0, actual[0]);
+        CPPUNIT_ASSERT_EQUAL(0, actual[1]);
+        CPPUNIT_ASSERT_EQUAL(3, actual[2]);
+        CPPUNIT_ASSERT_EQUAL(4, actual[3]);
+
+        // Clean up
+        bt.unbind(bo);
+        bo.dispose();
+    }
+
+    /**
+     * Ensures flushing outside of the mapped range or without the flag throws.
+     */
+    void testFlushWithBadRange() {
+
+        // Make a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        bt.data(16, NULL, GL_STATIC_DRAW);
+
+        // Flush past the end
+        if (GLOOP_CHECKS) {
+            BufferMapping mapping = bt.mapRange(0, 8, GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+            CPPUNIT_ASSERT_THROW(mapping.flush(4, 8), out_of_range);
+        }
+
+        // Flush without explicit flushing
+        {
+            BufferMapping mapping = bt.mapRange(0, 8, GL_MAP_WRITE_BIT);
+            CPPUNIT_ASSERT_THROW(mapping.flush(0, 8), logic_error);
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        bo.dispose();
+    }
+
+    /**
+     * Ensures a mapping unmaps its buffer object when it goes out of scope.
+     */
+    void testScope() {
+
+        // Make a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        bt.data(4 * sizeof(GLfloat), NULL, GL_STATIC_DRAW);
+
+        // Write through a mapping
+        {
+            BufferMapping mapping = bt.map(GL_WRITE_ONLY);
+            CPPUNIT_ASSERT(isMapped(bt));
+            CPPUNIT_ASSERT_EQUAL((GLsizeiptr) (4 * sizeof(GLfloat)), mapping.size());
+            BufferSpan<GLfloat> span = mapping.span<GLfloat>();
+            for (size_t i = 0; i < span.size(); ++i) {
+                span[i] = (GLfloat) i;
+            }
+        }
+        CPPUNIT_ASSERT(!isMapped(bt));
+
+        // Read it back through another mapping
+        {
+            BufferMapping mapping = bt.mapRange(0, 4 * sizeof(GLfloat), GL_MAP_READ_BIT);
+            const BufferSpan<GLfloat> span = mapping.span<GLfloat>();
+            CPPUNIT_ASSERT_EQUAL(0.0f, span[0]);
+            CPPUNIT_ASSERT_EQUAL(3.0f, span[3]);
+            if (GLOOP_CHECKS) {
+                CPPUNIT_ASSERT_THROW(span[4], out_of_range);
+            }
+        }
+        CPPUNIT_ASSERT(!isMapped(bt));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        bo.dispose();
+    }
+
+    /**
+     * Ensures a mapping unmaps the right buffer object after another one is bound.
+     */
+    void testUnmapAfterBind() {
+
+        // Make two buffer objects
+        const BufferObject bo1 = BufferObject::generate();
+        const BufferObject bo2 = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo2);
+        bt.data(16, NULL, GL_STATIC_DRAW);
+        bt.bind(bo1);
+        bt.data(16, NULL, GL_STATIC_DRAW);
+
+        // Map the first and then bind the second
+        BufferMapping mapping = bt.map(GL_WRITE_ONLY);
+        bt.bind(bo2);
+        CPPUNIT_ASSERT(mapping.unmap());
+        CPPUNIT_ASSERT(!isMapped(bt));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo1);
+        bo1.dispose();
+        bo2.dispose();
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    BufferMappingTest test;
+    try {
+        test.testCopy();
+        test.testFlush();
+        test.testFlushWithBadRange();
+        test.testScope();
+        test.testUnmapAfterBind();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -66,9 +66,36 @@ BufferObject::~BufferObject() {
 
 /**
  * Deletes the OpenGL buffer object this handle represents.
+ *
+ * Since OpenGL unbinds a buffer object from every buffer target when it is
+ * deleted, the bindings remembered by the current context are forgotten.
  */
 void BufferObject::dispose() const {
     glDeleteBuffers(1, &_id);
+    Context::current().forgetBuffer(_id);
+}
+
+/**
+ * Records this buffer object to be deleted later with others, instead of right away.
+ *
+ * @param queue Queue to record the buffer object in
+ * @see DeletionQueue::flush
+ */
+void BufferObject::dispose(DeletionQueue& queue) const {
+    queue.enqueue(GL_BUFFER, _id);
+}
+
+/**
+ * Gives the name of this buffer object back to a pool instead of deleting it.
+ *
+ * The buffer object keeps its OpenGL state, so it can be taken from the pool
+ * again with @ref generate(NamePool&) and set up from scratch.
+ *
+ * @param pool Pool of GL_BUFFER names to give the name to
+ * @throws std::invalid_argument if the pool is not for buffer objects
+ */
+void BufferObject::dispose(NamePool& pool) const {
+    pool.release(GL_BUFFER, _id);
 }
 
 /**
@@ -104,6 +131,41 @@ BufferObject BufferObject::generate() {
     return BufferObject(id);
 }
 
+/**
+ * Creates handles for several new buffer objects at once.
+ *
+ * @param n Number of buffer objects to generate
+ * @return Handles for the new buffer objects
+ * @throws std::invalid_argument if number is negative
+ * @throws std::runtime_error if the buffer objects could not be generated
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGenBuffers.xml
+ */
+vector<BufferObject> BufferObject::generate(const GLsizei n) {
+
+    // Generate all the IDs in one call
+    const vector<GLuint> ids = NamePool::generate(GL_BUFFER, n);
+
+    // Make handles
+    vector<BufferObject> bos;
+    bos.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        bos.push_back(BufferObject(ids[i]));
+    }
+    return bos;
+}
+
+/**
+ * Creates a handle for a buffer object taken from a pool.
+ *
+ * @param pool Pool of GL_BUFFER names to take the name from
+ * @return Handle for the buffer object, which may have been used before
+ * @throws std::invalid_argument if the pool is not for buffer objects
+ * @throws std::runtime_error if the pool could not generate more names
+ */
+BufferObject BufferObject::generate(NamePool& pool) {
+    return BufferObject(pool.take(GL_BUFFER));
+}
+
 /**
  * Returns the identifer of the OpenGL buffer object this handle represents.
  */
@@ -26,6 +26,10 @@
 #ifndef GLOOP_BUFFEROBJECT_HXX
 #define GLOOP_BUFFEROBJECT_HXX
 #include "gloop/common.h"
+#include <vector>
+#include "gloop/Context.hxx"
+#include "gloop/DeletionQueue.hxx"
+#include "gloop/NamePool.hxx"
 namespace Gloop {
 
 
@@ -38,8 +42,12 @@ public:
     BufferObject(const BufferObject& bo);
     ~BufferObject();
     void dispose() const;
+    void dispose(DeletionQueue& queue) const;
+    void dispose(NamePool& pool) const;
     static BufferObject fromId(GLuint id);
     static BufferObject generate();
+    static std::vector<BufferObject> generate(GLsizei n);
+    static BufferObject generate(NamePool& pool);
     GLuint id() const;
     BufferObject& operator=(const BufferObject& bo);
     bool operator==(const BufferObject& bo) const;
@@ -46,6 +46,23 @@ public:
         CPPUNIT_ASSERT(bo.id() > 0);
     }
 
+    /**
+     * Ensures several buffer objects can be generated at once.
+     */
+    void testGenerateWithCount() {
+        const vector<BufferObject> bos = BufferObject::generate(8);
+        CPPUNIT_ASSERT_EQUAL((size_t) 8, bos.size());
+        for (size_t i = 0; i < bos.size(); ++i) {
+            CPPUNIT_ASSERT(bos[i].id() > 0);
+            for (size_t j = 0; j < i; ++j) {
+                CPPUNIT_ASSERT(bos[i] != bos[j]);
+            }
+            bos[i].dispose();
+        }
+        CPPUNIT_ASSERT(BufferObject::generate(0).empty());
+        CPPUNIT_ASSERT_THROW(BufferObject::generate(-1), invalid_argument);
+    }
+
     /**
      * Ensures wrapping a bad buffer object ID throws an exception.
      */
@@ -106,6 +123,7 @@ int main(int argc, char* argv[]) {
     BufferObjectTest test;
     try {
         test.testGenerate();
+        test.testGenerateWithCount();
         test.testFromIdWithBadId();
         test.testFromIdWithGoodId();
         test.testAddToStlMap();
@@ -24,7 +24,6 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "config.h"
-#include <cassert>
 #include <stdexcept>
 #include "gloop/BufferTarget.hxx"
 using namespace std;
@@ -70,17 +69,17 @@ BufferTarget::~BufferTarget() {
  */
 void BufferTarget::bind(const BufferObject& bo) const {
     glBindBuffer(_name, bo.id());
+    Context::current().integer(_binding, bo.id());
 }
 
 /**
  * Determines the buffer object currently being used as the data store for the buffer target.
  *
  * @return Identifier of the buffer object, or zero if nothing bound
+ * @see Context::integer(GLenum)
  */
 GLuint BufferTarget::binding() const {
-    GLint i;
-    glGetIntegerv(_binding, &i);
-    return i;
+    return (GLuint) Context::current().integer(_binding);
 }
 
 /**
@@ -108,13 +107,82 @@ bool BufferTarget::bound(const BufferObject& bo) const {
  * @param size Number of bytes to allocate or reallocate
  * @param data Data to initialize memory with, or `NULL` to leave it uninitialized
  * @param usage Hint for how the memory will be used, e.g. `GL_STATIC_DRAW`
- * @pre A buffer object is currently bound to the buffer target as its data store
+ * @throws std::logic_error if checking and no buffer object is bound to the buffer target
  */
 void BufferTarget::data(GLsizeiptr size, const GLvoid* data, GLenum usage) const {
-    assert (bound());
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[BufferTarget] No buffer object bound to target!");
+    }
     glBufferData(_name, size, data, usage);
 }
 
+/**
+ * Maps all of the buffer object currently bound to the buffer target into memory.
+ *
+ * @param access Whether the memory will be read or written, e.g. `GL_WRITE_ONLY`
+ * @return Mapping that unmaps the buffer object when it goes out of scope
+ * @throws std::logic_error if checking and no buffer object is bound to the buffer target
+ * @throws std::runtime_error if the buffer object could not be mapped
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glMapBuffer.xml
+ */
+BufferMapping BufferTarget::map(const GLenum access) const {
+
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[BufferTarget] No buffer object bound to target!");
+    }
+
+    // Convert to flags for glMapBufferRange
+    GLbitfield flags;
+    switch (access) {
+    case GL_READ_ONLY:
+        flags = GL_MAP_READ_BIT;
+        break;
+    case GL_WRITE_ONLY:
+        flags = GL_MAP_WRITE_BIT;
+        break;
+    case GL_READ_WRITE:
+        flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+        break;
+    default:
+        throw invalid_argument("[BufferTarget] Access is not GL_READ_ONLY, GL_WRITE_ONLY or GL_READ_WRITE!");
+    }
+
+    // Map the whole buffer object
+    GLint64 size;
+    glGetBufferParameteri64v(_name, GL_BUFFER_SIZE, &size);
+    GLvoid* const data = glMapBuffer(_name, access);
+    if (data == NULL) {
+        throw runtime_error("[BufferTarget] Could not map buffer!");
+    }
+    return BufferMapping(_name, _binding, binding(), data, 0, (GLsizeiptr) size, flags);
+}
+
+/**
+ * Maps part of the buffer object currently bound to the buffer target into memory.
+ *
+ * @param offset Number of bytes from the start of the buffer object to start mapping
+ * @param length Number of bytes to map
+ * @param access Bitfield of `GL_MAP_*_BIT` flags, e.g. `GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT`
+ * @return Mapping that unmaps the buffer object when it goes out of scope
+ * @throws std::logic_error if checking and no buffer object is bound to the buffer target
+ * @throws std::runtime_error if the range could not be mapped
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glMapBufferRange.xml
+ */
+BufferMapping BufferTarget::mapRange(const GLintptr offset,
+                                     const GLsizeiptr length,
+                                     const GLbitfield access) const {
+
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[BufferTarget] No buffer object bound to target!");
+    }
+
+    GLvoid* const data = glMapBufferRange(_name, offset, length, access);
+    if (data == NULL) {
+        throw runtime_error("[BufferTarget] Could not map buffer!");
+    }
+    return BufferMapping(_name, _binding, binding(), data, offset, length, access);
+}
+
 /**
  * Changes which OpenGL buffer target this handle represents.
  *
@@ -163,22 +231,36 @@ bool BufferTarget::operator<(const BufferTarget& bt) const {
  * @param offset Number of bytes from the start of the buffer object to start replacing data
  * @param size Number of bytes to copy into the buffer object
  * @param data Pointer to the data to copy into the buffer object
- * @pre A buffer object is currently bound to the buffer target as its data store
+ * @throws std::logic_error if checking and no buffer object is bound to the buffer target
  */
 void BufferTarget::subData(GLintptr offset, GLsizeiptr size, const GLvoid* data) const {
-    assert (bound());
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[BufferTarget] No buffer object bound to target!");
+    }
     glBufferSubData(_name, offset, size, data);
 }
 
+/**
+ * Returns the OpenGL enumeration for this buffer target.
+ *
+ * @return Enumeration for this buffer target, e.g. `GL_ARRAY_BUFFER`
+ */
+GLenum BufferTarget::toEnum() const {
+    return _name;
+}
+
 /**
  * Unbinds a buffer object from the OpenGL buffer target this handle represents.
  *
  * @param bo Handle for the buffer object to unbind
- * @pre Specified buffer object is currently bound to the buffer target
+ * @throws std::logic_error if checking and the buffer object is not bound to the buffer target
  */
 void BufferTarget::unbind(const BufferObject& bo) const {
-    assert (bound(bo));
+    if (GLOOP_CHECKS && !bound(bo)) {
+        throw logic_error("[BufferTarget] Buffer object not bound to target!");
+    }
     glBindBuffer(_name, 0);
+    Context::current().integer(_binding, 0);
 }
 
 // INSTANCES
@@ -204,6 +286,19 @@ BufferTarget BufferTarget::copyWriteBuffer() {
     return BufferTarget(GL_COPY_WRITE_BUFFER, GL_COPY_WRITE_BUFFER);
 }
 
+/**
+ * Returns a handle for the `GL_DRAW_INDIRECT_BUFFER` buffer target.
+ *
+ * @throws std::runtime_error if not supported by the OpenGL headers
+ */
+BufferTarget BufferTarget::drawIndirectBuffer() {
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    return BufferTarget(GL_DRAW_INDIRECT_BUFFER, GL_DRAW_INDIRECT_BUFFER_BINDING);
+#else
+    throw runtime_error("[BufferTarget] GL_DRAW_INDIRECT_BUFFER is not supported!");
+#endif
+}
+
 /**
  * Returns a handle for the `GL_ELEMENT_ARRAY_BUFFER` buffer target.
  */
@@ -211,6 +306,19 @@ BufferTarget BufferTarget::elementArrayBuffer() {
     return BufferTarget(GL_ELEMENT_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER_BINDING);
 }
 
+/**
+ * Returns a handle for the `GL_PARAMETER_BUFFER_ARB` buffer target.
+ *
+ * @throws std::runtime_error if not supported by the OpenGL headers
+ */
+BufferTarget BufferTarget::parameterBuffer() {
+#ifdef GL_PARAMETER_BUFFER_ARB
+    return BufferTarget(GL_PARAMETER_BUFFER_ARB, GL_PARAMETER_BUFFER_BINDING_ARB);
+#else
+    throw runtime_error("[BufferTarget] GL_PARAMETER_BUFFER_ARB is not supported!");
+#endif
+}
+
 /**
  * Returns a handle for the `GL_PIXEL_PACK_BUFFER` buffer target.
  */
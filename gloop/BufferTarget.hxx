@@ -26,7 +26,9 @@
 #ifndef GLOOP_BUFFER_TARGET_HXX
 #define GLOOP_BUFFER_TARGET_HXX
 #include "gloop/common.h"
+#include "gloop/BufferMapping.hxx"
 #include "gloop/BufferObject.hxx"
+#include "gloop/Context.hxx"
 namespace Gloop {
 
 
@@ -72,6 +74,21 @@ namespace Gloop {
  * ~~~
  *    bt.unbind(bo);
  * ~~~
+ *
+ * Instead of copying data in, the buffer object can also be mapped into memory
+ * and written in place.  The returned @ref BufferMapping unmaps the buffer
+ * object again when it goes out of scope.
+ *
+ * ~~~
+ *    {
+ *        BufferMapping mapping = bt.mapRange(0, sizeof(arr), GL_MAP_WRITE_BIT);
+ *        memcpy(mapping.data(), arr, sizeof(arr));
+ *    }
+ * ~~~
+ *
+ * Which buffer object is bound to each buffer target is remembered by the
+ * current @ref Context when it is changed through _BufferTarget_, so checking
+ * the binding does not need to query OpenGL.
  */
 class BufferTarget {
 public:
@@ -82,17 +99,22 @@ public:
     bool bound() const;
     bool bound(const BufferObject& bo) const;
     void data(GLsizeiptr size, const GLvoid* data, GLenum usage) const;
+    BufferMapping map(GLenum access) const;
+    BufferMapping mapRange(GLintptr offset, GLsizeiptr length, GLbitfield access) const;
     BufferTarget& operator=(const BufferTarget& bt);
     bool operator==(const BufferTarget& bt) const;
     bool operator!=(const BufferTarget& bt) const;
     bool operator<(const BufferTarget& bt) const;
     void subData(GLintptr offset, GLsizeiptr size, const GLvoid* data) const;
+    GLenum toEnum() const;
     void unbind(const BufferObject& bo) const;
 // Instances
     static BufferTarget arrayBuffer();
     static BufferTarget copyReadBuffer();
     static BufferTarget copyWriteBuffer();
+    static BufferTarget drawIndirectBuffer();
     static BufferTarget elementArrayBuffer();
+    static BufferTarget parameterBuffer();
     static BufferTarget pixelPackBuffer();
     static BufferTarget pixelUnpackBuffer();
     static BufferTarget textureBuffer();
@@ -61,6 +61,42 @@ public:
         CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, error);
     }
 
+    /**
+     * Ensures the binding is forgotten when the bound buffer object is disposed.
+     */
+    void testBoundAfterDispose() {
+
+        // Bind a buffer object and then delete it
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        bo.dispose();
+
+        // Check nothing is bound
+        CPPUNIT_ASSERT(!bt.bound());
+    }
+
+    /**
+     * Ensures bound works correctly after binding and unbinding.
+     */
+    void testBoundAfterUnbind() {
+
+        // Bind a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        CPPUNIT_ASSERT(bt.bound(bo));
+
+        // Unbind it
+        bt.unbind(bo);
+        CPPUNIT_ASSERT(!bt.bound());
+
+        // Check against OpenGL
+        GLint id;
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &id);
+        CPPUNIT_ASSERT_EQUAL(0, id);
+    }
+
     /**
      * Ensures data works correctly.
      */
@@ -100,6 +136,8 @@ int main(int argc, char* argv[]) {
     BufferTargetTest test;
     try {
         test.testBind();
+        test.testBoundAfterDispose();
+        test.testBoundAfterUnbind();
         test.testData();
     } catch (exception& e) {
         cerr << e.what() << endl;
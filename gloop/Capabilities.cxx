@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/Capabilities.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Queries all the limits of the current OpenGL context.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGet.xml
+ */
+Capabilities::Capabilities() {
+    glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &_maxColorAttachments);
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &_maxCombinedTextureImageUnits);
+    glGetIntegerv(GL_MAX_DRAW_BUFFERS, &_maxDrawBuffers);
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &_maxRenderbufferSize);
+    glGetFloatv(GL_MAX_TEXTURE_LOD_BIAS, &_maxTextureLodBias);
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &_maxTextureSize);
+    glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &_maxUniformBufferBindings);
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &_maxVertexAttribs);
+
+    // Check for optional features
+    GLint major, minor;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+#ifdef GL_MAP_PERSISTENT_BIT
+    _hasBufferStorage = (major > 4) || ((major == 4) && (minor >= 4))
+            || isExtensionSupported("GL_ARB_buffer_storage");
+#else
+    _hasBufferStorage = false;
+#endif
+#ifdef GL_PARAMETER_BUFFER_ARB
+    _hasIndirectParameters = isExtensionSupported("GL_ARB_indirect_parameters");
+#else
+    _hasIndirectParameters = false;
+#endif
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    _hasMultiDrawIndirect = (major > 4) || ((major == 4) && (minor >= 3))
+            || isExtensionSupported("GL_ARB_multi_draw_indirect");
+#else
+    _hasMultiDrawIndirect = false;
+#endif
+#ifdef GL_PRIMITIVE_RESTART_FIXED_INDEX
+    _hasPrimitiveRestartFixedIndex = (major > 4) || ((major == 4) && (minor >= 3))
+            || isExtensionSupported("GL_ARB_ES3_compatibility");
+#else
+    _hasPrimitiveRestartFixedIndex = false;
+#endif
+#ifdef GL_VERSION_4_1
+    _hasVertexAttrib64Bit = (major > 4) || ((major == 4) && (minor >= 1))
+            || isExtensionSupported("GL_ARB_vertex_attrib_64bit");
+#else
+    _hasVertexAttrib64Bit = false;
+#endif
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    _hasVertexAttribBinding = (major > 4) || ((major == 4) && (minor >= 3))
+            || isExtensionSupported("GL_ARB_vertex_attrib_binding");
+#else
+    _hasVertexAttribBinding = false;
+#endif
+
+    // Query limits of optional features
+    _maxVertexAttribBindings = 0;
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    if (_hasVertexAttribBinding) {
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIB_BINDINGS, &_maxVertexAttribBindings);
+    }
+#endif
+}
+
+/**
+ * Checks if `glBufferStorage` and persistent mapping can be used.
+ *
+ * @return `true` if OpenGL is 4.4 or newer, or supports `GL_ARB_buffer_storage`
+ */
+bool Capabilities::hasBufferStorage() const {
+    return _hasBufferStorage;
+}
+
+/**
+ * Checks if draw counts can be read from a buffer object with `glMultiDrawElementsIndirectCountARB`.
+ *
+ * @return `true` if OpenGL supports `GL_ARB_indirect_parameters`
+ */
+bool Capabilities::hasIndirectParameters() const {
+    return _hasIndirectParameters;
+}
+
+/**
+ * Checks if `glMultiDrawElementsIndirect` can be used.
+ *
+ * @return `true` if OpenGL is 4.3 or newer, or supports `GL_ARB_multi_draw_indirect`
+ */
+bool Capabilities::hasMultiDrawIndirect() const {
+    return _hasMultiDrawIndirect;
+}
+
+/**
+ * Checks if `GL_PRIMITIVE_RESTART_FIXED_INDEX` can be enabled.
+ *
+ * @return `true` if OpenGL is 4.3 or newer, or supports `GL_ARB_ES3_compatibility`
+ */
+bool Capabilities::hasPrimitiveRestartFixedIndex() const {
+    return _hasPrimitiveRestartFixedIndex;
+}
+
+/**
+ * Checks if double-precision vertex attributes can be fed with `glVertexAttribLPointer`.
+ *
+ * @return `true` if OpenGL is 4.1 or newer, or supports `GL_ARB_vertex_attrib_64bit`
+ */
+bool Capabilities::hasVertexAttrib64Bit() const {
+    return _hasVertexAttrib64Bit;
+}
+
+/**
+ * Checks if vertex formats and buffer bindings can be specified separately with `glVertexAttribFormat`.
+ *
+ * @return `true` if OpenGL is 4.3 or newer, or supports `GL_ARB_vertex_attrib_binding`
+ */
+bool Capabilities::hasVertexAttribBinding() const {
+    return _hasVertexAttribBinding;
+}
+
+/**
+ * Checks if the current OpenGL context supports an extension.
+ *
+ * @param name Name of the extension, e.g. `GL_ARB_buffer_storage`
+ * @return `true` if the extension is supported
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetString.xml
+ */
+bool Capabilities::isExtensionSupported(const char* name) {
+    GLint num;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &num);
+    for (GLint i = 0; i < num; ++i) {
+        const GLubyte* extension = glGetStringi(GL_EXTENSIONS, i);
+        if ((extension != NULL) && (strcmp((const char*) extension, name) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the value of `GL_MAX_COLOR_ATTACHMENTS`.
+ *
+ * @return Maximum number of color attachments a framebuffer can have, at least 8
+ */
+GLint Capabilities::maxColorAttachments() const {
+    return _maxColorAttachments;
+}
+
+/**
+ * Returns the value of `GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS`.
+ *
+ * @return Number of texture units this implementation supports, at least 48
+ */
+GLint Capabilities::maxCombinedTextureImageUnits() const {
+    return _maxCombinedTextureImageUnits;
+}
+
+/**
+ * Returns the value of `GL_MAX_DRAW_BUFFERS`.
+ *
+ * @return Maximum number of buffers a fragment shader can write to, at least 8
+ */
+GLint Capabilities::maxDrawBuffers() const {
+    return _maxDrawBuffers;
+}
+
+/**
+ * Returns the value of `GL_MAX_RENDERBUFFER_SIZE`.
+ *
+ * @return Maximum width and height of a renderbuffer, at least 1024
+ */
+GLsizei Capabilities::maxRenderbufferSize() const {
+    return _maxRenderbufferSize;
+}
+
+/**
+ * Returns the value of `GL_MAX_TEXTURE_LOD_BIAS`.
+ *
+ * @return Absolute value of the texture level-of-detail bias, at least 2
+ */
+GLfloat Capabilities::maxTextureLodBias() const {
+    return _maxTextureLodBias;
+}
+
+/**
+ * Returns the value of `GL_MAX_TEXTURE_SIZE`.
+ *
+ * @return Estimate of the maximum texture size this OpenGL can handle, at least 1024
+ */
+GLsizei Capabilities::maxTextureSize() const {
+    return _maxTextureSize;
+}
+
+/**
+ * Returns the value of `GL_MAX_UNIFORM_BUFFER_BINDINGS`.
+ *
+ * @return Number of binding points for uniform buffers, at least 36
+ */
+GLint Capabilities::maxUniformBufferBindings() const {
+    return _maxUniformBufferBindings;
+}
+
+/**
+ * Returns the value of `GL_MAX_VERTEX_ATTRIB_BINDINGS`.
+ *
+ * @return Number of vertex buffer binding points, at least 16, or `0` if @ref hasVertexAttribBinding is `false`
+ */
+GLint Capabilities::maxVertexAttribBindings() const {
+    return _maxVertexAttribBindings;
+}
+
+/**
+ * Returns the value of `GL_MAX_VERTEX_ATTRIBS`.
+ *
+ * @return Number of vertex attributes this implementation supports, at least 16
+ */
+GLint Capabilities::maxVertexAttribs() const {
+    return _maxVertexAttribs;
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_CAPABILITIES_HXX
+#define GLOOP_CAPABILITIES_HXX
+#include "gloop/common.h"
+namespace Gloop {
+
+
+/**
+ * Implementation-dependent limits of an OpenGL context.
+ *
+ * Limits such as `GL_MAX_TEXTURE_SIZE` never change during the life of a
+ * context, yet querying them with `glGetIntegerv` costs as much as querying any
+ * other state.  _Capabilities_ therefore queries all of them together the first
+ * time they are needed and answers from memory afterwards.  Optional features
+ * that Gloop can use when present, such as `glBufferStorage`, are detected at
+ * the same time.
+ *
+ * Each @ref Context has its own _Capabilities_.
+ *
+ * ~~~
+ *     const Capabilities& capabilities = Context::current().capabilities();
+ *     if (width > capabilities.maxTextureSize()) {
+ *         ...
+ *     }
+ * ~~~
+ */
+class Capabilities {
+public:
+// Methods
+    bool hasBufferStorage() const;
+    bool hasIndirectParameters() const;
+    bool hasMultiDrawIndirect() const;
+    bool hasPrimitiveRestartFixedIndex() const;
+    bool hasVertexAttrib64Bit() const;
+    bool hasVertexAttribBinding() const;
+    GLint maxColorAttachments() const;
+    GLint maxCombinedTextureImageUnits() const;
+    GLint maxDrawBuffers() const;
+    GLsizei maxRenderbufferSize() const;
+    GLfloat maxTextureLodBias() const;
+    GLsizei maxTextureSize() const;
+    GLint maxUniformBufferBindings() const;
+    GLint maxVertexAttribBindings() const;
+    GLint maxVertexAttribs() const;
+private:
+// Attributes
+    bool _hasBufferStorage;
+    bool _hasIndirectParameters;
+    bool _hasMultiDrawIndirect;
+    bool _hasPrimitiveRestartFixedIndex;
+    bool _hasVertexAttrib64Bit;
+    bool _hasVertexAttribBinding;
+    GLint _maxColorAttachments;
+    GLint _maxCombinedTextureImageUnits;
+    GLint _maxDrawBuffers;
+    GLint _maxRenderbufferSize;
+    GLfloat _maxTextureLodBias;
+    GLint _maxTextureSize;
+    GLint _maxUniformBufferBindings;
+    GLint _maxVertexAttribBindings;
+    GLint _maxVertexAttribs;
+// Methods
+    Capabilities();
+    static bool isExtensionSupported(const char* name);
+// Friends
+    friend class Context;
+};
+
+} /* namespace Gloop */
+#endif
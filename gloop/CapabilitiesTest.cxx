@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include <GL/glfw.h>
+#include "gloop/Capabilities.hxx"
+#include "gloop/Context.hxx"
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for Capabilities.
+ */
+class CapabilitiesTest {
+public:
+
+    /**
+     * Returns the value of an integer limit directly from OpenGL.
+     */
+    static GLint getInteger(const GLenum key) {
+        GLint value;
+        glGetIntegerv(key, &value);
+        return value;
+    }
+
+    /**
+     * Ensures the limits are kept after the context is invalidated.
+     */
+    void testInvalidate() {
+        Context& context = Context::current();
+        const Capabilities* c1 = &context.capabilities();
+        context.invalidate();
+        const Capabilities* c2 = &context.capabilities();
+        CPPUNIT_ASSERT_EQUAL(c1, c2);
+    }
+
+    /**
+     * Ensures `hasBufferStorage` is true for OpenGL 4.4 and newer.
+     */
+    void testHasBufferStorage() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        const GLint major = getInteger(GL_MAJOR_VERSION);
+        const GLint minor = getInteger(GL_MINOR_VERSION);
+        if ((major > 4) || ((major == 4) && (minor >= 4))) {
+            CPPUNIT_ASSERT(capabilities.hasBufferStorage());
+        }
+    }
+
+    /**
+     * Ensures `hasMultiDrawIndirect` is true for OpenGL 4.3 and newer.
+     */
+    void testHasMultiDrawIndirect() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        const GLint major = getInteger(GL_MAJOR_VERSION);
+        const GLint minor = getInteger(GL_MINOR_VERSION);
+        if ((major > 4) || ((major == 4) && (minor >= 3))) {
+            CPPUNIT_ASSERT(capabilities.hasMultiDrawIndirect());
+        }
+    }
+
+    /**
+     * Ensures `hasPrimitiveRestartFixedIndex` is true for OpenGL 4.3 and newer.
+     */
+    void testHasPrimitiveRestartFixedIndex() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        const GLint major = getInteger(GL_MAJOR_VERSION);
+        const GLint minor = getInteger(GL_MINOR_VERSION);
+        if ((major > 4) || ((major == 4) && (minor >= 3))) {
+            CPPUNIT_ASSERT(capabilities.hasPrimitiveRestartFixedIndex());
+        }
+    }
+
+    /**
+     * Ensures `hasVertexAttrib64Bit` is true for OpenGL 4.1 and newer.
+     */
+    void testHasVertexAttrib64Bit() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        const GLint major = getInteger(GL_MAJOR_VERSION);
+        const GLint minor = getInteger(GL_MINOR_VERSION);
+        if ((major > 4) || ((major == 4) && (minor >= 1))) {
+            CPPUNIT_ASSERT(capabilities.hasVertexAttrib64Bit());
+        }
+    }
+
+    /**
+     * Ensures `hasVertexAttribBinding` is true for OpenGL 4.3 and newer, with at least 16 bindings.
+     */
+    void testHasVertexAttribBinding() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        const GLint major = getInteger(GL_MAJOR_VERSION);
+        const GLint minor = getInteger(GL_MINOR_VERSION);
+        if ((major > 4) || ((major == 4) && (minor >= 3))) {
+            CPPUNIT_ASSERT(capabilities.hasVertexAttribBinding());
+        }
+        if (capabilities.hasVertexAttribBinding()) {
+            CPPUNIT_ASSERT(capabilities.maxVertexAttribBindings() >= 16);
+        }
+    }
+
+    /**
+     * Ensures `maxColorAttachments` matches `GL_MAX_COLOR_ATTACHMENTS`.
+     */
+    void testMaxColorAttachments() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(getInteger(GL_MAX_COLOR_ATTACHMENTS), capabilities.maxColorAttachments());
+        CPPUNIT_ASSERT(capabilities.maxColorAttachments() >= 8);
+    }
+
+    /**
+     * Ensures `maxCombinedTextureImageUnits` matches `GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS`.
+     */
+    void testMaxCombinedTextureImageUnits() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(
+                getInteger(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS),
+                capabilities.maxCombinedTextureImageUnits());
+        CPPUNIT_ASSERT(capabilities.maxCombinedTextureImageUnits() >= 48);
+    }
+
+    /**
+     * Ensures `maxDrawBuffers` matches `GL_MAX_DRAW_BUFFERS`.
+     */
+    void testMaxDrawBuffers() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(getInteger(GL_MAX_DRAW_BUFFERS), capabilities.maxDrawBuffers());
+        CPPUNIT_ASSERT(capabilities.maxDrawBuffers() >= 8);
+    }
+
+    /**
+     * Ensures `maxRenderbufferSize` matches `GL_MAX_RENDERBUFFER_SIZE`.
+     */
+    void testMaxRenderbufferSize() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(getInteger(GL_MAX_RENDERBUFFER_SIZE), capabilities.maxRenderbufferSize());
+        CPPUNIT_ASSERT(capabilities.maxRenderbufferSize() >= 1024);
+    }
+
+    /**
+     * Ensures `maxTextureLodBias` matches `GL_MAX_TEXTURE_LOD_BIAS`.
+     */
+    void testMaxTextureLodBias() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        GLfloat value;
+        glGetFloatv(GL_MAX_TEXTURE_LOD_BIAS, &value);
+        CPPUNIT_ASSERT_EQUAL(value, capabilities.maxTextureLodBias());
+        CPPUNIT_ASSERT(capabilities.maxTextureLodBias() >= 2.0f);
+    }
+
+    /**
+     * Ensures `maxTextureSize` matches `GL_MAX_TEXTURE_SIZE`.
+     */
+    void testMaxTextureSize() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(getInteger(GL_MAX_TEXTURE_SIZE), capabilities.maxTextureSize());
+        CPPUNIT_ASSERT(capabilities.maxTextureSize() >= 1024);
+    }
+
+    /**
+     * Ensures `maxUniformBufferBindings` matches `GL_MAX_UNIFORM_BUFFER_BINDINGS`.
+     */
+    void testMaxUniformBufferBindings() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(getInteger(GL_MAX_UNIFORM_BUFFER_BINDINGS), capabilities.maxUniformBufferBindings());
+        CPPUNIT_ASSERT(capabilities.maxUniformBufferBindings() >= 36);
+    }
+
+    /**
+     * Ensures `maxVertexAttribs` matches `GL_MAX_VERTEX_ATTRIBS`.
+     */
+    void testMaxVertexAttribs() {
+        const Capabilities& capabilities = Context::current().capabilities();
+        CPPUNIT_ASSERT_EQUAL(getInteger(GL_MAX_VERTEX_ATTRIBS), capabilities.maxVertexAttribs());
+        CPPUNIT_ASSERT(capabilities.maxVertexAttribs() >= 16);
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    CapabilitiesTest test;
+    try {
+        test.testInvalidate();
+        test.testHasBufferStorage();
+        test.testHasMultiDrawIndirect();
+        test.testHasPrimitiveRestartFixedIndex();
+        test.testHasVertexAttrib64Bit();
+        test.testHasVertexAttribBinding();
+        test.testMaxColorAttachments();
+        test.testMaxCombinedTextureImageUnits();
+        test.testMaxDrawBuffers();
+        test.testMaxRenderbufferSize();
+        test.testMaxTextureLodBias();
+        test.testMaxTextureSize();
+        test.testMaxUniformBufferBindings();
+        test.testMaxVertexAttribs();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
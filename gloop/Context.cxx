@@ -0,0 +1,542 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <climits>
+#include <stdexcept>
+#ifdef __APPLE__
+#include <OpenGL/OpenGL.h>
+#endif
+#ifdef HAVE_EGL_EGL_H
+#include <EGL/egl.h>
+#endif
+#include "gloop/Context.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Shadow state for each OpenGL context seen so far, by native handle.
+ */
+map<const void*,Context*> Context::_contexts;
+
+/**
+ * Mutex guarding the shadow state for each OpenGL context, shared by all threads.
+ */
+pthread_mutex_t Context::_contextsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Shadow state for the OpenGL context that was current on the last lookup from this thread.
+ */
+__thread Context* Context::_current = NULL;
+
+/**
+ * Constructs the shadow state for an OpenGL context, initially knowing nothing about it.
+ *
+ * @param handle Native handle of the OpenGL context
+ */
+Context::Context(const void* handle) : _capabilities(NULL), _handle(handle), _verifying(false) {
+    // empty
+}
+
+/**
+ * Destructs the shadow state for an OpenGL context, leaving the OpenGL context unaffected.
+ */
+Context::~Context() {
+    delete _capabilities;
+}
+
+/**
+ * Returns the implementation limits of the OpenGL context, querying them all the first time.
+ *
+ * @return Reference to the limits of the OpenGL context
+ */
+const Capabilities& Context::capabilities() {
+    if (_capabilities == NULL) {
+        _capabilities = new Capabilities();
+    }
+    return (*_capabilities);
+}
+
+/**
+ * Returns the state Gloop remembers about the OpenGL context current on this thread.
+ *
+ * @return Reference to the shadow state of the current OpenGL context
+ * @throws std::runtime_error if no OpenGL context is current on this thread
+ */
+Context& Context::current() {
+
+    // Check the last one used on this thread first
+    const void* handle = getCurrentHandle();
+    if ((_current != NULL) && (_current->_handle == handle)) {
+        return (*_current);
+    } else if (handle == NULL) {
+        throw runtime_error("[Context] No OpenGL context is current!");
+    }
+
+    // Otherwise find it, making it if this is a new context
+    Lock lock(_contextsMutex);
+    map<const void*,Context*>::iterator it = _contexts.find(handle);
+    if (it == _contexts.end()) {
+        it = _contexts.insert(pair<const void*,Context*>(handle, new Context(handle))).first;
+    }
+    _current = it->second;
+    return (*_current);
+}
+
+/**
+ * Finds the remembered divisor of a vertex attribute of the bound vertex array object.
+ *
+ * OpenGL is never asked, since that would stall.  A divisor is only known once
+ * it has been set through Gloop, so callers set it when it is not known.
+ *
+ * @param index Index of the vertex attribute
+ * @param divisor Number of instances each value of the attribute is used for, if known
+ * @return `true` if the divisor is known
+ * @throws std::logic_error if verifying and the remembered divisor differs from OpenGL
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetVertexAttrib.xml
+ */
+bool Context::findVertexAttribDivisor(const GLuint index, GLuint& divisor) {
+
+    // Look up the remembered value
+    const pair<GLuint,GLuint> key((GLuint) integer(GL_VERTEX_ARRAY_BINDING), index);
+    map<pair<GLuint,GLuint>,GLuint>::const_iterator it = _vertexAttribDivisors.find(key);
+    if (it == _vertexAttribDivisors.end()) {
+        return false;
+    }
+
+    // Check it against OpenGL if verifying
+    if (_verifying) {
+        GLint value;
+        glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &value);
+        if (it->second != (GLuint) value) {
+            throw logic_error("[Context] Remembered vertex attribute divisor differs from OpenGL!");
+        }
+    }
+    divisor = it->second;
+    return true;
+}
+
+/**
+ * Forgets the value of one piece of state so that it will be queried from OpenGL the next time it is needed.
+ *
+ * @param key Enumeration used to query the state, e.g. `GL_ARRAY_BUFFER_BINDING`
+ */
+void Context::forget(const GLenum key) {
+    _integers.erase(key);
+}
+
+/**
+ * Forgets everything about a buffer object after it has been deleted.
+ *
+ * Since OpenGL unbinds a buffer object from every buffer target it is bound to
+ * when it is deleted, those bindings are remembered as `0` from then on.  The
+ * bindings of other buffer objects are left alone.
+ *
+ * @param buffer ID of the deleted buffer object
+ */
+void Context::forgetBuffer(const GLuint buffer) {
+    static const GLenum bindings[] = {
+            GL_ARRAY_BUFFER_BINDING,
+            GL_COPY_READ_BUFFER,
+            GL_COPY_WRITE_BUFFER,
+            GL_ELEMENT_ARRAY_BUFFER_BINDING,
+            GL_PIXEL_PACK_BUFFER_BINDING,
+            GL_PIXEL_UNPACK_BUFFER_BINDING,
+            GL_TEXTURE_BUFFER,
+            GL_TRANSFORM_FEEDBACK_BUFFER_BINDING,
+            GL_UNIFORM_BUFFER_BINDING };
+    for (size_t i = 0; i < sizeof(bindings) / sizeof(bindings[0]); ++i) {
+        unbound(bindings[i], buffer);
+    }
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    unbound(GL_DRAW_INDIRECT_BUFFER_BINDING, buffer);
+#endif
+#ifdef GL_PARAMETER_BUFFER_ARB
+    unbound(GL_PARAMETER_BUFFER_BINDING_ARB, buffer);
+#endif
+}
+
+/**
+ * Forgets everything about a framebuffer object after it has been deleted.
+ *
+ * Deleting a bound framebuffer object binds the default framebuffer in its
+ * place, so those bindings are remembered as `0` from then on.
+ *
+ * @param framebuffer ID of the deleted framebuffer object
+ */
+void Context::forgetFramebuffer(const GLuint framebuffer) {
+    unbound(GL_DRAW_FRAMEBUFFER_BINDING, framebuffer);
+    unbound(GL_READ_FRAMEBUFFER_BINDING, framebuffer);
+    _framebufferAttachments.erase(framebuffer);
+}
+
+/**
+ * Forgets everything about a shader program after it has been deleted.
+ *
+ * @param program ID of the deleted shader program
+ */
+void Context::forgetProgram(const GLuint program) {
+    _programStates.erase(program);
+    _uniforms.forget(program);
+}
+
+/**
+ * Forgets everything about a renderbuffer object after it has been deleted.
+ *
+ * Deleting a renderbuffer object unbinds it, and changes the completeness of
+ * any framebuffer it was attached to.
+ *
+ * @param renderbuffer ID of the deleted renderbuffer object
+ */
+void Context::forgetRenderbuffer(const GLuint renderbuffer) {
+    unbound(GL_RENDERBUFFER_BINDING, renderbuffer);
+    touchFramebuffers(GL_RENDERBUFFER, renderbuffer);
+}
+
+/**
+ * Forgets everything about a texture object after it has been deleted.
+ *
+ * Deleting a texture object unbinds it from every texture unit it was bound
+ * to, so those bindings are remembered as `0` from then on.
+ *
+ * @param texture ID of the deleted texture object
+ */
+void Context::forgetTexture(const GLuint texture) {
+
+    // Unbind it everywhere
+    typedef map<pair<GLenum,GLenum>,GLuint>::iterator binding_iterator;
+    for (binding_iterator it = _textureBindings.begin(); it != _textureBindings.end(); ++it) {
+        if (it->second == texture) {
+            it->second = 0;
+        }
+    }
+
+    // Forget its parameters
+    typedef map<pair<GLuint,GLenum>,TextureParameters>::iterator parameters_iterator;
+    const parameters_iterator first = _textureParameters.lower_bound(pair<GLuint,GLenum>(texture, 0));
+    const parameters_iterator last = _textureParameters.upper_bound(pair<GLuint,GLenum>(texture, UINT_MAX));
+    _textureParameters.erase(first, last);
+
+    // Framebuffers it was attached to may have changed
+    touchFramebuffers(GL_TEXTURE, texture);
+}
+
+/**
+ * Forgets everything about a vertex array object after it has been deleted.
+ *
+ * Deleting the bound vertex array object binds the default one in its place,
+ * so that binding is remembered as `0` from then on, and the
+ * `GL_ELEMENT_ARRAY_BUFFER` binding that goes with it is forgotten.
+ *
+ * @param vertexArray ID of the deleted vertex array object
+ */
+void Context::forgetVertexArray(const GLuint vertexArray) {
+    unbound(GL_VERTEX_ARRAY_BINDING, vertexArray);
+    forget(GL_ELEMENT_ARRAY_BUFFER_BINDING);
+    forgetVertexAttribDivisors(vertexArray);
+}
+
+/**
+ * Forgets the divisors of every vertex attribute of a vertex array object.
+ *
+ * Changing the divisor of a binding point, or which binding point an
+ * attribute reads from, changes the divisors of the attributes using it.
+ *
+ * @param vertexArray ID of the vertex array object
+ */
+void Context::forgetVertexAttribDivisors(const GLuint vertexArray) {
+    typedef map<pair<GLuint,GLuint>,GLuint>::iterator divisor_iterator;
+    const divisor_iterator first = _vertexAttribDivisors.lower_bound(pair<GLuint,GLuint>(vertexArray, 0));
+    const divisor_iterator last = _vertexAttribDivisors.upper_bound(pair<GLuint,GLuint>(vertexArray, UINT_MAX));
+    _vertexAttribDivisors.erase(first, last);
+}
+
+/**
+ * Returns what Gloop remembers about the attachments of a framebuffer object.
+ *
+ * @param framebuffer ID of the framebuffer object
+ * @return Reference to the remembered attachments of the framebuffer object
+ */
+FramebufferAttachments& Context::framebufferAttachments(const GLuint framebuffer) {
+    return _framebufferAttachments[framebuffer];
+}
+
+/**
+ * Determines the native handle of the OpenGL context current on this thread.
+ *
+ * @return Native handle of the current OpenGL context, or `NULL` if it could not be determined
+ */
+const void* Context::getCurrentHandle() {
+#ifdef __APPLE__
+    return CGLGetCurrentContext();
+#elif defined(HAVE_EGL_EGL_H)
+    const void* handle = glXGetCurrentContext();
+    return (handle != NULL) ? handle : eglGetCurrentContext();
+#else
+    return glXGetCurrentContext();
+#endif
+}
+
+/**
+ * Retrieves the value of a piece of integer state, querying OpenGL only if it is not already known.
+ *
+ * @param key Enumeration used to query the state with `glGetIntegerv`, e.g. `GL_ARRAY_BUFFER_BINDING`
+ * @return Value of the state
+ * @throws std::logic_error if verifying and the remembered value differs from the one in OpenGL
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGet.xml
+ */
+GLint Context::integer(const GLenum key) {
+
+    // Use the remembered value if there is one
+    map<GLenum,GLint>::const_iterator it = _integers.find(key);
+    if ((it != _integers.end()) && !_verifying) {
+        return it->second;
+    }
+
+    // Otherwise ask OpenGL
+    GLint value;
+    glGetIntegerv(key, &value);
+    if ((it != _integers.end()) && (it->second != value)) {
+        throw logic_error("[Context] Remembered state differs from OpenGL!");
+    }
+
+    // Remember it for next time
+    _integers[key] = value;
+    return value;
+}
+
+/**
+ * Records a new value for a piece of integer state after it has been changed in OpenGL.
+ *
+ * @param key Enumeration used to query the state, e.g. `GL_ARRAY_BUFFER_BINDING`
+ * @param value New value of the state
+ */
+void Context::integer(const GLenum key, const GLint value) {
+    _integers[key] = value;
+}
+
+/**
+ * Forgets all remembered state except the limits of the OpenGL context so that it will be queried again as needed.
+ *
+ * Call this after changing state tracked by Gloop without going through Gloop.
+ */
+void Context::invalidate() {
+    _framebufferAttachments.clear();
+    _integers.clear();
+    _programStates.clear();
+    _textureBindings.clear();
+    _textureParameters.clear();
+    _uniforms.clear();
+    _vertexAttribDivisors.clear();
+}
+
+/**
+ * Returns what Gloop remembers about a shader program.
+ *
+ * @param program ID of the shader program
+ * @return Reference to the remembered state of the program
+ */
+ProgramState& Context::programState(const GLuint program) {
+    return _programStates[program];
+}
+
+/**
+ * Discards the state remembered about the OpenGL context current on this thread.
+ *
+ * Call this before destroying an OpenGL context.  Any references to its
+ * _Context_ are invalid afterwards.
+ */
+void Context::release() {
+
+    // Find it
+    const void* handle = getCurrentHandle();
+    Lock lock(_contextsMutex);
+    map<const void*,Context*>::iterator it = _contexts.find(handle);
+    if (it == _contexts.end()) {
+        return;
+    }
+
+    // Delete it
+    if (_current == it->second) {
+        _current = NULL;
+    }
+    delete it->second;
+    _contexts.erase(it);
+}
+
+/**
+ * Returns a uniform buffer binding point so it can be reserved again.
+ *
+ * @param binding Binding point returned by @ref reserveUniformBufferBinding
+ */
+void Context::releaseUniformBufferBinding(const GLuint binding) {
+    _uniformBufferBindings.erase(binding);
+}
+
+/**
+ * Reserves the lowest uniform buffer binding point not already reserved.
+ *
+ * @return Index of the reserved binding point
+ * @throws std::runtime_error if every binding point is already reserved
+ */
+GLuint Context::reserveUniformBufferBinding() {
+
+    // Find lowest free binding point
+    const GLuint max = capabilities().maxUniformBufferBindings();
+    GLuint binding = 0;
+    while ((binding < max) && (_uniformBufferBindings.count(binding) > 0)) {
+        ++binding;
+    }
+
+    // Reserve it
+    if (binding == max) {
+        throw runtime_error("[Context] No free uniform buffer binding points!");
+    }
+    _uniformBufferBindings.insert(binding);
+    return binding;
+}
+
+/**
+ * Retrieves the texture object bound to a target of the active texture unit, querying OpenGL only if it is not already known.
+ *
+ * @param key Enumeration used to query the binding, e.g. `GL_TEXTURE_BINDING_2D`
+ * @return ID of the texture object bound to the target, or `0` if none
+ * @throws std::logic_error if verifying and the remembered value differs from the one in OpenGL
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGet.xml
+ */
+GLuint Context::textureBinding(const GLenum key) {
+
+    // Use the remembered value if there is one
+    const pair<GLenum,GLenum> index((GLenum) integer(GL_ACTIVE_TEXTURE), key);
+    map<pair<GLenum,GLenum>,GLuint>::const_iterator it = _textureBindings.find(index);
+    if ((it != _textureBindings.end()) && !_verifying) {
+        return it->second;
+    }
+
+    // Otherwise ask OpenGL
+    GLint value;
+    glGetIntegerv(key, &value);
+    if ((it != _textureBindings.end()) && (it->second != (GLuint) value)) {
+        throw logic_error("[Context] Remembered texture binding differs from OpenGL!");
+    }
+
+    // Remember it for next time
+    _textureBindings[index] = (GLuint) value;
+    return (GLuint) value;
+}
+
+/**
+ * Records the texture object bound to a target of the active texture unit.
+ *
+ * @param key Enumeration used to query the binding, e.g. `GL_TEXTURE_BINDING_2D`
+ * @param texture ID of the texture object now bound, or `0` if none
+ */
+void Context::textureBinding(const GLenum key, const GLuint texture) {
+    _textureBindings[pair<GLenum,GLenum>((GLenum) integer(GL_ACTIVE_TEXTURE), key)] = texture;
+}
+
+/**
+ * Returns the parameters Gloop remembers for a texture object.
+ *
+ * The target is only needed to tell apart the default textures, which all
+ * have the ID `0` but are different for each target.
+ *
+ * @param target Target the texture object is bound to, e.g. `GL_TEXTURE_2D`
+ * @param texture ID of the texture object
+ * @return Reference to the remembered parameters of the texture object
+ */
+TextureParameters& Context::textureParameters(const GLenum target, const GLuint texture) {
+    return _textureParameters[pair<GLuint,GLenum>(texture, target)];
+}
+
+/**
+ * Records that an image attached to framebuffers changed, so their completeness
+ * must be checked again.
+ *
+ * @param type Type of the image, either `GL_TEXTURE` or `GL_RENDERBUFFER`
+ * @param name ID of the texture or renderbuffer that changed
+ */
+void Context::touchFramebuffers(const GLenum type, const GLuint name) {
+    map<GLuint,FramebufferAttachments>::iterator it;
+    for (it = _framebufferAttachments.begin(); it != _framebufferAttachments.end(); ++it) {
+        if (it->second.uses(type, name)) {
+            it->second.touch();
+        }
+    }
+}
+
+/**
+ * Records that an object is no longer bound, if it was remembered as bound.
+ *
+ * @param key Enumeration used to query the binding, e.g. `GL_RENDERBUFFER_BINDING`
+ * @param name ID of the object that was deleted
+ */
+void Context::unbound(const GLenum key, const GLuint name) {
+    map<GLenum,GLint>::iterator it = _integers.find(key);
+    if ((it != _integers.end()) && (it->second == (GLint) name)) {
+        it->second = 0;
+    }
+}
+
+/**
+ * Returns the values Gloop remembers loading into the uniforms of each program.
+ *
+ * @return Reference to the uniform values of the OpenGL context
+ */
+UniformCache& Context::uniforms() {
+    return _uniforms;
+}
+
+/**
+ * Checks if remembered values are being checked against OpenGL.
+ *
+ * @return `true` if remembered values are being checked against OpenGL
+ */
+bool Context::verifying() const {
+    return _verifying;
+}
+
+/**
+ * Changes whether remembered values are checked against OpenGL, which is off by default.
+ *
+ * Checking is meant for debugging, since it makes every lookup query OpenGL.
+ *
+ * @param verifying `true` to check each remembered value against OpenGL before using it
+ */
+void Context::verifying(const bool verifying) {
+    _verifying = verifying;
+}
+
+/**
+ * Remembers the divisor of a vertex attribute of the bound vertex array object.
+ *
+ * @param index Index of the vertex attribute
+ * @param divisor Divisor the attribute was just given
+ */
+void Context::vertexAttribDivisor(const GLuint index, const GLuint divisor) {
+    _vertexAttribDivisors[pair<GLuint,GLuint>((GLuint) integer(GL_VERTEX_ARRAY_BINDING), index)] = divisor;
+}
+
+} /* namespace Gloop */
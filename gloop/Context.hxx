@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_CONTEXT_HXX
+#define GLOOP_CONTEXT_HXX
+#include "gloop/common.h"
+#include <map>
+#include <set>
+#include <utility>
+#include "gloop/Capabilities.hxx"
+#include "gloop/FramebufferAttachments.hxx"
+#include "gloop/Lock.hxx"
+#include "gloop/ProgramState.hxx"
+#include "gloop/TextureParameters.hxx"
+#include "gloop/UniformCache.hxx"
+namespace Gloop {
+
+
+/**
+ * State Gloop remembers about an OpenGL context to avoid querying it.
+ *
+ * Asking OpenGL for its state, as in `glGetIntegerv`, generally forces the
+ * driver to synchronize with the graphics card, so a single query can cost far
+ * more than the call it is guarding.  To avoid that, Gloop keeps a _shadow_
+ * copy of the state it changes itself, such as which buffer object is bound to
+ * each buffer target.  The first time a value is needed it is queried from
+ * OpenGL, and from then on it is answered from memory, with each call that
+ * changes the state recording the new value.
+ *
+ * There is one _Context_ for each OpenGL context, which is looked up
+ * automatically using the context current on the calling thread.
+ *
+ * ~~~
+ *     Context& context = Context::current();
+ * ~~~
+ *
+ * Since the shadow copy only sees changes made through Gloop, calling OpenGL
+ * directly to change state that Gloop tracks will leave the copy out of date.
+ * In that case, tell the context to forget everything it knows so it will be
+ * queried again.
+ *
+ * ~~~
+ *     glBindBuffer(GL_ARRAY_BUFFER, 0);
+ *     Context::current().invalidate();
+ * ~~~
+ *
+ * When debugging, the context can also be told to check every value it answers
+ * from memory against OpenGL.  Any difference is reported by throwing a
+ * `std::logic_error`.
+ *
+ * ~~~
+ *     Context::current().verifying(true);
+ * ~~~
+ *
+ * Texture bindings are remembered for each texture unit, since OpenGL only
+ * reports those of the active texture unit.  The values loaded into uniforms,
+ * the parameters of texture objects, the attachments of framebuffer objects,
+ * and the link state of programs are remembered separately, in the context's
+ * @ref UniformCache, one @ref TextureParameters for each texture object, one
+ * @ref FramebufferAttachments for each framebuffer object, and one @ref
+ * ProgramState for each program.  @ref invalidate clears all of those too.
+ *
+ * Implementation limits, which never change, are kept separately in the
+ * context's @ref Capabilities and are not affected by @ref invalidate.  Neither
+ * are the uniform buffer binding points handed out by @ref
+ * reserveUniformBufferBinding, since those belong to Gloop rather than OpenGL.
+ *
+ * Contexts are identified using `glXGetCurrentContext` on Linux, falling back
+ * to `eglGetCurrentContext` where EGL is available, and `CGLGetCurrentContext`
+ * on Mac OS X.  Each thread looks up the context current on it, so threads
+ * with their own contexts can use Gloop at the same time.  Before destroying
+ * an OpenGL context, call @ref release while it is current, and while no other
+ * thread has it current, so its state is not mistaken for that of a new
+ * context later.
+ */
+class Context {
+public:
+// Methods
+    const Capabilities& capabilities();
+    static Context& current();
+    bool findVertexAttribDivisor(GLuint index, GLuint& divisor);
+    void forget(GLenum key);
+    void forgetBuffer(GLuint buffer);
+    void forgetFramebuffer(GLuint framebuffer);
+    void forgetProgram(GLuint program);
+    void forgetRenderbuffer(GLuint renderbuffer);
+    void forgetTexture(GLuint texture);
+    void forgetVertexArray(GLuint vertexArray);
+    void forgetVertexAttribDivisors(GLuint vertexArray);
+    FramebufferAttachments& framebufferAttachments(GLuint framebuffer);
+    GLint integer(GLenum key);
+    void integer(GLenum key, GLint value);
+    void invalidate();
+    ProgramState& programState(GLuint program);
+    static void release();
+    void releaseUniformBufferBinding(GLuint binding);
+    GLuint reserveUniformBufferBinding();
+    GLuint textureBinding(GLenum key);
+    void textureBinding(GLenum key, GLuint texture);
+    TextureParameters& textureParameters(GLenum target, GLuint texture);
+    void touchFramebuffers(GLenum type, GLuint name);
+    UniformCache& uniforms();
+    bool verifying() const;
+    void verifying(bool verifying);
+    void vertexAttribDivisor(GLuint index, GLuint divisor);
+private:
+// Attributes
+    Capabilities* _capabilities;
+    std::map<GLuint,FramebufferAttachments> _framebufferAttachments;
+    const void* _handle;
+    std::map<GLenum,GLint> _integers;
+    std::map<GLuint,ProgramState> _programStates;
+    std::map<std::pair<GLenum,GLenum>,GLuint> _textureBindings;
+    std::map<std::pair<GLuint,GLenum>,TextureParameters> _textureParameters;
+    std::set<GLuint> _uniformBufferBindings;
+    UniformCache _uniforms;
+    bool _verifying;
+    std::map<std::pair<GLuint,GLuint>,GLuint> _vertexAttribDivisors;
+    static std::map<const void*,Context*> _contexts;
+    static pthread_mutex_t _contextsMutex;
+    static __thread Context* _current;
+// Methods
+    explicit Context(const void* handle);
+    Context(const Context& context);
+    ~Context();
+    static const void* getCurrentHandle();
+    void unbound(GLenum key, GLuint name);
+    Context& operator=(const Context& context);
+};
+
+} /* namespace Gloop */
+#endif
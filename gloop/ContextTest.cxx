@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include <pthread.h>
+#include <GL/glfw.h>
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for Context.
+ */
+class ContextTest {
+public:
+
+    /**
+     * Ensures the same context is returned while the OpenGL context does not change.
+     */
+    void testCurrent() {
+        Context& c1 = Context::current();
+        Context& c2 = Context::current();
+        CPPUNIT_ASSERT_EQUAL(&c1, &c2);
+    }
+
+    /**
+     * Looks up the current context from a thread with no OpenGL context.
+     */
+    static void* lookUpCurrent(void* argument) {
+        bool* const thrown = (bool*) argument;
+        try {
+            Context::current();
+        } catch (runtime_error& e) {
+            *thrown = true;
+        }
+        return NULL;
+    }
+
+    /**
+     * Ensures a thread with no OpenGL context current does not see another thread's.
+     */
+    void testCurrentFromOtherThread() {
+        Context& context = Context::current();
+        bool thrown = false;
+        pthread_t thread;
+        pthread_create(&thread, NULL, &lookUpCurrent, &thrown);
+        pthread_join(thread, NULL);
+        CPPUNIT_ASSERT(thrown);
+        CPPUNIT_ASSERT_EQUAL(&context, &Context::current());
+    }
+
+    /**
+     * Ensures a forgotten value is queried from OpenGL again.
+     */
+    void testForget() {
+
+        // Remember a value that doesn't match OpenGL
+        Context& context = Context::current();
+        context.integer(GL_UNPACK_ALIGNMENT, 1);
+        CPPUNIT_ASSERT_EQUAL(1, context.integer(GL_UNPACK_ALIGNMENT));
+
+        // Forget it
+        context.forget(GL_UNPACK_ALIGNMENT);
+        CPPUNIT_ASSERT_EQUAL(4, context.integer(GL_UNPACK_ALIGNMENT));
+    }
+
+    /**
+     * Ensures deleting a buffer object only forgets the bindings it was bound to.
+     */
+    void testForgetBuffer() {
+
+        // Bind one buffer object and delete another
+        const BufferObject bo = BufferObject::generate();
+        const BufferObject other = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        other.dispose();
+
+        // Check the binding is still remembered, by changing it behind Gloop's back
+        Context& context = Context::current();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        CPPUNIT_ASSERT_EQUAL((GLint) bo.id(), context.integer(GL_ARRAY_BUFFER_BINDING));
+        glBindBuffer(GL_ARRAY_BUFFER, bo.id());
+
+        // Check deleting the bound one unbinds it
+        context.verifying(true);
+        bo.dispose();
+        CPPUNIT_ASSERT(!bt.bound());
+        context.verifying(false);
+    }
+
+    /**
+     * Ensures a value is answered from memory after it is recorded.
+     */
+    void testInteger() {
+
+        // Bind a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+
+        // Change the binding behind Gloop's back
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // Check the remembered value is still used
+        Context& context = Context::current();
+        CPPUNIT_ASSERT_EQUAL((GLint) bo.id(), context.integer(GL_ARRAY_BUFFER_BINDING));
+        context.invalidate();
+        bo.dispose();
+    }
+
+    /**
+     * Ensures values are queried again after invalidating the context.
+     */
+    void testInvalidate() {
+
+        // Bind a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+
+        // Change the binding behind Gloop's back
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // Check the value from OpenGL is used after invalidating
+        Context& context = Context::current();
+        context.invalidate();
+        CPPUNIT_ASSERT_EQUAL(0, context.integer(GL_ARRAY_BUFFER_BINDING));
+        CPPUNIT_ASSERT(!bt.bound());
+        bo.dispose();
+    }
+
+    /**
+     * Ensures a remembered value that differs from OpenGL is reported when verifying.
+     */
+    void testVerifyingWithStaleValue() {
+
+        // Bind a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+
+        // Change the binding behind Gloop's back
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // Check it's caught
+        Context& context = Context::current();
+        context.verifying(true);
+        CPPUNIT_ASSERT_THROW(bt.bound(), logic_error);
+        context.verifying(false);
+        context.invalidate();
+        bo.dispose();
+    }
+
+    /**
+     * Ensures a remembered value that matches OpenGL is accepted when verifying.
+     */
+    void testVerifyingWithUpToDateValue() {
+
+        // Bind a buffer object
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+
+        // Check it's accepted
+        Context& context = Context::current();
+        context.verifying(true);
+        CPPUNIT_ASSERT(bt.bound(bo));
+        bt.unbind(bo);
+        CPPUNIT_ASSERT(!bt.bound());
+        context.verifying(false);
+        bo.dispose();
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    ContextTest test;
+    try {
+        test.testCurrent();
+        test.testCurrentFromOtherThread();
+        test.testForget();
+        test.testForgetBuffer();
+        test.testInteger();
+        test.testInvalidate();
+        test.testVerifyingWithStaleValue();
+        test.testVerifyingWithUpToDateValue();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/DeletionQueue.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Creates an empty queue.
+ */
+DeletionQueue::DeletionQueue() : _pending(0) {
+    pthread_mutex_init(&_mutex, NULL);
+}
+
+/**
+ * Destroys the queue, leaving any names still in it undeleted.
+ *
+ * @see @ref dispose
+ */
+DeletionQueue::~DeletionQueue() {
+    pthread_mutex_destroy(&_mutex);
+}
+
+/**
+ * Deletes every name in the queue right away, without waiting for fences.
+ */
+void DeletionQueue::dispose() {
+
+    // Take every batch
+    list<Batch> batches;
+    {
+        Lock lock(_mutex);
+        batches.swap(_batches);
+        _pending = 0;
+    }
+
+    // Delete them without holding the lock
+    erase(batches);
+}
+
+/**
+ * Records the name of an object to delete at the next safe point.
+ *
+ * Can be called from any thread.
+ *
+ * @param type Type of the object, e.g. `GL_BUFFER` or `GL_TEXTURE`
+ * @param name Name of the object
+ * @throws std::invalid_argument if type is not supported or name is zero
+ */
+void DeletionQueue::enqueue(const GLenum type, const GLuint name) {
+
+    // Check arguments
+    switch (type) {
+    case GL_BUFFER:
+    case GL_FRAMEBUFFER:
+    case GL_RENDERBUFFER:
+    case GL_TEXTURE:
+    case GL_VERTEX_ARRAY:
+        break;
+    default:
+        throw invalid_argument("[DeletionQueue] Type is not supported!");
+    }
+    if (name == 0) {
+        throw invalid_argument("[DeletionQueue] Name is zero!");
+    }
+
+    // Add to the batch after the last fence
+    Lock lock(_mutex);
+    if (_batches.empty() || (_batches.back().fence != NULL)) {
+        _batches.push_back(Batch());
+    }
+    _batches.back().names[type].push_back(name);
+    ++_batches.back().size;
+    ++_pending;
+}
+
+/**
+ * Deletes the names in a batch with one call for each type, and its fence.
+ *
+ * @param batch Batch to delete
+ */
+void DeletionQueue::erase(Batch& batch) {
+
+    Context& context = Context::current();
+    typedef map<GLenum,vector<GLuint> >::const_iterator iterator;
+    for (iterator it = batch.names.begin(); it != batch.names.end(); ++it) {
+
+        // Delete them
+        const vector<GLuint>& names = it->second;
+        const GLsizei n = names.size();
+        switch (it->first) {
+        case GL_BUFFER:
+            glDeleteBuffers(n, &names[0]);
+            break;
+        case GL_FRAMEBUFFER:
+            glDeleteFramebuffers(n, &names[0]);
+            break;
+        case GL_RENDERBUFFER:
+            glDeleteRenderbuffers(n, &names[0]);
+            break;
+        case GL_TEXTURE:
+            glDeleteTextures(n, &names[0]);
+            break;
+        case GL_VERTEX_ARRAY:
+            glDeleteVertexArrays(n, &names[0]);
+            break;
+        }
+
+        // Forget about them
+        for (GLsizei i = 0; i < n; ++i) {
+            switch (it->first) {
+            case GL_BUFFER:
+                context.forgetBuffer(names[i]);
+                break;
+            case GL_FRAMEBUFFER:
+                context.forgetFramebuffer(names[i]);
+                break;
+            case GL_RENDERBUFFER:
+                context.forgetRenderbuffer(names[i]);
+                break;
+            case GL_TEXTURE:
+                context.forgetTexture(names[i]);
+                break;
+            case GL_VERTEX_ARRAY:
+                context.forgetVertexArray(names[i]);
+                break;
+            }
+        }
+    }
+
+    // Delete the fence
+    if (batch.fence != NULL) {
+        glDeleteSync(batch.fence);
+        batch.fence = NULL;
+    }
+}
+
+/**
+ * Deletes the names in a list of batches, in order.
+ *
+ * @param batches Batches to delete, which are removed as they are deleted
+ */
+void DeletionQueue::erase(list<Batch>& batches) {
+    while (!batches.empty()) {
+        erase(batches.front());
+        batches.pop_front();
+    }
+}
+
+/**
+ * Keeps the names recorded so far until OpenGL finishes the commands issued so far.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glFenceSync.xml
+ */
+void DeletionQueue::fence() {
+    Lock lock(_mutex);
+    if (!_batches.empty() && (_batches.back().fence == NULL)) {
+        _batches.back().fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+/**
+ * Deletes the names that are safe to delete, without waiting.
+ *
+ * Stops at the first batch whose fence has not been passed yet, so names are
+ * always deleted in the order they were recorded.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glClientWaitSync.xml
+ */
+void DeletionQueue::flush() {
+
+    // Take the batches OpenGL is done with
+    list<Batch> batches;
+    {
+        Lock lock(_mutex);
+        while (!_batches.empty()) {
+            Batch& batch = _batches.front();
+            if (batch.fence != NULL) {
+                const GLenum result = glClientWaitSync(batch.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+                if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED)) {
+                    break;
+                }
+            }
+            _pending -= batch.size;
+            batches.splice(batches.end(), _batches, _batches.begin());
+        }
+    }
+
+    // Delete them without holding the lock
+    erase(batches);
+}
+
+/**
+ * Returns the number of names still waiting to be deleted.
+ */
+size_t DeletionQueue::pending() const {
+    Lock lock(_mutex);
+    return _pending;
+}
+
+// TYPES
+
+/**
+ * Constructs an empty batch that is not fenced.
+ */
+DeletionQueue::Batch::Batch() : fence(NULL), size(0) {
+    // empty
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_DELETIONQUEUE_HXX
+#define GLOOP_DELETIONQUEUE_HXX
+#include "gloop/common.h"
+#include <list>
+#include <map>
+#include <vector>
+#include <pthread.h>
+#include "gloop/Context.hxx"
+#include "gloop/Lock.hxx"
+#include "gloop/NamePool.hxx"
+namespace Gloop {
+
+
+/**
+ * Objects waiting to be deleted together at a safe point.
+ *
+ * Disposing of an object normally deletes it right away, with one call to
+ * `glDelete*` for each object.  Disposing of it with a _DeletionQueue_ instead
+ * just records its name, and @ref flush later deletes all the recorded names of
+ * each type with one call.  Since recording a name does not call OpenGL, objects
+ * can be disposed of from anywhere, as long as the queue is flushed from the
+ * thread the OpenGL context is current on.
+ *
+ * ~~~
+ *     DeletionQueue queue;
+ *     ...
+ *     bo.dispose(queue);
+ *     to.dispose(queue);
+ *     ...
+ *     // End of frame
+ *     queue.fence();
+ *     queue.flush();
+ * ~~~
+ *
+ * Names recorded before @ref fence is called are kept until OpenGL has finished
+ * the commands issued before the fence, so objects still used by frames in
+ * flight are not deleted under them.  Names recorded after the last fence are
+ * deleted by the next @ref flush regardless.
+ *
+ * Recording a name and taking names out of the queue are done under a lock,
+ * so worker threads can dispose of objects while the OpenGL thread flushes.
+ * The lock is not held while names are deleted.  Queues cannot be copied,
+ * since each one owns its fences and lock.  Call @ref dispose to delete everything left
+ * in a queue right away.
+ */
+class DeletionQueue {
+public:
+// Methods
+    DeletionQueue();
+    ~DeletionQueue();
+    void dispose();
+    void enqueue(GLenum type, GLuint name);
+    void fence();
+    void flush();
+    size_t pending() const;
+private:
+// Types
+    struct Batch {
+        GLsync fence;
+        std::map<GLenum,std::vector<GLuint> > names;
+        size_t size;
+        Batch();
+    };
+// Attributes
+    std::list<Batch> _batches;
+    mutable pthread_mutex_t _mutex;
+    size_t _pending;
+// Methods
+    DeletionQueue(const DeletionQueue& queue);
+    DeletionQueue& operator=(const DeletionQueue& queue);
+    static void erase(Batch& batch);
+    static void erase(std::list<Batch>& batches);
+};
+
+} /* namespace Gloop */
+#endif
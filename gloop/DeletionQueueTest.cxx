@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include <vector>
+#include <pthread.h>
+#include "gloop/common.h"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/DeletionQueue.hxx"
+#include "gloop/TextureObject.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for `DeletionQueue`.
+ */
+class DeletionQueueTest {
+public:
+
+    /**
+     * Names a worker thread disposes of, and the queue to record them in.
+     */
+    struct Work {
+        DeletionQueue* queue;
+        const std::vector<BufferObject>* buffers;
+        size_t first;
+        size_t count;
+    };
+
+    /**
+     * Disposes of a range of buffer objects from a worker thread.
+     */
+    static void* disposeBuffers(void* argument) {
+        const Work* work = (const Work*) argument;
+        for (size_t i = work->first; i < work->first + work->count; ++i) {
+            (*work->buffers)[i].dispose(*work->queue);
+        }
+        return NULL;
+    }
+
+    /**
+     * Ensures names recorded from worker threads while flushing are all deleted.
+     */
+    void testEnqueueFromThreads() {
+
+        // Make buffers for each thread to dispose of
+        const size_t THREADS = 4;
+        const size_t COUNT = 250;
+        DeletionQueue queue;
+        const std::vector<BufferObject> buffers = BufferObject::generate(THREADS * COUNT);
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            bt.bind(buffers[i]);
+            bt.unbind(buffers[i]);
+        }
+        CPPUNIT_ASSERT(glIsBuffer(buffers.back().id()));
+
+        // Dispose of them from workers while flushing
+        pthread_t threads[THREADS];
+        Work work[THREADS];
+        for (size_t t = 0; t < THREADS; ++t) {
+            work[t].queue = &queue;
+            work[t].buffers = &buffers;
+            work[t].first = t * COUNT;
+            work[t].count = COUNT;
+            pthread_create(&threads[t], NULL, &disposeBuffers, &work[t]);
+        }
+        for (int i = 0; i < 100; ++i) {
+            queue.fence();
+            queue.flush();
+        }
+        for (size_t t = 0; t < THREADS; ++t) {
+            pthread_join(threads[t], NULL);
+        }
+
+        // Check every one was deleted
+        glFinish();
+        queue.flush();
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, queue.pending());
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            CPPUNIT_ASSERT(!glIsBuffer(buffers[i].id()));
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+    }
+
+    /**
+     * Ensures names are only deleted when flushed.
+     */
+    void testFlush() {
+
+        DeletionQueue queue;
+        const BufferObject bo = BufferObject::generate();
+        const TextureObject to = TextureObject::generate();
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        to.dispose(queue);
+        bo.dispose(queue);
+        vao.dispose(queue);
+        CPPUNIT_ASSERT_EQUAL((size_t) 3, queue.pending());
+        CPPUNIT_ASSERT(glIsBuffer(bo.id()));
+        CPPUNIT_ASSERT(bt.bound(bo));
+
+        // Flush
+        queue.flush();
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, queue.pending());
+        CPPUNIT_ASSERT(!glIsBuffer(bo.id()));
+        CPPUNIT_ASSERT(!glIsTexture(to.id()));
+        CPPUNIT_ASSERT(!glIsVertexArray(vao.id()));
+        CPPUNIT_ASSERT(!bt.bound());
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+    }
+
+    /**
+     * Ensures fenced names are deleted once OpenGL passes the fence.
+     */
+    void testFlushWithFence() {
+
+        DeletionQueue queue;
+        const BufferObject b1 = BufferObject::generate();
+        const BufferObject b2 = BufferObject::generate();
+        b1.dispose(queue);
+        queue.fence();
+        b2.dispose(queue);
+        CPPUNIT_ASSERT_EQUAL((size_t) 2, queue.pending());
+
+        // Wait for OpenGL, then flush both
+        glFinish();
+        queue.flush();
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, queue.pending());
+        CPPUNIT_ASSERT(!glIsBuffer(b1.id()));
+        CPPUNIT_ASSERT(!glIsBuffer(b2.id()));
+
+        // Dispose deletes everything even if fenced
+        const BufferObject b3 = BufferObject::generate();
+        b3.dispose(queue);
+        queue.fence();
+        queue.dispose();
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, queue.pending());
+        CPPUNIT_ASSERT(!glIsBuffer(b3.id()));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+    }
+
+    /**
+     * Ensures bad names and types are rejected.
+     */
+    void testEnqueueWithBadArguments() {
+        DeletionQueue queue;
+        CPPUNIT_ASSERT_THROW(queue.enqueue(GL_ARRAY_BUFFER, 1), invalid_argument);
+        CPPUNIT_ASSERT_THROW(queue.enqueue(GL_BUFFER, 0), invalid_argument);
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, queue.pending());
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    DeletionQueueTest test;
+    try {
+        test.testFlush();
+        test.testFlushWithFence();
+        test.testEnqueueWithBadArguments();
+        test.testEnqueueFromThreads();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/DrawCall.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs a draw call that has already been checked.
+ *
+ * @param vao Vertex array object to draw from
+ * @param program Program to draw with
+ * @param command Parameters of the command
+ * @param function OpenGL function to call
+ */
+DrawCall::DrawCall(const VertexArrayObject& vao,
+                   const Program& program,
+                   const DrawCommand& command,
+                   const Function function) :
+        _command(command),
+        _function(function),
+        _program(program),
+        _restartable((command._type != GL_NONE)
+                && Context::current().capabilities().hasPrimitiveRestartFixedIndex()),
+        _vao(vao) {
+    // empty
+}
+
+/**
+ * Checks a drawing command and prepares it to be submitted.
+ *
+ * @param vao Vertex array object to draw from
+ * @param program Program to draw with
+ * @param command Parameters of the command
+ * @return Draw call that can be submitted
+ * @throws std::invalid_argument if the parameters are not valid or cannot be used together
+ * @throws std::logic_error if the program is not linked, indexed and the vertex array object has no element array buffer,
+ *                          or primitive restart is used without support for `GL_PRIMITIVE_RESTART_FIXED_INDEX`
+ * @throws std::out_of_range if indexed and the indices run past the end of the element array buffer
+ */
+DrawCall DrawCall::bake(const VertexArrayObject& vao,
+                        const Program& program,
+                        const DrawCommand& command) {
+
+    // Check parameters common to all commands
+    if (!isMode(command._mode)) {
+        throw invalid_argument("[DrawCall] Mode is not a kind of primitive!");
+    } else if (command._count < 0) {
+        throw invalid_argument("[DrawCall] Count is negative!");
+    } else if (command._instances < 0) {
+        throw invalid_argument("[DrawCall] Number of instances is negative!");
+    }
+
+    // Check program
+    if (!program.linked()) {
+        throw logic_error("[DrawCall] Program is not linked!");
+    }
+
+    // Handle commands without indices
+    if (command._type == GL_NONE) {
+        if (command._first < 0) {
+            throw invalid_argument("[DrawCall] First is negative!");
+        } else if ((command._baseVertex != 0) || command._ranged || command._primitiveRestart) {
+            throw invalid_argument("[DrawCall] Base vertex, range and primitive restart need an index type!");
+        }
+        return DrawCall(vao, program, command, command._instanced ? ARRAYS_INSTANCED : ARRAYS);
+    }
+
+    // Check index parameters
+    const GLsizei size = sizeOfIndex(command._type);
+    if (size == 0) {
+        throw invalid_argument("[DrawCall] Type is not GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT!");
+    } else if ((command._offset < 0) || (command._offset % size != 0)) {
+        throw invalid_argument("[DrawCall] Offset is not a multiple of the index size!");
+    } else if (command._ranged && (command._start > command._end)) {
+        throw invalid_argument("[DrawCall] Start of range is greater than end!");
+    } else if (command._ranged && command._instanced) {
+        throw invalid_argument("[DrawCall] Range cannot be used with instances!");
+    }
+
+    // Check primitive restart
+    if (command._primitiveRestart && !Context::current().capabilities().hasPrimitiveRestartFixedIndex()) {
+        throw logic_error("[DrawCall] Primitive restart with a fixed index is not supported!");
+    }
+
+    // Check indices fit in the element array buffer
+    vao.bind();
+    if (Context::current().integer(GL_ELEMENT_ARRAY_BUFFER_BINDING) == 0) {
+        throw logic_error("[DrawCall] No element array buffer in vertex array object!");
+    }
+    GLint length;
+    glGetBufferParameteriv(GL_ELEMENT_ARRAY_BUFFER, GL_BUFFER_SIZE, &length);
+    if (command._offset + ((GLsizeiptr) command._count) * size > length) {
+        throw out_of_range("[DrawCall] Indices run past the end of the element array buffer!");
+    }
+
+    // Choose function
+    Function function;
+    if (command._ranged) {
+        function = (command._baseVertex != 0) ? RANGE_ELEMENTS_BASE_VERTEX : RANGE_ELEMENTS;
+    } else if (command._instanced) {
+        function = (command._baseVertex != 0) ? ELEMENTS_INSTANCED_BASE_VERTEX : ELEMENTS_INSTANCED;
+    } else {
+        function = (command._baseVertex != 0) ? ELEMENTS_BASE_VERTEX : ELEMENTS;
+    }
+    return DrawCall(vao, program, command, function);
+}
+
+/**
+ * Checks if an enumeration is a kind of primitive that can be drawn.
+ *
+ * @param mode Enumeration to check
+ * @return `true` if the enumeration is a kind of primitive
+ */
+bool DrawCall::isMode(const GLenum mode) {
+    switch (mode) {
+    case GL_POINTS:
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+    case GL_LINES:
+    case GL_LINE_STRIP_ADJACENCY:
+    case GL_LINES_ADJACENCY:
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+    case GL_TRIANGLES:
+    case GL_TRIANGLE_STRIP_ADJACENCY:
+    case GL_TRIANGLES_ADJACENCY:
+#ifdef GL_PATCHES
+    case GL_PATCHES:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Turns primitive restart with a fixed index on or off, unless it already is.
+ *
+ * @param enabled `true` to enable `GL_PRIMITIVE_RESTART_FIXED_INDEX`
+ */
+void DrawCall::primitiveRestart(const bool enabled) {
+#ifdef GL_PRIMITIVE_RESTART_FIXED_INDEX
+    Context& context = Context::current();
+    const GLint value = enabled ? GL_TRUE : GL_FALSE;
+    if (context.integer(GL_PRIMITIVE_RESTART_FIXED_INDEX) != value) {
+        if (enabled) {
+            glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+        } else {
+            glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+        }
+        context.integer(GL_PRIMITIVE_RESTART_FIXED_INDEX, value);
+    }
+#endif
+}
+
+/**
+ * Returns the program drawn with.
+ */
+Program DrawCall::program() const {
+    return _program;
+}
+
+/**
+ * Determines the size of an index type.
+ *
+ * @param type Type of index, e.g. `GL_UNSIGNED_SHORT`
+ * @return Size of the index in bytes, or `0` if not an index type
+ */
+GLsizei DrawCall::sizeOfIndex(const GLenum type) {
+    switch (type) {
+    case GL_UNSIGNED_BYTE:
+        return sizeof(GLubyte);
+    case GL_UNSIGNED_SHORT:
+        return sizeof(GLushort);
+    case GL_UNSIGNED_INT:
+        return sizeof(GLuint);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Draws, making the program and vertex array object current first if needed.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glDrawArrays.xml
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glDrawElements.xml
+ */
+void DrawCall::submit() const {
+
+    // Make current
+    _program.use();
+    _vao.bind();
+    if (_restartable) {
+        primitiveRestart(_command._primitiveRestart);
+    }
+
+    // Draw
+    const DrawCommand& c = _command;
+    const GLvoid* indices = (const GLvoid*) c._offset;
+    switch (_function) {
+    case ARRAYS:
+        glDrawArrays(c._mode, c._first, c._count);
+        break;
+    case ARRAYS_INSTANCED:
+        glDrawArraysInstanced(c._mode, c._first, c._count, c._instances);
+        break;
+    case ELEMENTS:
+        glDrawElements(c._mode, c._count, c._type, indices);
+        break;
+    case ELEMENTS_BASE_VERTEX:
+        glDrawElementsBaseVertex(c._mode, c._count, c._type, (GLvoid*) indices, c._baseVertex);
+        break;
+    case ELEMENTS_INSTANCED:
+        glDrawElementsInstanced(c._mode, c._count, c._type, indices, c._instances);
+        break;
+    case ELEMENTS_INSTANCED_BASE_VERTEX:
+        glDrawElementsInstancedBaseVertex(c._mode, c._count, c._type, (GLvoid*) indices, c._instances, c._baseVertex);
+        break;
+    case RANGE_ELEMENTS:
+        glDrawRangeElements(c._mode, c._start, c._end, c._count, c._type, indices);
+        break;
+    case RANGE_ELEMENTS_BASE_VERTEX:
+        glDrawRangeElementsBaseVertex(c._mode, c._start, c._end, c._count, c._type, (GLvoid*) indices, c._baseVertex);
+        break;
+    }
+}
+
+/**
+ * Returns the vertex array object drawn from.
+ */
+VertexArrayObject DrawCall::vertexArrayObject() const {
+    return _vao;
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_DRAWCALL_HXX
+#define GLOOP_DRAWCALL_HXX
+#include "gloop/common.h"
+#include "gloop/Context.hxx"
+#include "gloop/DrawCommand.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/VertexArrayObject.hxx"
+namespace Gloop {
+
+
+/**
+ * Drawing command checked once and ready to be submitted many times.
+ *
+ * Drawing is the most frequent call in a frame, so checking everything about
+ * it each time would cost more than the draw itself.  Instead, @ref bake checks
+ * a @ref DrawCommand against the vertex array object and program it will be
+ * used with, and chooses which OpenGL function to call.  After that, @ref submit
+ * just makes sure the program and vertex array object are current, using the
+ * bindings remembered by the current @ref Context, and makes the call.
+ *
+ * ~~~
+ *     // When loading
+ *     const DrawCall call = DrawCall::bake(vao, program, DrawCommand()
+ *             .type(GL_UNSIGNED_SHORT)
+ *             .count(indexCount)
+ *             .instances(instanceCount));
+ *
+ *     // Every frame
+ *     call.submit();
+ * ~~~
+ *
+ * Commands using primitive restart turn on `GL_PRIMITIVE_RESTART_FIXED_INDEX`
+ * when submitted, and other indexed commands turn it off again, so indices
+ * that happen to equal the restart index are drawn normally.
+ *
+ * Baking binds the vertex array object to look at its element array buffer.
+ * If the vertex array object, program or element array buffer are changed
+ * afterwards, the draw call should be baked again.
+ */
+class DrawCall {
+public:
+// Methods
+    static DrawCall bake(const VertexArrayObject& vao,
+                         const Program& program,
+                         const DrawCommand& command);
+    Program program() const;
+    void submit() const;
+    VertexArrayObject vertexArrayObject() const;
+private:
+// Types
+    enum Function {
+        ARRAYS,
+        ARRAYS_INSTANCED,
+        ELEMENTS,
+        ELEMENTS_BASE_VERTEX,
+        ELEMENTS_INSTANCED,
+        ELEMENTS_INSTANCED_BASE_VERTEX,
+        RANGE_ELEMENTS,
+        RANGE_ELEMENTS_BASE_VERTEX
+    };
+// Attributes
+    DrawCommand _command;
+    Function _function;
+    Program _program;
+    bool _restartable;
+    VertexArrayObject _vao;
+// Methods
+    DrawCall(const VertexArrayObject& vao,
+             const Program& program,
+             const DrawCommand& command,
+             Function function);
+    static bool isMode(GLenum mode);
+    static void primitiveRestart(bool enabled);
+    static GLsizei sizeOfIndex(GLenum type);
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/DrawCall.hxx"
+#include "gloop/DrawCommand.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/Shader.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "in vec4 MCVertex;\n"
+        "void main() {\n"
+        "    gl_Position = MCVertex;\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = vec4(1);\n"
+        "}\n";
+
+
+/**
+ * Unit test for `DrawCall`.
+ */
+class DrawCallTest {
+public:
+
+    /**
+     * Makes the test fixture.
+     */
+    DrawCallTest() :
+            program(Program::create()),
+            vao(VertexArrayObject::generate()),
+            vbo(BufferObject::generate()),
+            ebo(BufferObject::generate()) {
+
+        // Make program
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.attribLocation("MCVertex", 0);
+        program.link();
+
+        // Make vertices and indices for two triangles
+        const GLfloat vertices[] = { -1, -1, +1, -1, +1, +1, -1, +1 };
+        const GLushort indices[] = { 0, 1, 2, 0, 2, 3 };
+        vao.bind();
+        const BufferTarget arrayBuffer = BufferTarget::arrayBuffer();
+        arrayBuffer.bind(vbo);
+        arrayBuffer.data(sizeof(vertices), vertices, GL_STATIC_DRAW);
+        vao.enableVertexAttribArray(0);
+        vao.vertexAttribPointer(VertexAttribPointer()
+                .index(0)
+                .size(2)
+                .type(GL_FLOAT)
+                .normalized(GL_FALSE)
+                .stride(0)
+                .offset(0));
+        const BufferTarget elementArrayBuffer = BufferTarget::elementArrayBuffer();
+        elementArrayBuffer.bind(ebo);
+        elementArrayBuffer.data(sizeof(indices), indices, GL_STATIC_DRAW);
+        arrayBuffer.unbind(vbo);
+        vao.unbind();
+    }
+
+    /**
+     * Cleans up the test fixture.
+     */
+    ~DrawCallTest() {
+        vao.dispose();
+        vbo.dispose();
+        ebo.dispose();
+        program.dispose();
+    }
+
+    /**
+     * Counts the primitives generated by submitting a draw call.
+     */
+    static GLuint countPrimitives(const DrawCall& call) {
+        GLuint query;
+        glGenQueries(1, &query);
+        glBeginQuery(GL_PRIMITIVES_GENERATED, query);
+        call.submit();
+        glEndQuery(GL_PRIMITIVES_GENERATED);
+        GLuint count;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &count);
+        glDeleteQueries(1, &query);
+        return count;
+    }
+
+    /**
+     * Ensures each kind of draw call draws the right number of primitives.
+     */
+    void testSubmit() {
+
+        // Arrays
+        CPPUNIT_ASSERT_EQUAL(1U, countPrimitives(DrawCall::bake(vao, program, DrawCommand()
+                .count(3))));
+        CPPUNIT_ASSERT_EQUAL(3U, countPrimitives(DrawCall::bake(vao, program, DrawCommand()
+                .count(3)
+                .instances(3))));
+
+        // Elements
+        CPPUNIT_ASSERT_EQUAL(2U, countPrimitives(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .count(6))));
+        CPPUNIT_ASSERT_EQUAL(1U, countPrimitives(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .count(3)
+                .offset(3 * sizeof(GLushort))
+                .baseVertex(0))));
+        CPPUNIT_ASSERT_EQUAL(4U, countPrimitives(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .count(6)
+                .instances(2)
+                .baseVertex(1))));
+        CPPUNIT_ASSERT_EQUAL(2U, countPrimitives(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .count(6)
+                .range(0, 3))));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+    }
+
+    /**
+     * Ensures a baked draw call does not rebind what is already current.
+     */
+    void testSubmitWhenCurrent() {
+        const DrawCall call = DrawCall::bake(vao, program, DrawCommand().count(3));
+        call.submit();
+        CPPUNIT_ASSERT(vao.bound());
+        CPPUNIT_ASSERT(Program::current() == program);
+        Context::current().verifying(true);
+        call.submit();
+        CPPUNIT_ASSERT(vao.bound());
+        Context::current().verifying(false);
+    }
+
+    /**
+     * Ensures bad commands are rejected when baked.
+     */
+    void testBakeWithBadCommand() {
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand().mode(GL_RGBA)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand().count(-1)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand().baseVertex(1)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand().primitiveRestart(true)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand().type(GL_FLOAT)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .offset(1)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .range(3, 0)), invalid_argument);
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, DrawCommand()
+                .type(GL_UNSIGNED_SHORT)
+                .count(7)), out_of_range);
+
+        // Unlinked program
+        const Program unlinked = Program::create();
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, unlinked, DrawCommand()), logic_error);
+        unlinked.dispose();
+
+        // No element array buffer
+        const VertexArrayObject empty = VertexArrayObject::generate();
+        CPPUNIT_ASSERT_THROW(DrawCall::bake(empty, program, DrawCommand().type(GL_UNSIGNED_INT)), logic_error);
+        empty.dispose();
+    }
+private:
+    Program program;
+    VertexArrayObject vao;
+    BufferObject vbo;
+    BufferObject ebo;
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    try {
+        DrawCallTest test;
+        test.testSubmit();
+        test.testSubmitWhenCurrent();
+        test.testBakeWithBadCommand();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
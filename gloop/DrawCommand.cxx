@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/DrawCommand.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs parameters for drawing nothing as triangles, without indices.
+ */
+DrawCommand::DrawCommand() :
+        _baseVertex(0),
+        _count(0),
+        _end(0),
+        _first(0),
+        _instances(1),
+        _instanced(false),
+        _mode(GL_TRIANGLES),
+        _offset(0),
+        _primitiveRestart(false),
+        _ranged(false),
+        _start(0),
+        _type(GL_NONE) {
+    // empty
+}
+
+/**
+ * Changes the number added to each index before fetching vertices.
+ *
+ * @param baseVertex Number to add to each index, for indexed drawing only
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::baseVertex(const GLint baseVertex) {
+    _baseVertex = baseVertex;
+    return (*this);
+}
+
+/**
+ * Changes the number of vertices or indices to draw.
+ *
+ * @param count Number of vertices, or indices if _type_ is set
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::count(const GLsizei count) {
+    _count = count;
+    return (*this);
+}
+
+/**
+ * Changes the first vertex to draw, when not using indices.
+ *
+ * @param first Index of the first vertex in the enabled vertex arrays
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::first(const GLint first) {
+    _first = first;
+    return (*this);
+}
+
+/**
+ * Changes the number of instances to draw, which makes the command instanced.
+ *
+ * @param instances Number of instances
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::instances(const GLsizei instances) {
+    _instances = instances;
+    _instanced = true;
+    return (*this);
+}
+
+/**
+ * Changes the kind of primitives to draw.
+ *
+ * @param mode Kind of primitive, e.g. `GL_TRIANGLES`
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::mode(const GLenum mode) {
+    _mode = mode;
+    return (*this);
+}
+
+/**
+ * Changes where the indices start in the element array buffer.
+ *
+ * @param offset Number of bytes from the start of the element array buffer
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::offset(const GLsizeiptr offset) {
+    _offset = offset;
+    return (*this);
+}
+
+/**
+ * Changes whether the largest value of the index type starts a new primitive, for indexed drawing only.
+ *
+ * @param primitiveRestart `true` to draw with `GL_PRIMITIVE_RESTART_FIXED_INDEX` enabled
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::primitiveRestart(const bool primitiveRestart) {
+    _primitiveRestart = primitiveRestart;
+    return (*this);
+}
+
+/**
+ * Promises the indices all lie in a range, for indexed drawing only.
+ *
+ * @param start Smallest index
+ * @param end Largest index
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::range(const GLuint start, const GLuint end) {
+    _start = start;
+    _end = end;
+    _ranged = true;
+    return (*this);
+}
+
+/**
+ * Changes the type of the indices, which makes the command indexed.
+ *
+ * @param type `GL_UNSIGNED_BYTE`, `GL_UNSIGNED_SHORT` or `GL_UNSIGNED_INT`
+ * @return Reference to this command
+ */
+DrawCommand& DrawCommand::type(const GLenum type) {
+    _type = type;
+    return (*this);
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_DRAWCOMMAND_HXX
+#define GLOOP_DRAWCOMMAND_HXX
+#include "gloop/common.h"
+namespace Gloop {
+
+
+/**
+ * Parameters for a drawing command.
+ *
+ * Like @ref VertexAttribPointer, a _DrawCommand_ only holds parameters.  Pass
+ * it to @ref DrawCall::bake to check it against a vertex array object and
+ * program, and then submit the resulting draw call as often as needed.
+ *
+ * Which OpenGL function is used depends on which parameters are set.
+ *
+ * | Parameters set                   | Function                                  |
+ * |----------------------------------|-------------------------------------------|
+ * | _first_, _count_                 | `glDrawArrays`                            |
+ * | ... and _instances_              | `glDrawArraysInstanced`                   |
+ * | _type_, _count_, _offset_        | `glDrawElements`                          |
+ * | ... and _instances_              | `glDrawElementsInstanced`                 |
+ * | ... and _baseVertex_             | `glDrawElementsBaseVertex`                |
+ * | ... and _instances_, _baseVertex_| `glDrawElementsInstancedBaseVertex`       |
+ * | ... and _range_                  | `glDrawRangeElements`                     |
+ * | ... and _range_, _baseVertex_    | `glDrawRangeElementsBaseVertex`           |
+ *
+ * Indexed commands can also turn on _primitiveRestart_, so the largest value
+ * of the index type, e.g. `0xFFFF` for `GL_UNSIGNED_SHORT`, starts a new
+ * primitive.  That way many strips can be drawn with one command.
+ *
+ * ~~~
+ *     const DrawCall call = DrawCall::bake(vao, program, DrawCommand()
+ *             .mode(GL_TRIANGLES)
+ *             .type(GL_UNSIGNED_SHORT)
+ *             .count(36)
+ *             .offset(0));
+ * ~~~
+ */
+class DrawCommand {
+public:
+// Methods
+    DrawCommand();
+    DrawCommand& baseVertex(GLint baseVertex);
+    DrawCommand& count(GLsizei count);
+    DrawCommand& first(GLint first);
+    DrawCommand& instances(GLsizei instances);
+    DrawCommand& mode(GLenum mode);
+    DrawCommand& offset(GLsizeiptr offset);
+    DrawCommand& primitiveRestart(bool primitiveRestart);
+    DrawCommand& range(GLuint start, GLuint end);
+    DrawCommand& type(GLenum type);
+private:
+// Attributes
+    GLint _baseVertex;
+    GLsizei _count;
+    GLuint _end;
+    GLint _first;
+    GLsizei _instances;
+    bool _instanced;
+    GLenum _mode;
+    GLsizeiptr _offset;
+    bool _primitiveRestart;
+    bool _ranged;
+    GLuint _start;
+    GLenum _type;
+// Friends
+    friend class DrawCall;
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cstring>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "gloop/BufferTarget.hxx"
+#include "gloop/ElementArray.hxx"
+using namespace std;
+namespace Gloop {
+
+const GLuint ElementArray::RESTART_INDEX;
+
+/**
+ * Narrows indices without primitive restart.
+ *
+ * @param indices Indices to narrow
+ * @param count Number of indices
+ * @throws invalid_argument if count is negative
+ */
+ElementArray::ElementArray(const GLuint* indices, const GLsizei count) :
+        _count(count),
+        _end(0),
+        _primitiveRestart(false),
+        _start(0),
+        _type(GL_UNSIGNED_BYTE) {
+    narrow(indices);
+}
+
+/**
+ * Narrows indices, optionally treating `RESTART_INDEX` as the start of a new primitive.
+ *
+ * @param indices Indices to narrow
+ * @param count Number of indices
+ * @param primitiveRestart `true` if `RESTART_INDEX` separates primitives
+ * @throws invalid_argument if count is negative
+ */
+ElementArray::ElementArray(const GLuint* indices, const GLsizei count, const bool primitiveRestart) :
+        _count(count),
+        _end(0),
+        _primitiveRestart(primitiveRestart),
+        _start(0),
+        _type(GL_UNSIGNED_BYTE) {
+    narrow(indices);
+}
+
+/**
+ * Returns the number of indices, including restart indices.
+ */
+GLsizei ElementArray::count() const {
+    return _count;
+}
+
+/**
+ * Returns the narrowed indices, or `NULL` if there are none.
+ */
+const GLvoid* ElementArray::data() const {
+    return _data.empty() ? NULL : &_data[0];
+}
+
+/**
+ * Makes a command to draw all the indices from the start of the element array buffer.
+ *
+ * The type, count and range are set, as is primitive restart if it was
+ * asked for.  The mode defaults to `GL_TRIANGLES`.
+ *
+ * @return Draw command for the indices
+ */
+DrawCommand ElementArray::drawCommand() const {
+    return DrawCommand()
+            .type(_type)
+            .count(_count)
+            .offset(0)
+            .range(_start, _end)
+            .primitiveRestart(_primitiveRestart);
+}
+
+/**
+ * Returns the largest index, not counting restart indices.
+ */
+GLuint ElementArray::end() const {
+    return _end;
+}
+
+/**
+ * Finds the range and type of the indices and copies them at that width.
+ *
+ * @param indices Indices to narrow
+ * @throws invalid_argument if count is negative
+ */
+void ElementArray::narrow(const GLuint* indices) {
+
+    if (_count < 0) {
+        throw invalid_argument("[ElementArray] Count is negative!");
+    }
+
+    // Choose the smallest type whose largest value is free for restarts if needed
+    range(indices, _count, _primitiveRestart, _start, _end);
+    const GLuint limit = _primitiveRestart ? 1 : 0;
+    if (_end <= 0xFFu - limit) {
+        _type = GL_UNSIGNED_BYTE;
+    } else if (_end <= 0xFFFFu - limit) {
+        _type = GL_UNSIGNED_SHORT;
+    } else {
+        _type = GL_UNSIGNED_INT;
+    }
+
+    // Copy, with truncation turning restart indices into the restart index of the type
+    switch (_type) {
+    case GL_UNSIGNED_BYTE:
+        _data.resize(_count * sizeof(GLubyte));
+        for (GLsizei i = 0; i < _count; ++i) {
+            _data[i] = (GLubyte) indices[i];
+        }
+        break;
+    case GL_UNSIGNED_SHORT:
+        _data.resize(_count * sizeof(GLushort));
+        for (GLsizei i = 0; i < _count; ++i) {
+            ((GLushort*) &_data[0])[i] = (GLushort) indices[i];
+        }
+        break;
+    default:
+        _data.resize(_count * sizeof(GLuint));
+        if (_count > 0) {
+            memcpy(&_data[0], indices, _count * sizeof(GLuint));
+        }
+        break;
+    }
+}
+
+/**
+ * Checks if `RESTART_INDEX` starts a new primitive.
+ */
+bool ElementArray::primitiveRestart() const {
+    return _primitiveRestart;
+}
+
+/**
+ * Finds the smallest and largest of a list of indices.
+ *
+ * @param indices Indices to look through
+ * @param count Number of indices
+ * @param primitiveRestart `true` to skip `RESTART_INDEX`
+ * @param start Location to store the smallest index, or `0` if there are none
+ * @param end Location to store the largest index, or `0` if there are none
+ * @return `true` if there were any indices to look at
+ */
+bool ElementArray::range(const GLuint* indices,
+                         const size_t count,
+                         const bool primitiveRestart,
+                         GLuint& start,
+                         GLuint& end) {
+    GLuint low = 0xFFFFFFFFu;
+    GLuint high = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // Compare eight at a time, zeroing restart indices before finding the largest
+    const __m256i restart = _mm256_set1_epi32((int) RESTART_INDEX);
+    const __m256i skip = primitiveRestart ? restart : _mm256_setzero_si256();
+    __m256i lows = restart;
+    __m256i highs = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*) (indices + i));
+        const __m256i skipped = _mm256_and_si256(_mm256_cmpeq_epi32(v, restart), skip);
+        lows = _mm256_min_epu32(lows, v);
+        highs = _mm256_max_epu32(highs, _mm256_andnot_si256(skipped, v));
+    }
+    GLuint lanes[16];
+    _mm256_storeu_si256((__m256i*) lanes, lows);
+    _mm256_storeu_si256((__m256i*) (lanes + 8), highs);
+    for (int j = 0; j < 8; ++j) {
+        low = (lanes[j] < low) ? lanes[j] : low;
+        high = (lanes[j + 8] > high) ? lanes[j + 8] : high;
+    }
+#elif defined(__SSE2__)
+    // Compare four at a time, flipping the sign bits to compare unsigned values as signed ones
+    const __m128i restart = _mm_set1_epi32((int) RESTART_INDEX);
+    const __m128i skip = primitiveRestart ? restart : _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi32((int) 0x80000000u);
+    __m128i lows = _mm_xor_si128(restart, bias);
+    __m128i highs = bias;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i*) (indices + i));
+        const __m128i skipped = _mm_and_si128(_mm_cmpeq_epi32(v, restart), skip);
+        const __m128i l = _mm_xor_si128(v, bias);
+        const __m128i h = _mm_xor_si128(_mm_andnot_si128(skipped, v), bias);
+        const __m128i lower = _mm_cmplt_epi32(l, lows);
+        const __m128i higher = _mm_cmpgt_epi32(h, highs);
+        lows = _mm_or_si128(_mm_and_si128(lower, l), _mm_andnot_si128(lower, lows));
+        highs = _mm_or_si128(_mm_and_si128(higher, h), _mm_andnot_si128(higher, highs));
+    }
+    GLuint lanes[8];
+    _mm_storeu_si128((__m128i*) lanes, _mm_xor_si128(lows, bias));
+    _mm_storeu_si128((__m128i*) (lanes + 4), _mm_xor_si128(highs, bias));
+    for (int j = 0; j < 4; ++j) {
+        low = (lanes[j] < low) ? lanes[j] : low;
+        high = (lanes[j + 4] > high) ? lanes[j + 4] : high;
+    }
+#endif
+
+    // Compare the rest one at a time
+    for (; i < count; ++i) {
+        const GLuint v = indices[i];
+        if (primitiveRestart && (v == RESTART_INDEX)) {
+            continue;
+        }
+        low = (v < low) ? v : low;
+        high = (v > high) ? v : high;
+    }
+
+    // Only restart indices, or none at all
+    if (low > high) {
+        start = 0;
+        end = 0;
+        return false;
+    }
+    start = low;
+    end = high;
+    return true;
+}
+
+/**
+ * Returns the size of the narrowed indices in bytes.
+ */
+GLsizeiptr ElementArray::size() const {
+    return _data.size();
+}
+
+/**
+ * Returns the smallest index, not counting restart indices.
+ */
+GLuint ElementArray::start() const {
+    return _start;
+}
+
+/**
+ * Returns the type the indices were narrowed to.
+ *
+ * @return `GL_UNSIGNED_BYTE`, `GL_UNSIGNED_SHORT` or `GL_UNSIGNED_INT`
+ */
+GLenum ElementArray::type() const {
+    return _type;
+}
+
+/**
+ * Copies the narrowed indices into the buffer object bound to the element array buffer target.
+ *
+ * @param usage Hint on how the indices will be used, e.g. `GL_STATIC_DRAW`
+ * @see BufferTarget::data
+ */
+void ElementArray::upload(const GLenum usage) const {
+    BufferTarget::elementArrayBuffer().data(size(), data(), usage);
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_ELEMENTARRAY_HXX
+#define GLOOP_ELEMENTARRAY_HXX
+#include "gloop/common.h"
+#include <cstddef>
+#include <vector>
+#include "gloop/DrawCommand.hxx"
+namespace Gloop {
+
+
+/**
+ * Indices narrowed to the smallest type that holds them, ready to upload to an element array buffer.
+ *
+ * Meshes are usually built with 32-bit indices, but most have fewer than
+ * 65,536 vertices, so half of every index fetched is zero.  _ElementArray_
+ * finds the smallest and largest index, then copies the indices into
+ * `GL_UNSIGNED_BYTE` or `GL_UNSIGNED_SHORT` when they fit.  The type chosen
+ * and the range found are kept, so the draw command can use them.
+ *
+ * ~~~
+ *     const ElementArray elements(&indices[0], indices.size());
+ *     vao.bind();
+ *     elements.upload(GL_STATIC_DRAW);
+ *     const DrawCall call = DrawCall::bake(vao, program, elements.drawCommand()
+ *             .mode(GL_TRIANGLES));
+ * ~~~
+ *
+ * The command from @ref drawCommand draws with `glDrawRangeElements`.  Since
+ * a range cannot be used with instances, build instanced commands from @ref
+ * type and @ref count instead.
+ *
+ * To draw many strips at once, separate them with `0xFFFFFFFF` and turn on
+ * primitive restart.  Restart indices are left out of the range and are
+ * narrowed to the largest value of the type chosen, `0xFF` or `0xFFFF`, which
+ * is what `GL_PRIMITIVE_RESTART_FIXED_INDEX` expects.
+ *
+ * ~~~
+ *     const GLuint strips[] = { 0, 1, 2, 3, 0xFFFFFFFF, 4, 5, 6, 7 };
+ *     const ElementArray elements(strips, 9, true);
+ * ~~~
+ *
+ * The smallest and largest index are found several at a time when Gloop is
+ * compiled for a processor with SSE2 or AVX2, as with @ref VertexPacker.
+ */
+class ElementArray {
+public:
+// Constants
+    static const GLuint RESTART_INDEX = 0xFFFFFFFF;
+// Methods
+    ElementArray(const GLuint* indices, GLsizei count);
+    ElementArray(const GLuint* indices, GLsizei count, bool primitiveRestart);
+    GLsizei count() const;
+    const GLvoid* data() const;
+    DrawCommand drawCommand() const;
+    GLuint end() const;
+    bool primitiveRestart() const;
+    static bool range(const GLuint* indices, std::size_t count, bool primitiveRestart, GLuint& start, GLuint& end);
+    GLsizeiptr size() const;
+    GLuint start() const;
+    GLenum type() const;
+    void upload(GLenum usage) const;
+private:
+// Attributes
+    GLsizei _count;
+    std::vector<GLubyte> _data;
+    GLuint _end;
+    bool _primitiveRestart;
+    GLuint _start;
+    GLenum _type;
+// Methods
+    void narrow(const GLuint* indices);
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include "gloop/common.h"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+#include "gloop/DrawCall.hxx"
+#include "gloop/ElementArray.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/Shader.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "in vec4 MCVertex;\n"
+        "void main() {\n"
+        "    gl_Position = MCVertex;\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = vec4(1);\n"
+        "}\n";
+
+
+/**
+ * Unit test for `ElementArray`.
+ */
+class ElementArrayTest {
+public:
+
+    /**
+     * Counts the primitives generated by submitting a draw call.
+     */
+    static GLuint countPrimitives(const DrawCall& call) {
+        GLuint query;
+        glGenQueries(1, &query);
+        glBeginQuery(GL_PRIMITIVES_GENERATED, query);
+        call.submit();
+        glEndQuery(GL_PRIMITIVES_GENERATED);
+        GLuint count;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &count);
+        glDeleteQueries(1, &query);
+        return count;
+    }
+
+    /**
+     * Ensures indices are narrowed to the smallest type that holds them.
+     */
+    void testNarrow() {
+
+        // Bytes
+        const GLuint small[] = { 3, 1, 255, 2, 7 };
+        const ElementArray bytes(small, 5);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_BYTE, bytes.type());
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 5, bytes.size());
+        CPPUNIT_ASSERT_EQUAL((GLuint) 1, bytes.start());
+        CPPUNIT_ASSERT_EQUAL((GLuint) 255, bytes.end());
+        CPPUNIT_ASSERT_EQUAL((GLubyte) 255, ((const GLubyte*) bytes.data())[2]);
+
+        // Shorts
+        const GLuint medium[] = { 300, 256, 65535 };
+        const ElementArray shorts(medium, 3);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_SHORT, shorts.type());
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 6, shorts.size());
+        CPPUNIT_ASSERT_EQUAL((GLushort) 300, ((const GLushort*) shorts.data())[0]);
+        CPPUNIT_ASSERT_EQUAL((GLushort) 65535, ((const GLushort*) shorts.data())[2]);
+
+        // Integers
+        const GLuint large[] = { 0, 65536, 4 };
+        const ElementArray ints(large, 3);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_INT, ints.type());
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 12, ints.size());
+        CPPUNIT_ASSERT_EQUAL((GLuint) 65536, ((const GLuint*) ints.data())[1]);
+
+        // Nothing
+        const ElementArray empty(NULL, 0);
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 0, empty.size());
+        CPPUNIT_ASSERT(empty.data() == NULL);
+        CPPUNIT_ASSERT_THROW(ElementArray(small, -1), invalid_argument);
+    }
+
+    /**
+     * Ensures restart indices are left out of the range and narrowed to the restart index of the type.
+     */
+    void testNarrowWithPrimitiveRestart() {
+
+        // Largest byte is taken by restarts
+        const GLuint strips[] = { 4, 5, ElementArray::RESTART_INDEX, 255, 6 };
+        const ElementArray shorts(strips, 5, true);
+        CPPUNIT_ASSERT(shorts.primitiveRestart());
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_SHORT, shorts.type());
+        CPPUNIT_ASSERT_EQUAL((GLuint) 4, shorts.start());
+        CPPUNIT_ASSERT_EQUAL((GLuint) 255, shorts.end());
+        CPPUNIT_ASSERT_EQUAL((GLushort) 0xFFFF, ((const GLushort*) shorts.data())[2]);
+
+        // Otherwise bytes
+        const GLuint small[] = { 4, 5, ElementArray::RESTART_INDEX, 254, 6 };
+        const ElementArray bytes(small, 5, true);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_BYTE, bytes.type());
+        CPPUNIT_ASSERT_EQUAL((GLubyte) 0xFF, ((const GLubyte*) bytes.data())[2]);
+    }
+
+    /**
+     * Ensures the range is the same however many indices are compared at a time.
+     */
+    void testRange() {
+        srand(11);
+        for (size_t count = 1; count < 70; ++count) {
+            vector<GLuint> indices(count);
+            GLuint low = 0xFFFFFFFFu;
+            GLuint high = 0;
+            bool restarted = false;
+            for (size_t i = 0; i < count; ++i) {
+                indices[i] = (rand() % 5 == 0) ? ElementArray::RESTART_INDEX : ((GLuint) rand() << 2) + 0x40000000u;
+                if (indices[i] != ElementArray::RESTART_INDEX) {
+                    low = min(low, indices[i]);
+                    high = max(high, indices[i]);
+                } else {
+                    restarted = true;
+                }
+            }
+            GLuint start;
+            GLuint end;
+            const bool found = ElementArray::range(&indices[0], count, true, start, end);
+            CPPUNIT_ASSERT_EQUAL(low <= high, found);
+            CPPUNIT_ASSERT_EQUAL(found ? low : 0, start);
+            CPPUNIT_ASSERT_EQUAL(found ? high : 0, end);
+            CPPUNIT_ASSERT(ElementArray::range(&indices[0], count, false, start, end));
+            CPPUNIT_ASSERT_EQUAL(low, start);
+            CPPUNIT_ASSERT_EQUAL(restarted ? ElementArray::RESTART_INDEX : high, end);
+        }
+
+        // Only restarts
+        const vector<GLuint> restarts(9, ElementArray::RESTART_INDEX);
+        GLuint start;
+        GLuint end;
+        CPPUNIT_ASSERT(!ElementArray::range(&restarts[0], restarts.size(), true, start, end));
+        CPPUNIT_ASSERT(ElementArray::range(&restarts[0], restarts.size(), false, start, end));
+        CPPUNIT_ASSERT_EQUAL(ElementArray::RESTART_INDEX, end);
+    }
+
+    /**
+     * Ensures uploaded strips draw with primitive restart, and other draws turn it off again.
+     */
+    void testUpload() {
+
+        // Make program
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.attribLocation("MCVertex", 0);
+        program.link();
+
+        // Make vertices
+        const GLfloat vertices[] = { -1, -1, +1, -1, -1, +1, +1, +1 };
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        const BufferObject vbo = BufferObject::generate();
+        const BufferObject ebo = BufferObject::generate();
+        vao.bind();
+        const BufferTarget arrayBuffer = BufferTarget::arrayBuffer();
+        arrayBuffer.bind(vbo);
+        arrayBuffer.data(sizeof(vertices), vertices, GL_STATIC_DRAW);
+        vao.enableVertexAttribArray(0);
+        vao.vertexAttribPointer(VertexAttribPointer()
+                .index(0)
+                .size(2)
+                .type(GL_FLOAT)
+                .stride(0)
+                .offset(0));
+        arrayBuffer.unbind(vbo);
+
+        // Upload two strips of two triangles each
+        const GLuint strips[] = { 0, 1, 2, 3, ElementArray::RESTART_INDEX, 3, 2, 1, 0 };
+        const ElementArray elements(strips, 9, true);
+        BufferTarget::elementArrayBuffer().bind(ebo);
+        elements.upload(GL_STATIC_DRAW);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_BYTE, elements.type());
+
+        // Draw with primitive restart if it is supported
+        if (Context::current().capabilities().hasPrimitiveRestartFixedIndex()) {
+            const DrawCall strip = DrawCall::bake(vao, program, elements.drawCommand().mode(GL_TRIANGLE_STRIP));
+            CPPUNIT_ASSERT_EQUAL(4U, countPrimitives(strip));
+            CPPUNIT_ASSERT(glIsEnabled(GL_PRIMITIVE_RESTART_FIXED_INDEX));
+            const DrawCall triangles = DrawCall::bake(vao, program, DrawCommand()
+                    .mode(GL_TRIANGLES)
+                    .type(elements.type())
+                    .count(3));
+            CPPUNIT_ASSERT_EQUAL(1U, countPrimitives(triangles));
+            CPPUNIT_ASSERT(!glIsEnabled(GL_PRIMITIVE_RESTART_FIXED_INDEX));
+        } else {
+            CPPUNIT_ASSERT_THROW(DrawCall::bake(vao, program, elements.drawCommand()), logic_error);
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        vao.unbind();
+        vao.dispose();
+        vbo.dispose();
+        ebo.dispose();
+        program.dispose();
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    try {
+        ElementArrayTest test;
+        test.testNarrow();
+        test.testNarrowWithPrimitiveRestart();
+        test.testRange();
+        test.testUpload();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/FramebufferAttachments.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs attachment state for a framebuffer whose status is not known yet.
+ */
+FramebufferAttachments::FramebufferAttachments() : _generation(1), _status(0), _statusGeneration(0) {
+    // empty
+}
+
+/**
+ * Records that an image was attached to, or detached from, the framebuffer.
+ *
+ * @param attachment Attachment point, e.g. `GL_COLOR_ATTACHMENT0`
+ * @param type Type of the image, either `GL_TEXTURE` or `GL_RENDERBUFFER`
+ * @param name ID of the texture or renderbuffer, or `0` to detach
+ */
+void FramebufferAttachments::attach(const GLenum attachment, const GLenum type, const GLuint name) {
+    if (name == 0) {
+        _attachments.erase(attachment);
+    } else {
+        _attachments[attachment] = pair<GLenum,GLuint>(type, name);
+    }
+    touch();
+}
+
+/**
+ * Looks up the status of the framebuffer, if it is known for the current generation.
+ *
+ * @param status Set to the remembered status if it is still valid
+ * @return `true` if the status is known for the current generation
+ */
+bool FramebufferAttachments::findStatus(GLenum& status) const {
+    if (_statusGeneration != _generation) {
+        return false;
+    }
+    status = _status;
+    return true;
+}
+
+/**
+ * Returns the number of changes made to the framebuffer's attachments so far.
+ *
+ * @return Current generation of the framebuffer's attachments
+ */
+unsigned long FramebufferAttachments::generation() const {
+    return _generation;
+}
+
+/**
+ * Remembers the status of the framebuffer for the current generation.
+ *
+ * @param status Status returned by `glCheckFramebufferStatus`
+ */
+void FramebufferAttachments::storeStatus(const GLenum status) {
+    _status = status;
+    _statusGeneration = _generation;
+}
+
+/**
+ * Records that one of the images attached to the framebuffer was changed, for example resized.
+ */
+void FramebufferAttachments::touch() {
+    ++_generation;
+}
+
+/**
+ * Checks if a texture or renderbuffer is attached to the framebuffer.
+ *
+ * @param type Type of the image, either `GL_TEXTURE` or `GL_RENDERBUFFER`
+ * @param name ID of the texture or renderbuffer
+ * @return `true` if the image is attached to any attachment point
+ */
+bool FramebufferAttachments::uses(const GLenum type, const GLuint name) const {
+    map<GLenum,pair<GLenum,GLuint> >::const_iterator it;
+    for (it = _attachments.begin(); it != _attachments.end(); ++it) {
+        if ((it->second.first == type) && (it->second.second == name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} /* namespace Gloop */
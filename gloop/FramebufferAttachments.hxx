@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_FRAMEBUFFERATTACHMENTS_HXX
+#define GLOOP_FRAMEBUFFERATTACHMENTS_HXX
+#include "gloop/common.h"
+#include <map>
+#include <utility>
+namespace Gloop {
+
+
+/**
+ * What Gloop knows about the images attached to one framebuffer object.
+ *
+ * Checking the completeness of a framebuffer with `glCheckFramebufferStatus`
+ * is expensive, but the result can only change when the framebuffer's
+ * attachments change, or when the images attached to it are respecified.
+ * Each of those events increments a _generation_ counter, and @ref
+ * FramebufferTarget::checkStatus reuses the last status it got as long as it
+ * was for the current generation.
+ *
+ * Each @ref Context keeps one _FramebufferAttachments_ for each framebuffer
+ * object it has seen.  See @ref Context::framebufferAttachments.
+ */
+class FramebufferAttachments {
+public:
+// Methods
+    FramebufferAttachments();
+    void attach(GLenum attachment, GLenum type, GLuint name);
+    bool findStatus(GLenum& status) const;
+    unsigned long generation() const;
+    void storeStatus(GLenum status);
+    void touch();
+    bool uses(GLenum type, GLuint name) const;
+private:
+// Attributes
+    std::map<GLenum,std::pair<GLenum,GLuint> > _attachments;
+    unsigned long _generation;
+    GLenum _status;
+    unsigned long _statusGeneration;
+};
+
+} /* namespace Gloop */
+#endif
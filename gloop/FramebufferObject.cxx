@@ -54,6 +54,30 @@ FramebufferObject::FramebufferObject(const FramebufferObject& fbo) : _id(fbo._id
  */
 void FramebufferObject::dispose() const {
     glDeleteFramebuffers(1, &_id);
+    Context::current().forgetFramebuffer(_id);
+}
+
+/**
+ * Records this framebuffer object to be deleted later with others, instead of right away.
+ *
+ * @param queue Queue to record the framebuffer object in
+ * @see DeletionQueue::flush
+ */
+void FramebufferObject::dispose(DeletionQueue& queue) const {
+    queue.enqueue(GL_FRAMEBUFFER, _id);
+}
+
+/**
+ * Gives the name of this framebuffer object back to a pool instead of deleting it.
+ *
+ * The framebuffer object keeps its OpenGL state, so it can be taken from the pool
+ * again with @ref generate(NamePool&) and set up from scratch.
+ *
+ * @param pool Pool of GL_FRAMEBUFFER names to give the name to
+ * @throws std::invalid_argument if the pool is not for framebuffer objects
+ */
+void FramebufferObject::dispose(NamePool& pool) const {
+    pool.release(GL_FRAMEBUFFER, _id);
 }
 
 /**
@@ -93,6 +117,41 @@ FramebufferObject FramebufferObject::generate() {
     return FramebufferObject(id);
 }
 
+/**
+ * Creates handles for several new framebuffer objects at once.
+ *
+ * @param n Number of framebuffer objects to generate
+ * @return Handles for the new framebuffer objects
+ * @throws std::invalid_argument if number is negative
+ * @throws std::runtime_error if the framebuffer objects could not be generated
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGenFramebuffers.xml
+ */
+std::vector<FramebufferObject> FramebufferObject::generate(const GLsizei n) {
+
+    // Generate all the IDs in one call
+    const std::vector<GLuint> ids = NamePool::generate(GL_FRAMEBUFFER, n);
+
+    // Make handles
+    std::vector<FramebufferObject> fbos;
+    fbos.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        fbos.push_back(FramebufferObject(ids[i]));
+    }
+    return fbos;
+}
+
+/**
+ * Creates a handle for a framebuffer object taken from a pool.
+ *
+ * @param pool Pool of GL_FRAMEBUFFER names to take the name from
+ * @return Handle for the framebuffer object, which may have been used before
+ * @throws std::invalid_argument if the pool is not for framebuffer objects
+ * @throws std::runtime_error if the pool could not generate more names
+ */
+FramebufferObject FramebufferObject::generate(NamePool& pool) {
+    return FramebufferObject(pool.take(GL_FRAMEBUFFER));
+}
+
 /**
  * Returns the raw OpenGL identifier of the framebuffer object this handle represents.
  *
@@ -27,6 +27,10 @@
 #define GLOOP_FRAMEBUFFER_OBJECT_HXX
 #include <iostream>
 #include "gloop/common.h"
+#include <vector>
+#include "gloop/Context.hxx"
+#include "gloop/DeletionQueue.hxx"
+#include "gloop/NamePool.hxx"
 namespace Gloop {
 
 
@@ -38,8 +42,12 @@ public:
 // Methods
     FramebufferObject(const FramebufferObject& fbo);
     void dispose() const;
+    void dispose(DeletionQueue& queue) const;
+    void dispose(NamePool& pool) const;
     static FramebufferObject fromId(GLuint id);
     static FramebufferObject generate();
+    static std::vector<FramebufferObject> generate(GLsizei n);
+    static FramebufferObject generate(NamePool& pool);
     GLuint id() const;
     bool operator!=(const FramebufferObject& fbo) const;
     bool operator<(const FramebufferObject& fbo) const;
@@ -24,7 +24,6 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "config.h"
-#include <cassert>
 #include <stdexcept>
 #include "gloop/FramebufferTarget.hxx"
 namespace Gloop {
@@ -57,7 +56,25 @@ FramebufferTarget::FramebufferTarget(const FramebufferTarget& target) :
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindFramebuffer.xml
  */
 void FramebufferTarget::bind(const FramebufferObject& fbo) const {
-    glBindFramebuffer(_id, fbo.id());
+    bind(fbo.id());
+}
+
+/**
+ * Binds a framebuffer to this target, unless it is already bound.
+ *
+ * @param fbo ID of framebuffer to bind, or `0` for the default framebuffer
+ */
+void FramebufferTarget::bind(const GLuint fbo) const {
+
+    // Check if already bound
+    Context& context = Context::current();
+    if (context.integer(_key) == (GLint) fbo) {
+        return;
+    }
+
+    // Bind and remember it
+    glBindFramebuffer(_id, fbo);
+    context.integer(_key, fbo);
 }
 
 /**
@@ -66,9 +83,7 @@ void FramebufferTarget::bind(const FramebufferObject& fbo) const {
  * @return Identifier of the framebuffer currently bound to this target, or `0` if none
  */
 GLuint FramebufferTarget::binding() const {
-    GLint value;
-    glGetIntegerv(_key, &value);
-    return value;
+    return Context::current().integer(_key);
 }
 
 /**
@@ -93,11 +108,36 @@ bool FramebufferTarget::bound(const FramebufferObject& fbo) const {
 /**
  * Checks the completeness of this framebuffer.
  *
+ * The status of a framebuffer object is remembered until one of its
+ * attachments changes, so checking it again before drawing is cheap.
+ *
  * @return Enumeration representing completeness of framebuffer, i.e. `GL_FRAMEBUFFER_COMPLETE`
+ * @throws std::logic_error if verifying and remembered status differs from OpenGL
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glCheckFramebufferStatus.xml
  */
 GLenum FramebufferTarget::checkStatus() const {
-    return glCheckFramebufferStatus(_id);
+
+    // Default framebuffer has no attachments to remember
+    Context& context = Context::current();
+    const GLuint fbo = context.integer(_key);
+    if (fbo == 0) {
+        return glCheckFramebufferStatus(_id);
+    }
+
+    // Use remembered status if attachments have not changed since
+    FramebufferAttachments& attachments = context.framebufferAttachments(fbo);
+    GLenum status;
+    if (attachments.findStatus(status) && !context.verifying()) {
+        return status;
+    }
+
+    // Otherwise ask OpenGL
+    const GLenum actual = glCheckFramebufferStatus(_id);
+    if (attachments.findStatus(status) && (status != actual)) {
+        throw std::logic_error("[FramebufferTarget] Remembered status differs from OpenGL!");
+    }
+    attachments.storeStatus(actual);
+    return actual;
 }
 
 /**
@@ -142,15 +182,23 @@ std::string FramebufferTarget::formatStatus(const GLenum status) {
     }
 }
 
+/**
+ * Returns what Gloop remembers about the attachments of the bound framebuffer.
+ *
+ * @return Reference to the remembered attachments of the bound framebuffer
+ */
+FramebufferAttachments& FramebufferTarget::getAttachments() const {
+    Context& context = Context::current();
+    return context.framebufferAttachments(context.integer(_key));
+}
+
 /**
  * Returns the maximum number of color attachments a framebuffer can have.
  *
  * @return Maximum number of color attachments a framebuffer can have
  */
 GLint FramebufferTarget::getMaxColorAttachments() {
-    GLint value;
-    glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &value);
-    return value;
+    return Context::current().capabilities().maxColorAttachments();
 }
 
 /**
@@ -243,14 +291,19 @@ FramebufferTarget FramebufferTarget::readFramebuffer() {
  *
  * @param attachment Framebuffer attachment to attach to, e.g. `GL_COLOR_ATTACHMENT0`
  * @param rbo Renderbuffer to attach
- * @pre A framebuffer is currently bound to this target
- * @pre Attachment is a valid framebuffer attachment type
+ * @throws std::logic_error if checking and no framebuffer is bound to this target
+ * @throws std::invalid_argument if checking and attachment is not a framebuffer attachment
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glFramebufferRenderbuffer.xml
  */
 void FramebufferTarget::renderbuffer(const GLenum attachment, const RenderbufferObject& rbo) const {
-    assert (bound());
-    assert (isAttachment(attachment));
+    if (GLOOP_CHECKS && !bound()) {
+        throw std::logic_error("[FramebufferTarget] No framebuffer bound to target!");
+    }
+    if (GLOOP_CHECKS && !isAttachment(attachment)) {
+        throw std::invalid_argument("[FramebufferTarget] Invalid framebuffer attachment!");
+    }
     glFramebufferRenderbuffer(_id, attachment, GL_RENDERBUFFER, rbo.id());
+    getAttachments().attach(attachment, GL_RENDERBUFFER, rbo.id());
 }
 
 /**
@@ -260,14 +313,24 @@ void FramebufferTarget::renderbuffer(const GLenum attachment, const Renderbuffer
  * @param target What type of texture is being attached
  * @param texture Texture object to attach
  * @param level Mipmap level of texture object to attach
+ * @throws std::logic_error if checking and no framebuffer is bound to this target
+ * @throws std::invalid_argument if checking and attachment is not a framebuffer attachment, or level is negative
  */
 void FramebufferTarget::texture1d(const GLenum attachment,
                                   const TextureTarget target,
                                   const TextureObject texture,
                                   const GLint level) const {
-    assert (isAttachment(attachment));
-    assert (level >= 0);
+    if (GLOOP_CHECKS && !bound()) {
+        throw std::logic_error("[FramebufferTarget] No framebuffer bound to target!");
+    }
+    if (GLOOP_CHECKS && !isAttachment(attachment)) {
+        throw std::invalid_argument("[FramebufferTarget] Invalid framebuffer attachment!");
+    }
+    if (GLOOP_CHECKS && (level < 0)) {
+        throw std::invalid_argument("[FramebufferTarget] Level is negative!");
+    }
     glFramebufferTexture1D(_id, attachment, target.toEnum(), texture.id(), level);
+    getAttachments().attach(attachment, GL_TEXTURE, texture.id());
 }
 
 /**
@@ -277,14 +340,24 @@ void FramebufferTarget::texture1d(const GLenum attachment,
  * @param target What type of texture is being attached
  * @param texture Texture object to attach
  * @param level Mipmap level of texture object to attach
+ * @throws std::logic_error if checking and no framebuffer is bound to this target
+ * @throws std::invalid_argument if checking and attachment is not a framebuffer attachment, or level is negative
  */
 void FramebufferTarget::texture2d(const GLenum attachment,
                                   const TextureTarget target,
                                   const TextureObject texture,
                                   const GLint level) const {
-    assert (isAttachment(attachment));
-    assert (level >= 0);
+    if (GLOOP_CHECKS && !bound()) {
+        throw std::logic_error("[FramebufferTarget] No framebuffer bound to target!");
+    }
+    if (GLOOP_CHECKS && !isAttachment(attachment)) {
+        throw std::invalid_argument("[FramebufferTarget] Invalid framebuffer attachment!");
+    }
+    if (GLOOP_CHECKS && (level < 0)) {
+        throw std::invalid_argument("[FramebufferTarget] Level is negative!");
+    }
     glFramebufferTexture2D(_id, attachment, target.toEnum(), texture.id(), level);
+    getAttachments().attach(attachment, GL_TEXTURE, texture.id());
 }
 
 /**
@@ -295,16 +368,28 @@ void FramebufferTarget::texture2d(const GLenum attachment,
  * @param texture Texture object to attach
  * @param level Mipmap level of texture object to attach
  * @param layer Layout of texture to attach
+ * @throws std::logic_error if checking and no framebuffer is bound to this target
+ * @throws std::invalid_argument if checking and attachment is not a framebuffer attachment, or level or layer is negative
  */
 void FramebufferTarget::texture3d(const GLenum attachment,
                                   const TextureTarget target,
                                   const TextureObject texture,
                                   const GLint level,
                                   const GLint layer) const{
-    assert (isAttachment(attachment));
-    assert (level >= 0);
-    assert (layer >= 0);
+    if (GLOOP_CHECKS && !bound()) {
+        throw std::logic_error("[FramebufferTarget] No framebuffer bound to target!");
+    }
+    if (GLOOP_CHECKS && !isAttachment(attachment)) {
+        throw std::invalid_argument("[FramebufferTarget] Invalid framebuffer attachment!");
+    }
+    if (GLOOP_CHECKS && (level < 0)) {
+        throw std::invalid_argument("[FramebufferTarget] Level is negative!");
+    }
+    if (GLOOP_CHECKS && (layer < 0)) {
+        throw std::invalid_argument("[FramebufferTarget] Layer is negative!");
+    }
     glFramebufferTexture3D(_id, attachment, target.toEnum(), texture.id(), level, layer);
+    getAttachments().attach(attachment, GL_TEXTURE, texture.id());
 }
 
 /**
@@ -331,7 +416,7 @@ std::string FramebufferTarget::toString() const {
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindFramebuffer.xml
  */
 void FramebufferTarget::unbind() const {
-    glBindFramebuffer(_id, 0);
+    bind(0);
 }
 
 } /* namespace Gloop */
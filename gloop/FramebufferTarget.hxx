@@ -28,6 +28,7 @@
 #include <iostream>
 #include <string>
 #include "gloop/common.h"
+#include "gloop/Context.hxx"
 #include "gloop/FramebufferObject.hxx"
 #include "gloop/RenderbufferObject.hxx"
 #include "gloop/RenderbufferTarget.hxx"
@@ -38,6 +39,10 @@ namespace Gloop {
 
 /**
  * Pointer for manipulating a framebuffer object.
+ *
+ * Bindings of the draw and read framebuffer targets are remembered in the
+ * current @ref Context, so binding a framebuffer that is already bound does not
+ * call OpenGL.
  */
 class FramebufferTarget {
 public:
@@ -71,6 +76,8 @@ private:
     GLenum _key;
 // Methods
     FramebufferTarget(GLenum id, const std::string& str, GLenum key);
+    void bind(GLuint fbo) const;
+    FramebufferAttachments& getAttachments() const;
     static bool isColorAttachment(GLenum enumeration);
 };
 
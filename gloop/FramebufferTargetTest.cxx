@@ -29,12 +29,14 @@
 #include <string>
 #include <cppunit/extensions/HelperMacros.h>
 #include <GL/glfw.h>
+#include "gloop/Context.hxx"
 #include "gloop/FramebufferObject.hxx"
 #include "gloop/FramebufferTarget.hxx"
 #include "gloop/RenderbufferObject.hxx"
 #include "gloop/RenderbufferTarget.hxx"
 #include "gloop/TextureObject.hxx"
 #include "gloop/TextureTarget.hxx"
+using Gloop::Context;
 using Gloop::FramebufferObject;
 using Gloop::FramebufferTarget;
 using Gloop::RenderbufferObject;
@@ -92,7 +94,45 @@ public:
         CPPUNIT_ASSERT_EQUAL(fbo.id(), (GLuint) binding);
 
         // Unbind
+        target.unbind();
+    }
+
+    /**
+     * Ensures `FramebufferTarget::bind` does not rebind a framebuffer that is already bound.
+     */
+    void testBindWhenAlreadyBound() {
+
+        // Bind a new FBO to the target
+        const FramebufferObject fbo = FramebufferObject::generate();
+        const FramebufferTarget target = FramebufferTarget::drawFramebuffer();
+        target.bind(fbo);
+
+        // Change the binding behind Gloop's back and bind again
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        target.bind(fbo);
+
+        // Check OpenGL was not called
+        GLint binding;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &binding);
+        CPPUNIT_ASSERT_EQUAL((GLint) 0, binding);
+
+        // Forget remembered state
+        Context::current().invalidate();
+    }
+
+    /**
+     * Ensures `FramebufferTarget::binding` returns `0` after the bound framebuffer is disposed.
+     */
+    void testBindingAfterDispose() {
+
+        // Bind a new FBO to the target
+        const FramebufferObject fbo = FramebufferObject::generate();
+        const FramebufferTarget target = FramebufferTarget::drawFramebuffer();
+        target.bind(fbo);
+
+        // Dispose of it and check the binding
+        fbo.dispose();
+        CPPUNIT_ASSERT_EQUAL((GLuint) 0, target.binding());
     }
 
     /**
@@ -109,7 +149,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(target.binding(), fbo.id());
 
         // Unbind
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        target.unbind();
     }
 
     /**
@@ -126,7 +166,7 @@ public:
         CPPUNIT_ASSERT(target.bound());
 
         // Unbind
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        target.unbind();
     }
 
     /**
@@ -143,7 +183,70 @@ public:
         CPPUNIT_ASSERT(target.bound(fbo));
 
         // Unbind
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        target.unbind();
+    }
+
+    /**
+     * Ensures `FramebufferTarget::checkStatus` checks again after an attached renderbuffer changes.
+     */
+    void testCheckStatusAfterStorageChanges() {
+
+        // Generate and bind a new FBO
+        const FramebufferObject fbo = FramebufferObject::generate();
+        const FramebufferTarget drawFramebuffer = FramebufferTarget::drawFramebuffer();
+        drawFramebuffer.bind(fbo);
+
+        // Attach a complete RBO
+        const RenderbufferObject rbo = RenderbufferObject::generate();
+        const RenderbufferTarget renderbuffer;
+        renderbuffer.bind(rbo);
+        renderbuffer.storage(GL_RGBA8, 2, 4);
+        drawFramebuffer.renderbuffer(GL_COLOR_ATTACHMENT0, rbo);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_FRAMEBUFFER_COMPLETE, drawFramebuffer.checkStatus());
+
+        // Change it to a format that cannot be a color attachment
+        renderbuffer.storage(GL_DEPTH_COMPONENT24, 2, 4);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT, drawFramebuffer.checkStatus());
+
+        // Clean up
+        renderbuffer.unbind();
+        drawFramebuffer.unbind();
+        rbo.dispose();
+        fbo.dispose();
+    }
+
+    /**
+     * Ensures `FramebufferTarget::checkStatus` throws if verifying and the remembered status is wrong.
+     */
+    void testCheckStatusWhenVerifying() {
+
+        // Generate and bind a new FBO with a complete RBO
+        const FramebufferObject fbo = FramebufferObject::generate();
+        const FramebufferTarget drawFramebuffer = FramebufferTarget::drawFramebuffer();
+        drawFramebuffer.bind(fbo);
+        const RenderbufferObject rbo = RenderbufferObject::generate();
+        const RenderbufferTarget renderbuffer;
+        renderbuffer.bind(rbo);
+        renderbuffer.storage(GL_RGBA8, 2, 4);
+        drawFramebuffer.renderbuffer(GL_COLOR_ATTACHMENT0, rbo);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_FRAMEBUFFER_COMPLETE, drawFramebuffer.checkStatus());
+
+        // Detach it behind Gloop's back
+        glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, 0);
+
+        // Check remembered status is used normally, but caught when verifying
+        Context& context = Context::current();
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_FRAMEBUFFER_COMPLETE, drawFramebuffer.checkStatus());
+        context.verifying(true);
+        CPPUNIT_ASSERT_THROW(drawFramebuffer.checkStatus(), std::logic_error);
+        context.verifying(false);
+
+        // Clean up
+        context.invalidate();
+        renderbuffer.unbind();
+        drawFramebuffer.unbind();
+        rbo.dispose();
+        fbo.dispose();
     }
 
     /**
@@ -423,9 +526,13 @@ int main(int argc, char* argv[]) {
         FramebufferTargetTest test;
         test.testAssignmentOperator();
         test.testBind();
+        test.testBindWhenAlreadyBound();
+        test.testBindingAfterDispose();
         test.testBinding();
         test.testBound();
         test.testBoundFramebufferObject();
+        test.testCheckStatusAfterStorageChanges();
+        test.testCheckStatusWhenVerifying();
         test.testDrawFramebuffer();
         test.testEqualityOperatorWithEqualInstances();
         test.testEqualityOperatorWithUnequalInstances();
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/IndirectDrawBuilder.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Creates an empty builder.
+ *
+ * @param mode Kind of primitive to draw, e.g. `GL_TRIANGLES`
+ * @param type Type of the indices, e.g. `GL_UNSIGNED_INT`
+ * @throws std::invalid_argument if type is not `GL_UNSIGNED_BYTE`, `GL_UNSIGNED_SHORT` or `GL_UNSIGNED_INT`
+ */
+IndirectDrawBuilder::IndirectDrawBuilder(const GLenum mode, const GLenum type) :
+        _buffer(BufferObject::generate()),
+        _dirty(false),
+        _mode(mode),
+        _type(type) {
+    if (sizeOfIndex() == 0) {
+        _buffer.dispose();
+        throw invalid_argument("[IndirectDrawBuilder] Type is not GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT!");
+    }
+}
+
+/**
+ * Adds a draw to the group for a vertex array object and program.
+ *
+ * @param vao Vertex array object to draw from
+ * @param program Program to draw with
+ * @param command Parameters of the draw
+ * @return Index of the group the draw was added to
+ */
+size_t IndirectDrawBuilder::add(const VertexArrayObject& vao,
+                                const Program& program,
+                                const Command& command) {
+
+    // Find or make the group
+    const pair<GLuint,GLuint> key(program.id(), vao.id());
+    GroupIndex::const_iterator it = _index.find(key);
+    size_t group;
+    if (it == _index.end()) {
+        group = _groups.size();
+        _groups.push_back(Group(program, vao));
+        _index[key] = group;
+    } else {
+        group = it->second;
+    }
+
+    // Add the command
+    _groups[group].commands.push_back(command);
+    _dirty = true;
+    return group;
+}
+
+/**
+ * Adds a draw of one instance to the group for a vertex array object and program.
+ *
+ * @param vao Vertex array object to draw from
+ * @param program Program to draw with
+ * @param count Number of indices to draw
+ * @param firstIndex Index of the first index in the element array buffer
+ * @param baseVertex Number added to each index before fetching vertices
+ * @return Index of the group the draw was added to
+ */
+size_t IndirectDrawBuilder::add(const VertexArrayObject& vao,
+                                const Program& program,
+                                const GLuint count,
+                                const GLuint firstIndex,
+                                const GLint baseVertex) {
+    Command command;
+    command.count = count;
+    command.instanceCount = 1;
+    command.firstIndex = firstIndex;
+    command.baseVertex = baseVertex;
+    command.baseInstance = 0;
+    return add(vao, program, command);
+}
+
+/**
+ * Returns the buffer object the commands are written to.
+ */
+BufferObject IndirectDrawBuilder::buffer() const {
+    return _buffer;
+}
+
+/**
+ * Removes all the draws, so the builder can be filled again.
+ */
+void IndirectDrawBuilder::clear() {
+    _groups.clear();
+    _index.clear();
+    _dirty = true;
+}
+
+/**
+ * Returns the number of draws in all groups.
+ */
+size_t IndirectDrawBuilder::commands() const {
+    size_t total = 0;
+    for (size_t i = 0; i < _groups.size(); ++i) {
+        total += _groups[i].commands.size();
+    }
+    return total;
+}
+
+/**
+ * Returns the number of draws in a group.
+ *
+ * @param group Index of the group
+ * @throws std::out_of_range if there is no such group
+ */
+size_t IndirectDrawBuilder::commands(const size_t group) const {
+    if (group >= _groups.size()) {
+        throw out_of_range("[IndirectDrawBuilder] No such group!");
+    }
+    return _groups[group].commands.size();
+}
+
+/**
+ * Deletes the buffer object the commands are written to.
+ */
+void IndirectDrawBuilder::dispose() {
+    _buffer.dispose();
+}
+
+/**
+ * Draws the commands of a group one at a time, when indirect drawing is not supported.
+ *
+ * @param group Group to draw
+ */
+void IndirectDrawBuilder::drawEach(const Group& group) const {
+    const GLsizei size = sizeOfIndex();
+    for (size_t i = 0; i < group.commands.size(); ++i) {
+        const Command& c = group.commands[i];
+        glDrawElementsInstancedBaseVertex(
+                _mode,
+                c.count,
+                _type,
+                (GLvoid*) (((GLintptr) c.firstIndex) * size),
+                c.instanceCount,
+                c.baseVertex);
+    }
+}
+
+/**
+ * Returns the number of groups, one for each vertex array object and program drawn with.
+ */
+size_t IndirectDrawBuilder::groups() const {
+    return _groups.size();
+}
+
+/**
+ * Returns where the commands of a group start in the buffer object.
+ *
+ * @param group Index of the group
+ * @return Offset in bytes, valid after @ref upload or @ref submit
+ * @throws std::out_of_range if there is no such group
+ */
+GLintptr IndirectDrawBuilder::offset(const size_t group) const {
+    if (group >= _groups.size()) {
+        throw out_of_range("[IndirectDrawBuilder] No such group!");
+    }
+    return _groups[group].offset;
+}
+
+/**
+ * Determines the size of the index type.
+ *
+ * @return Size of an index in bytes, or `0` if not an index type
+ */
+GLsizei IndirectDrawBuilder::sizeOfIndex() const {
+    switch (_type) {
+    case GL_UNSIGNED_BYTE:
+        return sizeof(GLubyte);
+    case GL_UNSIGNED_SHORT:
+        return sizeof(GLushort);
+    case GL_UNSIGNED_INT:
+        return sizeof(GLuint);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Draws every group, writing the commands to the buffer object first if they changed.
+ *
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glMultiDrawElementsIndirect.xml
+ */
+void IndirectDrawBuilder::submit() {
+
+    // Fall back to drawing one at a time
+    if (!Context::current().capabilities().hasMultiDrawIndirect()) {
+        for (GroupIndex::const_iterator it = _index.begin(); it != _index.end(); ++it) {
+            const Group& group = _groups[it->second];
+            group.program.use();
+            group.vao.bind();
+            drawEach(group);
+        }
+        return;
+    }
+
+    // Draw each group with one call
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    upload();
+    const BufferTarget target = BufferTarget::drawIndirectBuffer();
+    if (!target.bound(_buffer)) {
+        target.bind(_buffer);
+    }
+    for (GroupIndex::const_iterator it = _index.begin(); it != _index.end(); ++it) {
+        const Group& group = _groups[it->second];
+        group.program.use();
+        group.vao.bind();
+        glMultiDrawElementsIndirect(_mode, _type, (const GLvoid*) group.offset, group.commands.size(), 0);
+    }
+#endif
+}
+
+/**
+ * Draws every group, reading how many of its commands to draw from a buffer object.
+ *
+ * The count for the group with index _i_ is the `GLuint` at _offset_ plus
+ * _i_ times four bytes, and is clamped to the number of commands in the group.
+ *
+ * @param counts Buffer object holding the number of commands to draw from each group
+ * @param offset Offset of the count for the first group, which must be a multiple of four
+ * @throws std::runtime_error if `GL_ARB_indirect_parameters` is not supported
+ * @see http://www.opengl.org/registry/specs/ARB/indirect_parameters.txt
+ */
+void IndirectDrawBuilder::submit(const BufferObject& counts, const GLintptr offset) {
+
+    if (!Context::current().capabilities().hasIndirectParameters()) {
+        throw runtime_error("[IndirectDrawBuilder] Draw counts from buffers are not supported!");
+    }
+
+#ifdef GL_PARAMETER_BUFFER_ARB
+    upload();
+    const BufferTarget target = BufferTarget::drawIndirectBuffer();
+    if (!target.bound(_buffer)) {
+        target.bind(_buffer);
+    }
+    const BufferTarget parameters = BufferTarget::parameterBuffer();
+    if (!parameters.bound(counts)) {
+        parameters.bind(counts);
+    }
+    for (GroupIndex::const_iterator it = _index.begin(); it != _index.end(); ++it) {
+        const Group& group = _groups[it->second];
+        group.program.use();
+        group.vao.bind();
+        glMultiDrawElementsIndirectCountARB(
+                _mode,
+                _type,
+                (const GLvoid*) group.offset,
+                offset + it->second * sizeof(GLuint),
+                group.commands.size(),
+                0);
+    }
+#endif
+}
+
+/**
+ * Writes the commands of every group into the buffer object, if they changed.
+ *
+ * Groups are written one after another in the order they were made, and the
+ * buffer object is reallocated each time, so OpenGL can keep reading the old
+ * commands while the new ones are written.
+ */
+void IndirectDrawBuilder::upload() {
+
+    if (!_dirty) {
+        return;
+    }
+
+    // Pack all the commands
+    vector<Command> packed;
+    packed.reserve(commands());
+    for (size_t i = 0; i < _groups.size(); ++i) {
+        _groups[i].offset = packed.size() * sizeof(Command);
+        packed.insert(packed.end(), _groups[i].commands.begin(), _groups[i].commands.end());
+    }
+
+    // Write them
+    if (!packed.empty()) {
+        const BufferTarget target = BufferTarget::drawIndirectBuffer();
+        target.bind(_buffer);
+        target.data(packed.size() * sizeof(Command), &packed[0], GL_STREAM_DRAW);
+    }
+    _dirty = false;
+}
+
+// TYPES
+
+/**
+ * Constructs an empty group.
+ *
+ * @param program Program to draw with
+ * @param vao Vertex array object to draw from
+ */
+IndirectDrawBuilder::Group::Group(const Program& program, const VertexArrayObject& vao) :
+        program(program),
+        vao(vao),
+        offset(0) {
+    // empty
+}
+
+} /* namespace Gloop */
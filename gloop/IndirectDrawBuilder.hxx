@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_INDIRECTDRAWBUILDER_HXX
+#define GLOOP_INDIRECTDRAWBUILDER_HXX
+#include "gloop/common.h"
+#include <map>
+#include <utility>
+#include <vector>
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/VertexArrayObject.hxx"
+namespace Gloop {
+
+
+/**
+ * Collects indexed draws and submits them with a few indirect draw calls.
+ *
+ * Submitting thousands of small draws one at a time costs far more on the CPU
+ * than drawing them does on the GPU.  An _IndirectDrawBuilder_ instead packs
+ * each draw into a @ref Command, the same layout as OpenGL's
+ * `DrawElementsIndirectCommand`, and groups them by vertex array object and
+ * program.  @ref submit then writes all the commands into a buffer object on
+ * `GL_DRAW_INDIRECT_BUFFER`, and draws each group with one call to
+ * `glMultiDrawElementsIndirect`.
+ *
+ * ~~~
+ *     IndirectDrawBuilder builder(GL_TRIANGLES, GL_UNSIGNED_INT);
+ *     for (...) {
+ *         builder.add(mesh.vao, material.program, mesh.count, mesh.firstIndex, mesh.baseVertex);
+ *     }
+ *     builder.submit();
+ *     builder.clear();
+ * ~~~
+ *
+ * All the draws in a builder use the same mode and index type, and groups are
+ * drawn sorted by program and then by vertex array object, so each program is
+ * made current only once.  Meshes suballocated from the same buffer objects
+ * with a @ref BufferHeap can share a vertex array object, and therefore a
+ * group.
+ *
+ * The number of draws in each group can also come from a buffer object, such
+ * as one written by a culling shader, with @ref submit(const BufferObject&, GLintptr).
+ * The commands themselves can be rewritten on the GPU too, since @ref buffer
+ * and @ref offset tell where each group's commands are.
+ *
+ * When `glMultiDrawElementsIndirect` is not supported, each command is drawn
+ * with `glDrawElementsInstancedBaseVertex` instead, ignoring _baseInstance_.
+ *
+ * Builders cannot be copied, since each one owns its buffer object.  Call
+ * @ref dispose when finished with one.
+ */
+class IndirectDrawBuilder {
+public:
+// Types
+    struct Command {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+// Methods
+    IndirectDrawBuilder(GLenum mode, GLenum type);
+    size_t add(const VertexArrayObject& vao, const Program& program, const Command& command);
+    size_t add(const VertexArrayObject& vao,
+               const Program& program,
+               GLuint count,
+               GLuint firstIndex,
+               GLint baseVertex);
+    BufferObject buffer() const;
+    void clear();
+    size_t commands() const;
+    size_t commands(size_t group) const;
+    void dispose();
+    size_t groups() const;
+    GLintptr offset(size_t group) const;
+    void submit();
+    void submit(const BufferObject& counts, GLintptr offset);
+    void upload();
+private:
+// Types
+    struct Group {
+        Program program;
+        VertexArrayObject vao;
+        std::vector<Command> commands;
+        GLintptr offset;
+        Group(const Program& program, const VertexArrayObject& vao);
+    };
+    typedef std::map<std::pair<GLuint,GLuint>,size_t> GroupIndex;
+// Attributes
+    BufferObject _buffer;
+    bool _dirty;
+    std::vector<Group> _groups;
+    GroupIndex _index;
+    GLenum _mode;
+    GLenum _type;
+// Methods
+    IndirectDrawBuilder(const IndirectDrawBuilder& builder);
+    IndirectDrawBuilder& operator=(const IndirectDrawBuilder& builder);
+    void drawEach(const Group& group) const;
+    GLsizei sizeOfIndex() const;
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/IndirectDrawBuilder.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/Shader.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "in vec4 MCVertex;\n"
+        "void main() {\n"
+        "    gl_Position = MCVertex;\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = vec4(1);\n"
+        "}\n";
+
+
+/**
+ * Unit test for `IndirectDrawBuilder`.
+ */
+class IndirectDrawBuilderTest {
+public:
+
+    /**
+     * Makes the test fixture.
+     */
+    IndirectDrawBuilderTest() :
+            p1(createProgram()),
+            p2(createProgram()),
+            vao(VertexArrayObject::generate()),
+            vbo(BufferObject::generate()),
+            ebo(BufferObject::generate()) {
+
+        // Make vertices and indices for two triangles
+        const GLfloat vertices[] = { -1, -1, +1, -1, +1, +1, -1, +1 };
+        const GLuint indices[] = { 0, 1, 2, 0, 2, 3 };
+        vao.bind();
+        const BufferTarget arrayBuffer = BufferTarget::arrayBuffer();
+        arrayBuffer.bind(vbo);
+        arrayBuffer.data(sizeof(vertices), vertices, GL_STATIC_DRAW);
+        vao.enableVertexAttribArray(0);
+        vao.vertexAttribPointer(VertexAttribPointer()
+                .index(0)
+                .size(2)
+                .type(GL_FLOAT)
+                .normalized(GL_FALSE)
+                .stride(0)
+                .offset(0));
+        const BufferTarget elementArrayBuffer = BufferTarget::elementArrayBuffer();
+        elementArrayBuffer.bind(ebo);
+        elementArrayBuffer.data(sizeof(indices), indices, GL_STATIC_DRAW);
+        arrayBuffer.unbind(vbo);
+        vao.unbind();
+    }
+
+    /**
+     * Cleans up the test fixture.
+     */
+    ~IndirectDrawBuilderTest() {
+        vao.dispose();
+        vbo.dispose();
+        ebo.dispose();
+        p1.dispose();
+        p2.dispose();
+    }
+
+    /**
+     * Makes a program that passes vertices through.
+     */
+    static Program createProgram() {
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.attribLocation("MCVertex", 0);
+        program.link();
+        return program;
+    }
+
+    /**
+     * Begins counting primitives.
+     */
+    static GLuint beginCount() {
+        GLuint query;
+        glGenQueries(1, &query);
+        glBeginQuery(GL_PRIMITIVES_GENERATED, query);
+        return query;
+    }
+
+    /**
+     * Finishes counting primitives.
+     */
+    static GLuint endCount(GLuint query) {
+        glEndQuery(GL_PRIMITIVES_GENERATED);
+        GLuint count;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &count);
+        glDeleteQueries(1, &query);
+        return count;
+    }
+
+    /**
+     * Fills a builder with three draws in two groups.
+     */
+    void fill(IndirectDrawBuilder& builder) {
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, builder.add(vao, p1, 3, 0, 0));
+        IndirectDrawBuilder::Command command;
+        command.count = 6;
+        command.instanceCount = 2;
+        command.firstIndex = 0;
+        command.baseVertex = 0;
+        command.baseInstance = 0;
+        CPPUNIT_ASSERT_EQUAL((size_t) 1, builder.add(vao, p2, command));
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, builder.add(vao, p1, 3, 3, 0));
+    }
+
+    /**
+     * Ensures draws are grouped, packed and drawn.
+     */
+    void testSubmit() {
+
+        IndirectDrawBuilder builder(GL_TRIANGLES, GL_UNSIGNED_INT);
+        fill(builder);
+        CPPUNIT_ASSERT_EQUAL((size_t) 2, builder.groups());
+        CPPUNIT_ASSERT_EQUAL((size_t) 3, builder.commands());
+        CPPUNIT_ASSERT_EQUAL((size_t) 2, builder.commands(0));
+
+        // Draw
+        const GLuint query = beginCount();
+        builder.submit();
+        CPPUNIT_ASSERT_EQUAL(6U, endCount(query));
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 0, builder.offset(0));
+        CPPUNIT_ASSERT_EQUAL((GLintptr) (2 * sizeof(IndirectDrawBuilder::Command)), builder.offset(1));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clear
+        builder.clear();
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, builder.groups());
+        builder.dispose();
+    }
+
+    /**
+     * Ensures draw counts can come from a buffer object.
+     */
+    void testSubmitWithCounts() {
+
+        if (!Context::current().capabilities().hasIndirectParameters()) {
+            return;
+        }
+
+        IndirectDrawBuilder builder(GL_TRIANGLES, GL_UNSIGNED_INT);
+        fill(builder);
+
+        // Only draw the first command of the first group
+        const GLuint values[] = { 1, 0 };
+        const BufferObject counts = BufferObject::generate();
+        const BufferTarget target = BufferTarget::arrayBuffer();
+        target.bind(counts);
+        target.data(sizeof(values), values, GL_STATIC_DRAW);
+        target.unbind(counts);
+
+        // Draw
+        const GLuint query = beginCount();
+        builder.submit(counts, 0);
+        CPPUNIT_ASSERT_EQUAL(1U, endCount(query));
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+        counts.dispose();
+        builder.dispose();
+    }
+
+    /**
+     * Ensures bad index types are rejected.
+     */
+    void testConstructWithBadType() {
+        CPPUNIT_ASSERT_THROW(IndirectDrawBuilder(GL_TRIANGLES, GL_FLOAT), invalid_argument);
+    }
+private:
+    Program p1;
+    Program p2;
+    VertexArrayObject vao;
+    BufferObject vbo;
+    BufferObject ebo;
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    try {
+        IndirectDrawBuilderTest test;
+        test.testSubmit();
+        test.testSubmitWithCounts();
+        test.testConstructWithBadType();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
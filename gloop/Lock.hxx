@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_LOCK_HXX
+#define GLOOP_LOCK_HXX
+#include "gloop/common.h"
+#include <pthread.h>
+namespace Gloop {
+
+
+/**
+ * Lock on a POSIX mutex that is released when it goes out of scope.
+ *
+ * ~~~
+ *     {
+ *         Lock lock(mutex);
+ *         ...
+ *     }
+ * ~~~
+ *
+ * The mutex is unlocked even if an exception is thrown while it is held.
+ * Locks cannot be copied.
+ */
+class Lock {
+public:
+// Methods
+    explicit Lock(pthread_mutex_t& mutex);
+    ~Lock();
+private:
+// Attributes
+    pthread_mutex_t& _mutex;
+// Methods
+    Lock(const Lock& lock);
+    Lock& operator=(const Lock& lock);
+};
+
+} /* namespace Gloop */
+#endif
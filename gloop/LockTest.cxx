@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include <pthread.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include "gloop/Lock.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Unit test for `Lock`.
+ */
+class LockTest : public CppUnit::TestFixture {
+public:
+
+    /**
+     * Ensures a lock holds its mutex until it goes out of scope.
+     */
+    void testLock() {
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        {
+            Lock lock(mutex);
+            CPPUNIT_ASSERT(pthread_mutex_trylock(&mutex) != 0);
+        }
+        CPPUNIT_ASSERT_EQUAL(0, pthread_mutex_trylock(&mutex));
+        pthread_mutex_unlock(&mutex);
+    }
+
+    /**
+     * Ensures a lock releases its mutex when an exception is thrown.
+     */
+    void testLockWithException() {
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        try {
+            Lock lock(mutex);
+            throw runtime_error("Thrown while locked");
+        } catch (runtime_error& e) {
+            // Exception caught
+        }
+        CPPUNIT_ASSERT_EQUAL(0, pthread_mutex_trylock(&mutex));
+        pthread_mutex_unlock(&mutex);
+    }
+
+    CPPUNIT_TEST_SUITE(LockTest);
+    CPPUNIT_TEST(testLock);
+    CPPUNIT_TEST(testLockWithException);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+} /* namespace Gloop */
+
+int main(int argc, char* argv[]) {
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(Gloop::LockTest::suite());
+    runner.run();
+    return 0;
+}
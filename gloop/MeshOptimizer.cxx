@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "gloop/MeshOptimizer.hxx"
+using namespace std;
+namespace Gloop {
+
+const size_t MeshOptimizer::CACHE_SIZE;
+
+/**
+ * Computes the average cache miss ratio of a list of triangles with a cache of `CACHE_SIZE` vertices.
+ *
+ * @param indices Three indices per triangle
+ * @return Number of vertices transformed per triangle, or `0` if there are no triangles
+ */
+double MeshOptimizer::acmr(const vector<GLuint>& indices) {
+    return acmr(indices, CACHE_SIZE);
+}
+
+/**
+ * Computes the average cache miss ratio of a list of triangles.
+ *
+ * The post-transform cache is simulated as a first-in, first-out queue of the
+ * last _cacheSize_ vertices transformed, like most hardware uses.
+ *
+ * @param indices Three indices per triangle
+ * @param cacheSize Number of vertices the cache holds
+ * @return Number of vertices transformed per triangle, or `0` if there are no triangles
+ */
+double MeshOptimizer::acmr(const vector<GLuint>& indices, const size_t cacheSize) {
+
+    const size_t triangles = indices.size() / 3;
+    if (triangles == 0) {
+        return 0;
+    }
+
+    // A vertex is cached if fewer than cacheSize others were transformed since it was
+    vector<size_t> stamps(*max_element(indices.begin(), indices.end()) + 1, 0);
+    size_t time = cacheSize + 1;
+    size_t misses = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const GLuint v = indices[i];
+        if (time - stamps[v] > cacheSize) {
+            stamps[v] = time;
+            ++time;
+            ++misses;
+        }
+    }
+    return ((double) misses) / triangles;
+}
+
+/**
+ * Checks that a list of triangles is well formed.
+ *
+ * @param indices Three indices per triangle
+ * @param vertexCount Number of vertices the indices refer to
+ * @throws invalid_argument if checking and the number of indices is not a multiple of three, or an index is too large
+ */
+void MeshOptimizer::checkIndices(const vector<GLuint>& indices, const size_t vertexCount) {
+
+    if (!GLOOP_CHECKS) {
+        return;
+    }
+
+    // Check whole triangles
+    if ((indices.size() % 3) != 0) {
+        throw invalid_argument("[MeshOptimizer] Number of indices is not a multiple of three!");
+    }
+
+    // Check range
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (indices[i] >= vertexCount) {
+            throw invalid_argument("[MeshOptimizer] Index is greater than or equal to vertex count!");
+        }
+    }
+}
+
+/**
+ * Reorders the triangles and vertices of a mesh for the vertex cache, overdraw and vertex fetch.
+ *
+ * Runs @ref optimizeOverdraw, which also reorders for the vertex cache, and
+ * then @ref optimizeVertexFetch.  Vertices no triangle uses are dropped.
+ *
+ * @param indices Three indices per triangle, reordered in place
+ * @param vertices Interleaved vertices, reordered in place
+ * @param vertexCount Number of vertices
+ * @param vertexSize Size of each vertex in bytes
+ * @param positionOffset Offset of the position of each vertex in bytes, three floats
+ * @return Average cache miss ratio before and after, number of clusters, and number of vertices used
+ * @throws invalid_argument if checking and the indices are not well formed
+ */
+MeshOptimizer::Report MeshOptimizer::optimize(vector<GLuint>& indices,
+                                              void* vertices,
+                                              const size_t vertexCount,
+                                              const size_t vertexSize,
+                                              const size_t positionOffset) {
+    Report report;
+    report.acmrBefore = acmr(indices);
+    report.clusters = optimizeOverdraw(
+            indices,
+            (const GLfloat*) (((const char*) vertices) + positionOffset),
+            vertexSize,
+            vertexCount,
+            1.05);
+    report.vertices = optimizeVertexFetch(indices, vertices, vertexCount, vertexSize);
+    report.acmrAfter = acmr(indices);
+    return report;
+}
+
+/**
+ * Reorders triangles for the vertex cache, then so that parts of the mesh facing outwards are drawn first.
+ *
+ * After reordering the triangles with @ref optimizeVertexCache, the list is
+ * split into clusters at points where the cache starts over anyway.  A split
+ * is only made once the cluster has a cache miss ratio within _threshold_
+ * times that of the whole mesh, so splitting does not cost much.  The
+ * clusters are then sorted by how far they face away from the middle of the
+ * mesh, since from any viewpoint those are the most likely to hide others.
+ *
+ * @param indices Three indices per triangle, reordered in place
+ * @param positions Position of the first vertex, three floats
+ * @param stride Bytes between the positions of consecutive vertices
+ * @param vertexCount Number of vertices
+ * @param threshold Largest ratio of a cluster's cache miss ratio to the whole mesh's for it to end, e.g. `1.05`
+ * @return Number of clusters
+ * @throws invalid_argument if checking and the indices are not well formed
+ * @see Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007
+ */
+size_t MeshOptimizer::optimizeOverdraw(vector<GLuint>& indices,
+                                       const GLfloat* positions,
+                                       const size_t stride,
+                                       const size_t vertexCount,
+                                       const double threshold) {
+
+    checkIndices(indices, vertexCount);
+    const size_t triangles = indices.size() / 3;
+    if (triangles == 0) {
+        return 0;
+    }
+
+    // Reorder for the cache, remembering where it starts over
+    const vector<size_t> boundaries = tipsify(indices, vertexCount, CACHE_SIZE);
+    const double limit = acmr(indices) * threshold;
+
+    // Split into clusters at the boundaries that are cheap to split at
+    vector<Cluster> clusters;
+    vector<size_t> stamps(vertexCount, 0);
+    size_t time = CACHE_SIZE + 1;
+    size_t misses = 0;
+    size_t first = 0;
+    vector<size_t>::const_iterator boundary = boundaries.begin();
+    for (size_t t = 0; t < triangles; ++t) {
+        while ((boundary != boundaries.end()) && (*boundary < t)) {
+            ++boundary;
+        }
+        if ((boundary != boundaries.end()) && (*boundary == t) && (t > first)
+                && (((double) misses) / (t - first) <= limit)) {
+            Cluster cluster = { first, t - first, 0 };
+            clusters.push_back(cluster);
+            first = t;
+            misses = 0;
+            time += CACHE_SIZE + 1;
+        }
+        for (int j = 0; j < 3; ++j) {
+            const GLuint v = indices[t * 3 + j];
+            if (time - stamps[v] > CACHE_SIZE) {
+                stamps[v] = time;
+                ++time;
+                ++misses;
+            }
+        }
+    }
+    Cluster last = { first, triangles - first, 0 };
+    clusters.push_back(last);
+
+    // Find the area-weighted centroid and normal of each cluster, and of the mesh
+    vector<double> centroids(clusters.size() * 3, 0);
+    vector<double> normals(clusters.size() * 3, 0);
+    vector<double> areas(clusters.size(), 0);
+    double middle[3] = { 0, 0, 0 };
+    double area = 0;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        for (size_t t = clusters[c].first; t < clusters[c].first + clusters[c].count; ++t) {
+            const GLfloat* p[3];
+            for (int j = 0; j < 3; ++j) {
+                p[j] = (const GLfloat*) (((const char*) positions) + indices[t * 3 + j] * stride);
+            }
+            const double e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+            const double e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+            const double n[3] = {
+                e1[1] * e2[2] - e1[2] * e2[1],
+                e1[2] * e2[0] - e1[0] * e2[2],
+                e1[0] * e2[1] - e1[1] * e2[0]
+            };
+            const double a = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; ++k) {
+                const double centre = (p[0][k] + p[1][k] + p[2][k]) / 3;
+                centroids[c * 3 + k] += centre * a;
+                normals[c * 3 + k] += n[k];
+                middle[k] += centre * a;
+            }
+            areas[c] += a;
+            area += a;
+        }
+    }
+
+    // Key each cluster by how far it faces away from the middle
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        const double* n = &normals[c * 3];
+        const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if ((length == 0) || (areas[c] == 0) || (area == 0)) {
+            continue;
+        }
+        double key = 0;
+        for (int k = 0; k < 3; ++k) {
+            key += (centroids[c * 3 + k] / areas[c] - middle[k] / area) * n[k] / length;
+        }
+        clusters[c].key = key;
+    }
+
+    // Rebuild the list from the sorted clusters
+    stable_sort(clusters.begin(), clusters.end());
+    vector<GLuint> sorted;
+    sorted.reserve(indices.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        sorted.insert(sorted.end(),
+                      indices.begin() + clusters[c].first * 3,
+                      indices.begin() + (clusters[c].first + clusters[c].count) * 3);
+    }
+    indices.swap(sorted);
+    return clusters.size();
+}
+
+/**
+ * Reorders triangles so each vertex is reused while it is in a post-transform cache of `CACHE_SIZE` vertices.
+ *
+ * @param indices Three indices per triangle, reordered in place
+ * @param vertexCount Number of vertices
+ * @throws invalid_argument if checking and the indices are not well formed
+ */
+void MeshOptimizer::optimizeVertexCache(vector<GLuint>& indices, const size_t vertexCount) {
+    optimizeVertexCache(indices, vertexCount, CACHE_SIZE);
+}
+
+/**
+ * Reorders triangles so each vertex is reused while it is in the post-transform cache.
+ *
+ * Uses _Tipsify_, which emits every remaining triangle around one vertex at a
+ * time, then moves on to a neighbor that will still be in the cache after its
+ * own triangles are emitted.  It runs in time linear in the size of the mesh.
+ *
+ * @param indices Three indices per triangle, reordered in place
+ * @param vertexCount Number of vertices
+ * @param cacheSize Number of vertices the cache holds
+ * @throws invalid_argument if checking and the indices are not well formed
+ * @see Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007
+ */
+void MeshOptimizer::optimizeVertexCache(vector<GLuint>& indices,
+                                        const size_t vertexCount,
+                                        const size_t cacheSize) {
+    checkIndices(indices, vertexCount);
+    tipsify(indices, vertexCount, cacheSize);
+}
+
+/**
+ * Reorders vertices into the order the triangles first use them.
+ *
+ * Vertices are then read from memory mostly in order, rather than jumping
+ * around the vertex buffer.  Vertices no triangle uses are dropped from the
+ * end.  Run this after the triangles have been reordered.
+ *
+ * @param indices Three indices per triangle, rewritten to the new order
+ * @param vertices Interleaved vertices, reordered in place
+ * @param vertexCount Number of vertices
+ * @param vertexSize Size of each vertex in bytes
+ * @return Number of vertices used, which now come first
+ * @throws invalid_argument if checking and the indices are not well formed
+ */
+size_t MeshOptimizer::optimizeVertexFetch(vector<GLuint>& indices,
+                                          void* vertices,
+                                          const size_t vertexCount,
+                                          const size_t vertexSize) {
+
+    checkIndices(indices, vertexCount);
+
+    // Number vertices in order of first use
+    const GLuint unused = ~((GLuint) 0);
+    vector<GLuint> remap(vertexCount, unused);
+    GLuint next = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        GLuint& v = remap[indices[i]];
+        if (v == unused) {
+            v = next++;
+        }
+        indices[i] = v;
+    }
+
+    // Move vertices to their new places
+    char* bytes = (char*) vertices;
+    const vector<char> copy(bytes, bytes + vertexCount * vertexSize);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] != unused) {
+            memcpy(bytes + remap[v] * vertexSize, &copy[v * vertexSize], vertexSize);
+        }
+    }
+    return next;
+}
+
+/**
+ * Reorders triangles with _Tipsify_.
+ *
+ * @param indices Three indices per triangle, reordered in place
+ * @param vertexCount Number of vertices
+ * @param cacheSize Number of vertices the cache holds
+ * @return Triangles at which the cache starts over, in order, starting with `0`
+ */
+vector<size_t> MeshOptimizer::tipsify(vector<GLuint>& indices,
+                                      const size_t vertexCount,
+                                      const size_t cacheSize) {
+
+    const size_t triangles = indices.size() / 3;
+    vector<size_t> boundaries;
+    if (triangles == 0) {
+        return boundaries;
+    }
+
+    // Count the triangles left to emit around each vertex
+    vector<size_t> live(vertexCount, 0);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        ++live[indices[i]];
+    }
+
+    // List the triangles around each vertex
+    vector<size_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+    vector<size_t> adjacency(indices.size());
+    vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    // Fan around one vertex after another
+    vector<size_t> stamps(vertexCount, 0);
+    vector<bool> emitted(triangles, false);
+    vector<GLuint> deadEnds;
+    vector<GLuint> candidates;
+    vector<GLuint> output;
+    output.reserve(indices.size());
+    size_t time = cacheSize + 1;
+    size_t cursor = 0;
+    long fanning = -1;
+    while ((cursor < vertexCount) && (live[cursor] == 0)) {
+        ++cursor;
+    }
+    if (cursor < vertexCount) {
+        fanning = cursor;
+        boundaries.push_back(0);
+    }
+    while (fanning >= 0) {
+
+        // Emit the triangles left around the vertex
+        candidates.clear();
+        for (size_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+            const size_t t = adjacency[a];
+            if (emitted[t]) {
+                continue;
+            }
+            for (int j = 0; j < 3; ++j) {
+                const GLuint v = indices[t * 3 + j];
+                output.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - stamps[v] > cacheSize) {
+                    stamps[v] = time;
+                    ++time;
+                }
+            }
+            emitted[t] = true;
+        }
+
+        // Prefer the oldest neighbor that will still be cached after its own triangles
+        long next = -1;
+        long best = -1;
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            const GLuint v = candidates[c];
+            if (live[v] == 0) {
+                continue;
+            }
+            long priority = 0;
+            if (time - stamps[v] + 2 * live[v] <= cacheSize) {
+                priority = time - stamps[v];
+            }
+            if (priority > best) {
+                best = priority;
+                next = v;
+            }
+        }
+
+        // Otherwise back up to a recent vertex, or move on to an untouched one
+        while ((next < 0) && !deadEnds.empty()) {
+            const GLuint v = deadEnds.back();
+            deadEnds.pop_back();
+            if (live[v] > 0) {
+                next = v;
+            }
+        }
+        while ((next < 0) && (cursor < vertexCount)) {
+            if (live[cursor] > 0) {
+                next = cursor;
+            } else {
+                ++cursor;
+            }
+        }
+
+        // Remember where the cache starts over
+        if ((next >= 0) && (time - stamps[next] > cacheSize)) {
+            boundaries.push_back(output.size() / 3);
+        }
+        fanning = next;
+    }
+
+    indices.swap(output);
+    return boundaries;
+}
+
+/**
+ * Checks if this cluster should be drawn before another one.
+ *
+ * @param cluster Cluster to compare with
+ * @return `true` if this cluster faces further away from the middle of the mesh
+ */
+bool MeshOptimizer::Cluster::operator<(const Cluster& cluster) const {
+    return key > cluster.key;
+}
+
+// TYPES
+
+/**
+ * Constructs an empty report.
+ */
+MeshOptimizer::Report::Report() : acmrBefore(0), acmrAfter(0), clusters(0), vertices(0) {
+    // empty
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_MESHOPTIMIZER_HXX
+#define GLOOP_MESHOPTIMIZER_HXX
+#include "gloop/common.h"
+#include <cstddef>
+#include <vector>
+namespace Gloop {
+
+
+/**
+ * Reorders the triangles and vertices of an indexed mesh so it renders faster.
+ *
+ * Meshes exported from modeling tools list their triangles in whatever order
+ * they were made, so the GPU transforms the same vertex many times as it
+ * falls out of the post-transform cache between uses, reads vertices from all
+ * over the vertex buffer, and shades pixels that later triangles cover up.
+ * _MeshOptimizer_ fixes all three before the mesh is uploaded.
+ *
+ *  - @ref optimizeVertexCache reorders triangles with the _Tipsify_
+ *    algorithm, so each vertex is reused while it is still in the cache.
+ *  - @ref optimizeOverdraw does the same, then splits the result into
+ *    clusters and puts clusters facing outwards from the middle of the mesh
+ *    first, so they tend to be drawn before the triangles they hide.
+ *  - @ref optimizeVertexFetch reorders vertices into the order the triangles
+ *    first use them, so they are read from memory in order.
+ *
+ * Each works on a list of triangles, three indices per triangle, and keeps
+ * the winding of every triangle.  @ref optimize runs all three and reports
+ * the _average cache miss ratio_ (ACMR), the number of vertices transformed
+ * per triangle, before and after.  It ranges from `0.5` for a very large
+ * regular grid to `3` when no vertex is ever reused.
+ *
+ * ~~~
+ *     const MeshOptimizer::Report report = MeshOptimizer::optimize(
+ *             indices,
+ *             &vertices[0],
+ *             vertices.size(),
+ *             sizeof(Vertex),
+ *             offsetof(Vertex, position));
+ *     cout << "ACMR " << report.acmrBefore << " -> " << report.acmrAfter << endl;
+ *     elementArrayBuffer.data(indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+ * ~~~
+ */
+class MeshOptimizer {
+public:
+// Types
+    /**
+     * Effect of optimizing a mesh.
+     */
+    struct Report {
+        double acmrBefore;
+        double acmrAfter;
+        std::size_t clusters;
+        std::size_t vertices;
+        Report();
+    };
+// Constants
+    static const std::size_t CACHE_SIZE = 16;
+// Methods
+    static double acmr(const std::vector<GLuint>& indices);
+    static double acmr(const std::vector<GLuint>& indices, std::size_t cacheSize);
+    static Report optimize(std::vector<GLuint>& indices,
+                           void* vertices,
+                           std::size_t vertexCount,
+                           std::size_t vertexSize,
+                           std::size_t positionOffset);
+    static std::size_t optimizeOverdraw(std::vector<GLuint>& indices,
+                                        const GLfloat* positions,
+                                        std::size_t stride,
+                                        std::size_t vertexCount,
+                                        double threshold);
+    static void optimizeVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount);
+    static void optimizeVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount, std::size_t cacheSize);
+    static std::size_t optimizeVertexFetch(std::vector<GLuint>& indices,
+                                           void* vertices,
+                                           std::size_t vertexCount,
+                                           std::size_t vertexSize);
+private:
+// Types
+    struct Cluster {
+        std::size_t first;
+        std::size_t count;
+        double key;
+        bool operator<(const Cluster& cluster) const;
+    };
+// Methods
+    static void checkIndices(const std::vector<GLuint>& indices, std::size_t vertexCount);
+    static std::vector<std::size_t> tipsify(std::vector<GLuint>& indices,
+                                            std::size_t vertexCount,
+                                            std::size_t cacheSize);
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/ui/text/TestRunner.h>
+#include "gloop/MeshOptimizer.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Unit test for `MeshOptimizer`.
+ */
+class MeshOptimizerTest : public CppUnit::TestFixture {
+public:
+
+    /**
+     * Number of vertices along each side of the test grid.
+     */
+    static const GLuint SIDE = 40;
+
+    /**
+     * Vertex with a position and an identifier to follow it through reordering.
+     */
+    struct Vertex {
+        GLfloat position[3];
+        GLuint id;
+    };
+
+    /**
+     * Makes a grid of vertices on a bumpy surface.
+     */
+    static vector<Vertex> makeVertices() {
+        vector<Vertex> vertices(SIDE * SIDE);
+        for (size_t y = 0; y < SIDE; ++y) {
+            for (size_t x = 0; x < SIDE; ++x) {
+                Vertex& vertex = vertices[y * SIDE + x];
+                vertex.position[0] = (GLfloat) x;
+                vertex.position[1] = (GLfloat) y;
+                vertex.position[2] = (GLfloat) ((x * y) % 7);
+                vertex.id = y * SIDE + x;
+            }
+        }
+        return vertices;
+    }
+
+    /**
+     * Makes two triangles per cell of the grid, in a random order.
+     */
+    static vector<GLuint> makeIndices() {
+        vector<GLuint> indices;
+        for (GLuint y = 0; y + 1 < SIDE; ++y) {
+            for (GLuint x = 0; x + 1 < SIDE; ++x) {
+                const GLuint v = y * SIDE + x;
+                const GLuint triangles[] = { v, v + 1, v + SIDE, v + 1, v + SIDE + 1, v + SIDE };
+                indices.insert(indices.end(), triangles, triangles + 6);
+            }
+        }
+        srand(7);
+        for (size_t t = indices.size() / 3 - 1; t > 0; --t) {
+            const size_t u = rand() % (t + 1);
+            for (int j = 0; j < 3; ++j) {
+                swap(indices[t * 3 + j], indices[u * 3 + j]);
+            }
+        }
+        return indices;
+    }
+
+    /**
+     * Lists triangles by vertex identifier, each rotated to start with its smallest identifier, in sorted order.
+     */
+    static vector<vector<GLuint> > triangles(const vector<GLuint>& indices, const vector<Vertex>& vertices) {
+        vector<vector<GLuint> > list;
+        for (size_t t = 0; t < indices.size() / 3; ++t) {
+            vector<GLuint> triangle(3);
+            for (int j = 0; j < 3; ++j) {
+                triangle[j] = vertices[indices[t * 3 + j]].id;
+            }
+            rotate(triangle.begin(), min_element(triangle.begin(), triangle.end()), triangle.end());
+            list.push_back(triangle);
+        }
+        sort(list.begin(), list.end());
+        return list;
+    }
+
+    /**
+     * Ensures `acmr` counts the vertices transformed per triangle.
+     */
+    void testAcmr() {
+
+        // Two triangles sharing an edge
+        const GLuint quad[] = { 0, 1, 2, 2, 1, 3 };
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, MeshOptimizer::acmr(vector<GLuint>(quad, quad + 6)), 1e-9);
+
+        // Vertices fall out of a small cache in first-in, first-out order
+        const GLuint strip[] = { 0, 1, 2, 3, 4, 5, 0, 4, 5 };
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(7.0 / 3, MeshOptimizer::acmr(vector<GLuint>(strip, strip + 9), 3), 1e-9);
+
+        // No triangles
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, MeshOptimizer::acmr(vector<GLuint>()), 1e-9);
+    }
+
+    /**
+     * Ensures invalid index lists are rejected when checking.
+     */
+    void testCheckIndices() {
+        if (GLOOP_CHECKS) {
+            const GLuint partial[] = { 0, 1, 2, 3 };
+            vector<GLuint> indices(partial, partial + 4);
+            CPPUNIT_ASSERT_THROW(MeshOptimizer::optimizeVertexCache(indices, 4), invalid_argument);
+            indices.resize(3);
+            CPPUNIT_ASSERT_THROW(MeshOptimizer::optimizeVertexCache(indices, 2), invalid_argument);
+        }
+    }
+
+    /**
+     * Ensures `optimize` reorders a whole mesh and reports on it.
+     */
+    void testOptimize() {
+        vector<Vertex> vertices = makeVertices();
+        vector<GLuint> indices = makeIndices();
+        const vector<vector<GLuint> > expected = triangles(indices, vertices);
+
+        const MeshOptimizer::Report report = MeshOptimizer::optimize(
+                indices, &vertices[0], vertices.size(), sizeof(Vertex), offsetof(Vertex, position));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(MeshOptimizer::acmr(makeIndices()), report.acmrBefore, 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(MeshOptimizer::acmr(indices), report.acmrAfter, 1e-9);
+        CPPUNIT_ASSERT(report.acmrAfter < report.acmrBefore);
+        CPPUNIT_ASSERT(report.clusters >= 1);
+        CPPUNIT_ASSERT_EQUAL(vertices.size(), report.vertices);
+        CPPUNIT_ASSERT(expected == triangles(indices, vertices));
+    }
+
+    /**
+     * Ensures `optimizeOverdraw` keeps every triangle and the cache order within each cluster.
+     */
+    void testOptimizeOverdraw() {
+        const vector<Vertex> vertices = makeVertices();
+        vector<GLuint> indices = makeIndices();
+        const vector<vector<GLuint> > expected = triangles(indices, vertices);
+
+        const size_t clusters = MeshOptimizer::optimizeOverdraw(
+                indices, vertices[0].position, sizeof(Vertex), vertices.size(), 1.05);
+        CPPUNIT_ASSERT(clusters >= 1);
+        CPPUNIT_ASSERT(clusters <= indices.size() / 3);
+        CPPUNIT_ASSERT(expected == triangles(indices, vertices));
+        CPPUNIT_ASSERT(MeshOptimizer::acmr(indices) < 1.05 * MeshOptimizer::acmr(makeIndices()));
+    }
+
+    /**
+     * Ensures `optimizeVertexCache` lowers the miss ratio of a shuffled grid without changing its triangles.
+     */
+    void testOptimizeVertexCache() {
+        const vector<Vertex> vertices = makeVertices();
+        vector<GLuint> indices = makeIndices();
+        const vector<vector<GLuint> > expected = triangles(indices, vertices);
+        const double before = MeshOptimizer::acmr(indices);
+
+        MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+        const double after = MeshOptimizer::acmr(indices);
+        CPPUNIT_ASSERT(before > 2.0);
+        CPPUNIT_ASSERT(after < 0.8);
+        CPPUNIT_ASSERT(expected == triangles(indices, vertices));
+    }
+
+    /**
+     * Ensures `optimizeVertexFetch` numbers vertices in order of first use and drops unused ones.
+     */
+    void testOptimizeVertexFetch() {
+        vector<Vertex> vertices = makeVertices();
+        vector<GLuint> indices = makeIndices();
+        indices.resize(indices.size() / 2);
+        vector<vector<GLuint> > expected = triangles(indices, vertices);
+
+        const size_t used = MeshOptimizer::optimizeVertexFetch(
+                indices, &vertices[0], vertices.size(), sizeof(Vertex));
+        CPPUNIT_ASSERT(used < vertices.size());
+        CPPUNIT_ASSERT(expected == triangles(indices, vertices));
+        GLuint next = 0;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            CPPUNIT_ASSERT(indices[i] <= next);
+            if (indices[i] == next) {
+                ++next;
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(used, (size_t) next);
+    }
+
+    CPPUNIT_TEST_SUITE(MeshOptimizerTest);
+    CPPUNIT_TEST(testAcmr);
+    CPPUNIT_TEST(testCheckIndices);
+    CPPUNIT_TEST(testOptimize);
+    CPPUNIT_TEST(testOptimizeOverdraw);
+    CPPUNIT_TEST(testOptimizeVertexCache);
+    CPPUNIT_TEST(testOptimizeVertexFetch);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+} /* namespace Gloop */
+
+int main(int argc, char* argv[]) {
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(Gloop::MeshOptimizerTest::suite());
+    runner.run();
+    return 0;
+}
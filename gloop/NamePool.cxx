@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <stdexcept>
+#include "gloop/NamePool.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Creates an empty pool.
+ *
+ * @param type Type of object, e.g. `GL_BUFFER` or `GL_TEXTURE`
+ * @param blockSize Number of names to generate at once when the pool is empty
+ * @throws std::invalid_argument if type is not supported or block size is not positive
+ */
+NamePool::NamePool(const GLenum type, const GLsizei blockSize) :
+        _blocks(0),
+        _blockSize(blockSize),
+        _type(type) {
+    switch (type) {
+    case GL_BUFFER:
+    case GL_FRAMEBUFFER:
+    case GL_RENDERBUFFER:
+    case GL_TEXTURE:
+    case GL_VERTEX_ARRAY:
+        break;
+    default:
+        throw invalid_argument("[NamePool] Type is not supported!");
+    }
+    if (blockSize <= 0) {
+        throw invalid_argument("[NamePool] Block size is not positive!");
+    }
+}
+
+/**
+ * Returns the number of names that can be taken without generating more.
+ */
+GLsizei NamePool::available() const {
+    return _names.size();
+}
+
+/**
+ * Returns the number of blocks of names generated so far.
+ */
+unsigned long NamePool::blocks() const {
+    return _blocks;
+}
+
+/**
+ * Returns the number of names generated at once when the pool is empty.
+ */
+GLsizei NamePool::blockSize() const {
+    return _blockSize;
+}
+
+/**
+ * Deletes all the names in the pool at once.
+ *
+ * Names that have been taken and not given back are left alone.
+ */
+void NamePool::dispose() {
+
+    if (_names.empty()) {
+        return;
+    }
+
+    deleteNames(_type, _names.size(), &_names[0]);
+    _names.clear();
+}
+
+/**
+ * Deletes several names of one type of object with a single call.
+ *
+ * @param type Type of object, e.g. `GL_BUFFER`
+ * @param n Number of names to delete
+ * @param names Names to delete
+ */
+void NamePool::deleteNames(const GLenum type, const GLsizei n, const GLuint* names) {
+    switch (type) {
+    case GL_BUFFER:
+        glDeleteBuffers(n, names);
+        break;
+    case GL_FRAMEBUFFER:
+        glDeleteFramebuffers(n, names);
+        break;
+    case GL_RENDERBUFFER:
+        glDeleteRenderbuffers(n, names);
+        break;
+    case GL_TEXTURE:
+        glDeleteTextures(n, names);
+        break;
+    case GL_VERTEX_ARRAY:
+        glDeleteVertexArrays(n, names);
+        break;
+    }
+}
+
+/**
+ * Generates several names of one type of object with a single call.
+ *
+ * Used by the `generate(GLsizei)` method of each object handle, which only
+ * has to wrap the names.
+ *
+ * @param type Type of object, e.g. `GL_BUFFER`
+ * @param n Number of names to generate
+ * @return New names, in the order generated
+ * @throws std::invalid_argument if type is not supported or number is negative
+ * @throws std::runtime_error if the names could not be generated
+ */
+vector<GLuint> NamePool::generate(const GLenum type, const GLsizei n) {
+
+    // Check number
+    if (n < 0) {
+        throw invalid_argument("[NamePool] Number is negative!");
+    } else if (n == 0) {
+        return vector<GLuint>();
+    }
+
+    // Generate all the names in one call
+    vector<GLuint> names(n, 0);
+    generateNames(type, n, &names[0]);
+    if (names[0] == 0) {
+        throw runtime_error("[NamePool] Could not generate names!");
+    }
+    return names;
+}
+
+/**
+ * Calls the `glGen*` function for one type of object.
+ *
+ * @param type Type of object, e.g. `GL_BUFFER`
+ * @param n Number of names to generate
+ * @param names Array to store the new names in
+ * @throws std::invalid_argument if type is not supported
+ */
+void NamePool::generateNames(const GLenum type, const GLsizei n, GLuint* names) {
+    switch (type) {
+    case GL_BUFFER:
+        glGenBuffers(n, names);
+        break;
+    case GL_FRAMEBUFFER:
+        glGenFramebuffers(n, names);
+        break;
+    case GL_RENDERBUFFER:
+        glGenRenderbuffers(n, names);
+        break;
+    case GL_TEXTURE:
+        glGenTextures(n, names);
+        break;
+    case GL_VERTEX_ARRAY:
+        glGenVertexArrays(n, names);
+        break;
+    default:
+        throw invalid_argument("[NamePool] Type is not supported!");
+    }
+}
+
+/**
+ * Gives a name back to the pool so it can be taken again.
+ *
+ * @param name Name of an object of the pool's type that is no longer used
+ * @throws std::invalid_argument if name is zero
+ */
+void NamePool::release(const GLuint name) {
+    if (name == 0) {
+        throw invalid_argument("[NamePool] Name is zero!");
+    }
+    _names.push_back(name);
+}
+
+/**
+ * Gives a name back to the pool after checking it is for the right type.
+ *
+ * @param type Type of object the name is for, e.g. `GL_BUFFER`
+ * @param name Name of an object that is no longer used
+ * @throws std::invalid_argument if the pool is not for that type or name is zero
+ */
+void NamePool::release(const GLenum type, const GLuint name) {
+    if (type != _type) {
+        throw invalid_argument("[NamePool] Pool is for a different type of object!");
+    }
+    release(name);
+}
+
+/**
+ * Takes a name out of the pool, generating a new block of names if it is empty.
+ *
+ * @return Name of an object of the pool's type
+ * @throws std::runtime_error if names could not be generated
+ */
+GLuint NamePool::take() {
+
+    // Generate another block if needed
+    if (_names.empty()) {
+        _names.resize(_blockSize, 0);
+        generateNames(_type, _blockSize, &_names[0]);
+        if (_names[0] == 0) {
+            _names.clear();
+            throw runtime_error("[NamePool] Could not generate names!");
+        }
+        ++_blocks;
+
+        // Hand out in the order generated
+        reverse(_names.begin(), _names.end());
+    }
+
+    // Take the last one
+    const GLuint name = _names.back();
+    _names.pop_back();
+    return name;
+}
+
+/**
+ * Takes a name out of the pool after checking it is for the right type.
+ *
+ * @param type Type of object the name is needed for, e.g. `GL_BUFFER`
+ * @return Name of an object of that type
+ * @throws std::invalid_argument if the pool is not for that type
+ * @throws std::runtime_error if names could not be generated
+ */
+GLuint NamePool::take(const GLenum type) {
+    if (type != _type) {
+        throw invalid_argument("[NamePool] Pool is for a different type of object!");
+    }
+    return take();
+}
+
+/**
+ * Returns the type of object the names are for.
+ *
+ * @return Enumeration for the type, e.g. `GL_BUFFER`
+ */
+GLenum NamePool::type() const {
+    return _type;
+}
+
+} /* namespace Gloop */
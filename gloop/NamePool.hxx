@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_NAMEPOOL_HXX
+#define GLOOP_NAMEPOOL_HXX
+#include "gloop/common.h"
+#include <vector>
+#ifndef GL_BUFFER
+#define GL_BUFFER 0x82E0
+#endif
+#ifndef GL_VERTEX_ARRAY
+#define GL_VERTEX_ARRAY 0x8074
+#endif
+namespace Gloop {
+
+
+/**
+ * Names for one type of OpenGL object, generated in blocks and reused.
+ *
+ * Generating objects one at a time makes a driver call for each one.  A
+ * _NamePool_ instead generates a whole block of names at once when it runs
+ * out, and hands them out one by one.  Objects can also be given back to the
+ * pool instead of being deleted, so their names are reused.
+ *
+ * ~~~
+ *     NamePool buffers(GL_BUFFER, 256);
+ *     const BufferObject bo = BufferObject::generate(buffers);
+ *     ...
+ *     bo.dispose(buffers);
+ *     ...
+ *     buffers.dispose();
+ * ~~~
+ *
+ * The type of object is given by the same enumeration `glObjectLabel` uses,
+ * i.e. `GL_BUFFER`, `GL_FRAMEBUFFER`, `GL_RENDERBUFFER`, `GL_TEXTURE` or
+ * `GL_VERTEX_ARRAY`.
+ *
+ * Objects given back to a pool are not deleted, so they keep their storage,
+ * attachments and other state, and can even still be bound.  They are best
+ * used for objects that are set up from scratch each time, such as buffer
+ * objects filled with @ref BufferTarget::data.  Textures also keep the target
+ * they were first bound to, so a pool should only be used for one kind of
+ * texture.
+ *
+ * Pools cannot be copied, since each one owns its names.  Call @ref dispose to
+ * delete all the names still in a pool.
+ */
+class NamePool {
+public:
+// Methods
+    NamePool(GLenum type, GLsizei blockSize);
+    GLsizei available() const;
+    unsigned long blocks() const;
+    GLsizei blockSize() const;
+    void dispose();
+    static std::vector<GLuint> generate(GLenum type, GLsizei n);
+    void release(GLuint name);
+    void release(GLenum type, GLuint name);
+    GLuint take();
+    GLuint take(GLenum type);
+    GLenum type() const;
+private:
+// Attributes
+    unsigned long _blocks;
+    GLsizei _blockSize;
+    std::vector<GLuint> _names;
+    GLenum _type;
+// Methods
+    NamePool(const NamePool& pool);
+    static void deleteNames(GLenum type, GLsizei n, const GLuint* names);
+    static void generateNames(GLenum type, GLsizei n, GLuint* names);
+    NamePool& operator=(const NamePool& pool);
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/BufferObject.hxx"
+#include "gloop/NamePool.hxx"
+#include "gloop/TextureObject.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for `NamePool`.
+ */
+class NamePoolTest {
+public:
+
+    /**
+     * Ensures names are generated in blocks and reused when given back.
+     */
+    void testTake() {
+
+        NamePool pool(GL_BUFFER, 4);
+        CPPUNIT_ASSERT_EQUAL((GLsizei) 0, pool.available());
+
+        // Take a few, which should only need one block
+        const BufferObject b1 = BufferObject::generate(pool);
+        const BufferObject b2 = BufferObject::generate(pool);
+        const BufferObject b3 = BufferObject::generate(pool);
+        CPPUNIT_ASSERT(b1 != b2);
+        CPPUNIT_ASSERT(b2 != b3);
+        CPPUNIT_ASSERT_EQUAL(1UL, pool.blocks());
+        CPPUNIT_ASSERT_EQUAL((GLsizei) 1, pool.available());
+
+        // Give one back and take it again
+        b2.dispose(pool);
+        CPPUNIT_ASSERT_EQUAL((GLsizei) 2, pool.available());
+        const BufferObject b4 = BufferObject::generate(pool);
+        CPPUNIT_ASSERT(b4 == b2);
+
+        // Empty it, which should need another block
+        BufferObject::generate(pool);
+        BufferObject::generate(pool);
+        CPPUNIT_ASSERT_EQUAL(2UL, pool.blocks());
+        CPPUNIT_ASSERT_EQUAL((GLsizei) 3, pool.available());
+
+        // Delete what's left
+        pool.dispose();
+        CPPUNIT_ASSERT_EQUAL((GLsizei) 0, pool.available());
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+    }
+
+    /**
+     * Ensures pools only work with the type of object they are for.
+     */
+    void testTakeWithWrongType() {
+        NamePool pool(GL_TEXTURE, 2);
+        CPPUNIT_ASSERT_THROW(BufferObject::generate(pool), invalid_argument);
+        const TextureObject to = TextureObject::generate(pool);
+        CPPUNIT_ASSERT(to.id() > 0);
+        const BufferObject bo = BufferObject::generate();
+        CPPUNIT_ASSERT_THROW(bo.dispose(pool), invalid_argument);
+        bo.dispose();
+        to.dispose(pool);
+        pool.dispose();
+        CPPUNIT_ASSERT_THROW(NamePool(GL_ARRAY_BUFFER, 2), invalid_argument);
+        CPPUNIT_ASSERT_THROW(NamePool(GL_BUFFER, 0), invalid_argument);
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    NamePoolTest test;
+    try {
+        test.testTake();
+        test.testTakeWithWrongType();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -59,82 +59,38 @@ Program::Program(const Program& program) : _id(program._id) {
 /**
  * Retrieves all the active attributes in this program.
  *
+ * Prefer @ref reflect when looking up variables often, since its lookups do
+ * not compare strings or allocate memory.
+ *
  * @return Mapping of all the active attributes in this program by name
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetActiveAttrib.xml
  */
 map<string,Attribute> Program::activeAttributes() const {
-
-    // Get number of active attributes
-    GLint num;
-    glGetProgramiv(_id, GL_ACTIVE_ATTRIBUTES, &num);
-    if (num == 0) {
-        return map<string,Attribute>();
-    }
-
-    // Make a buffer to hold name of an attribute
-    GLint len;
-    glGetProgramiv(_id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &len);
-    char* const buf = new char[len];
-
-    // Make variables to hold size and type of an attribute
-    GLint size;
-    GLenum type;
-
-    // Put active attributes into a map
+    const ProgramReflection& reflection = reflect();
+    const vector<Attribute>& attributes = reflection.attributes();
     map<string,Attribute> attribs;
-    for (int i = 0; i < num; ++i) {
-        glGetActiveAttrib(_id, i, len, NULL, &size, &type, buf);
-        const GLint location = glGetAttribLocation(_id, buf);
-        const string name = buf;
-        const Attribute attrib(location, name, _id, size, type);
-        attribs.insert(pair<string,Attribute>(name, attrib));
+    for (vector<Attribute>::const_iterator it = attributes.begin(); it != attributes.end(); ++it) {
+        attribs.insert(pair<string,Attribute>(it->name(), *it));
     }
-
-    // Delete the buffer
-    delete[] buf;
-
-    // Return the vector
     return attribs;
 }
 
 /**
  * Retrieves all the active uniforms in this program.
  *
+ * Prefer @ref reflect when looking up variables often, since its lookups do
+ * not compare strings or allocate memory.
+ *
  * @return Mapping of all the active uniforms in this program by name
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetActiveUniform.xml
  */
 map<string,Uniform> Program::activeUniforms() const {
-
-    // Get number of active uniforms
-    GLint num;
-    glGetProgramiv(_id, GL_ACTIVE_UNIFORMS, &num);
-    if (num == 0) {
-        return map<string,Uniform>();
-    }
-
-    // Make a buffer to hold name of a uniform
-    GLint len;
-    glGetProgramiv(_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &len);
-    char* const buf = new char[len];
-
-    // Make variables to hold size and type of a uniform
-    GLint size;
-    GLenum type;
-
-    // Put active uniforms into a map
+    const ProgramReflection& reflection = reflect();
+    const vector<Uniform>& active = reflection.uniforms();
     map<string,Uniform> uniforms;
-    for (int i = 0; i < num; ++i) {
-        glGetActiveUniform(_id, i, len, NULL, &size, &type, buf);
-        const GLint location = glGetUniformLocation(_id, buf);
-        const string name = buf;
-        const Uniform uniform(location, name, _id, size, type);
-        uniforms.insert(pair<string,Uniform>(name, uniform));
+    for (vector<Uniform>::const_iterator it = active.begin(); it != active.end(); ++it) {
+        uniforms.insert(pair<string,Uniform>(it->name(), *it));
     }
-
-    // Delete the buffer
-    delete[] buf;
-
-    // Return the vector
     return uniforms;
 }
 
@@ -162,6 +118,7 @@ void Program::attachShader(const Shader &shader) const {
         throw logic_error("[Program] Shader is already attached!");
     }
     glAttachShader(_id, shader.id());
+    getState().attach(shader.id());
 }
 
 /**
@@ -181,7 +138,17 @@ GLint Program::attribLocation(const std::string &name) const {
         throw logic_error("[Program] Program not linked yet!");
     }
 
-    return glGetAttribLocation(_id, name.c_str());
+    // Check if already known
+    ProgramState& state = getState();
+    GLint location;
+    if (state.findAttribLocation(name, location)) {
+        return location;
+    }
+
+    // Otherwise ask OpenGL and remember it
+    location = glGetAttribLocation(_id, name.c_str());
+    state.storeAttribLocation(name, location);
+    return location;
 }
 
 /**
@@ -214,6 +181,11 @@ Program Program::create() {
         throw runtime_error("[Program] Could not create program!");
     }
 
+    // Remember it has no shaders and is not linked
+    ProgramState& state = Context::current().programState(id);
+    state.storeShaders(vector<GLuint>());
+    state.storeLinked(false);
+
     // Make the program
     return Program(id);
 }
@@ -256,6 +228,7 @@ void Program::detachShader(const Shader &shader) const {
         throw logic_error("[Program] Shader not already attached!");
     }
     glDetachShader(_id, shader.id());
+    getState().detach(shader.id());
 }
 
 /**
@@ -265,6 +238,7 @@ void Program::detachShader(const Shader &shader) const {
  */
 void Program::dispose() const {
     glDeleteProgram(_id);
+    Context::current().forgetProgram(_id);
 }
 
 /**
@@ -324,9 +298,7 @@ Program Program::fromId(const GLuint id) {
  * @return Identifier of the current OpenGL shader program, or `0` if none
  */
 GLuint Program::getCurrentProgram() {
-    GLuint id;
-    glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*) &id);
-    return id;
+    return (GLuint) Context::current().integer(GL_CURRENT_PROGRAM);
 }
 
 /**
@@ -341,22 +313,52 @@ GLuint Program::id() const {
 /**
  * Links this program.
  *
+ * Linking resets the values of the program's uniforms, so the values remembered for them are forgotten.
+ * If linking succeeded, the active variables are reflected and remembered for @ref reflect.
+ *
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glLinkProgram.xml
  */
 void Program::link() const {
     glLinkProgram(_id);
+
+    // Forget anything linking may have changed
+    Context& context = Context::current();
+    ProgramState& state = context.programState(_id);
+    state.forgetLink();
+    context.uniforms().forget(_id);
+
+    // Reflect the new active variables once
+    if (linked()) {
+        state.storeReflection(ProgramReflection(_id));
+    }
 }
 
 /**
  * Checks if this program is linked.
  *
  * @return `true` if this program is linked
+ * @throws logic_error if verifying and remembered status differs from OpenGL
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetProgram.xml
  */
 bool Program::linked() const {
-    GLint linked;
-    glGetProgramiv(_id, GL_LINK_STATUS, &linked);
-    return linked;
+
+    // Use remembered status unless verifying
+    Context& context = Context::current();
+    ProgramState& state = context.programState(_id);
+    bool linked;
+    const bool known = state.findLinked(linked);
+    if (known && !context.verifying()) {
+        return linked;
+    }
+
+    // Otherwise ask OpenGL
+    GLint actual;
+    glGetProgramiv(_id, GL_LINK_STATUS, &actual);
+    if (known && (linked != (actual == GL_TRUE))) {
+        throw logic_error("[Program] Remembered status differs from OpenGL!");
+    }
+    state.storeLinked(actual == GL_TRUE);
+    return actual == GL_TRUE;
 }
 
 /**
@@ -426,6 +428,30 @@ bool Program::operator<(const Program& program) const {
     return _id < program._id;
 }
 
+/**
+ * Retrieves the active attributes and uniforms of this program, indexed for fast lookup.
+ *
+ * The reflection is made when the program is linked through @ref link and
+ * remembered in its @ref ProgramState, so this does not query OpenGL.  It is
+ * only made here if the program was linked some other way.
+ *
+ * @return Reference to the reflection, valid until the program is linked again or deleted
+ * @see ProgramReflection
+ */
+const ProgramReflection& Program::reflect() const {
+
+    // Use the remembered reflection if there is one
+    ProgramState& state = getState();
+    const ProgramReflection* reflection = state.findReflection();
+    if (reflection != NULL) {
+        return *reflection;
+    }
+
+    // Otherwise make it
+    state.storeReflection(ProgramReflection(_id));
+    return *state.findReflection();
+}
+
 /**
  * Retrieves all the shaders attached to this program.
  *
@@ -476,28 +502,71 @@ GLint Program::uniformLocation(const string& name) const {
         throw logic_error("[Program] Program not linked yet!");
     }
 
-    return glGetUniformLocation(_id, name.c_str());
+    // Check if already known
+    ProgramState& state = getState();
+    GLint location;
+    if (state.findUniformLocation(name, location)) {
+        return location;
+    }
+
+    // Otherwise ask OpenGL and remember it
+    location = glGetUniformLocation(_id, name.c_str());
+    state.storeUniformLocation(name, location);
+    return location;
+}
+
+/**
+ * Deactivates the current program, if there is one.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glUseProgram.xml
+ */
+void Program::unuse() {
+    Context& context = Context::current();
+    if (context.integer(GL_CURRENT_PROGRAM) != 0) {
+        glUseProgram(0);
+        context.integer(GL_CURRENT_PROGRAM, 0);
+    }
 }
 
 /**
- * Activates this program.
+ * Activates this program, unless it is already the current program.
  *
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glUseProgram.xml
  */
 void Program::use() const {
-    glUseProgram(_id);
+    Context& context = Context::current();
+    if (context.integer(GL_CURRENT_PROGRAM) != (GLint) _id) {
+        glUseProgram(_id);
+        context.integer(GL_CURRENT_PROGRAM, _id);
+    }
 }
 
 /**
  * Checks if this program is valid.
  *
  * @return `true` if this program is valid
+ * @throws logic_error if verifying and remembered status differs from OpenGL
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetProgram.xml
  */
 bool Program::valid() const {
-    GLint valid;
-    glGetProgramiv(_id, GL_VALIDATE_STATUS, &valid);
-    return valid;
+
+    // Use remembered status unless verifying
+    Context& context = Context::current();
+    ProgramState& state = context.programState(_id);
+    bool valid;
+    const bool known = state.findValid(valid);
+    if (known && !context.verifying()) {
+        return valid;
+    }
+
+    // Otherwise ask OpenGL
+    GLint actual;
+    glGetProgramiv(_id, GL_VALIDATE_STATUS, &actual);
+    if (known && (valid != (actual == GL_TRUE))) {
+        throw logic_error("[Program] Remembered status differs from OpenGL!");
+    }
+    state.storeValid(actual == GL_TRUE);
+    return actual == GL_TRUE;
 }
 
 /**
@@ -507,6 +576,7 @@ bool Program::valid() const {
  */
 void Program::validate() const {
     glValidateProgram(_id);
+    getState().forgetValid();
 }
 
 // HELPERS
@@ -518,24 +588,40 @@ void Program::validate() const {
  * @return `true` if shader is attached
  */
 bool Program::isAttached(const Shader &shader) const {
-    const vector<Shader> attachedShaders = shaders();
-    vector<Shader>::const_iterator it = attachedShaders.begin();
-    while (it != attachedShaders.end()) {
-        if ((*it) == shader) {
-            return true;
-        }
-        ++it;
+
+    // Check if attached shaders are already known
+    ProgramState& state = getState();
+    bool attached;
+    if (state.findAttached(shader.id(), attached)) {
+        return attached;
     }
-    return false;
+
+    // Otherwise ask OpenGL for all of them once
+    GLint len;
+    glGetProgramiv(_id, GL_ATTACHED_SHADERS, &len);
+    vector<GLuint> ids(len);
+    if (len > 0) {
+        glGetAttachedShaders(_id, len, NULL, &ids[0]);
+    }
+    state.storeShaders(ids);
+
+    // Look it up again
+    state.findAttached(shader.id(), attached);
+    return attached;
+}
+
+/**
+ * Returns what Gloop remembers about this program in the current context.
+ */
+ProgramState& Program::getState() const {
+    return Context::current().programState(_id);
 }
 
 /**
  * Returns the value of GL_MAX_DRAW_BUFFERS.
  */
 GLint Program::getMaxDrawBuffers() {
-    GLint value;
-    glGetIntegerv(GL_MAX_DRAW_BUFFERS, &value);
-    return value;
+    return Context::current().capabilities().maxDrawBuffers();
 }
 
 } /* namespace Gloop */
@@ -29,6 +29,8 @@
 #include <map>
 #include <vector>
 #include "gloop/Attribute.hxx"
+#include "gloop/Context.hxx"
+#include "gloop/ProgramReflection.hxx"
 #include "gloop/Shader.hxx"
 #include "gloop/Uniform.hxx"
 namespace Gloop {
@@ -36,6 +38,15 @@ namespace Gloop {
 
 /**
  * Handle for an OpenGL shader program.
+ *
+ * The current program is remembered by the current @ref Context, so using a
+ * program that is already current does not call OpenGL again.  Call @ref unuse
+ * instead of `glUseProgram(0)`, or invalidate the context after calling OpenGL
+ * directly.
+ *
+ * The link status, validation status, attached shaders and looked up locations
+ * of each program are remembered in a @ref ProgramState, so setting up many
+ * programs does not keep asking OpenGL the same questions.
  */
 class Program {
 public:
@@ -64,8 +75,10 @@ public:
     bool operator==(const Program& program) const;
     bool operator!=(const Program& program) const;
     bool operator<(const Program& program) const;
+    const ProgramReflection& reflect() const;
     std::vector<Shader> shaders() const;
     GLint uniformLocation(const std::string& name) const;
+    static void unuse();
     void use() const;
     bool valid() const;
     void validate() const;
@@ -77,6 +90,7 @@ private:
     Program();
     static GLuint getCurrentProgram();
     static GLint getMaxDrawBuffers();
+    ProgramState& getState() const;
     bool isAttached(const Shader& shader) const;
 };
 
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "gloop/ProgramReflection.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs an empty reflection that does not describe any program.
+ */
+ProgramReflection::ProgramReflection() : _program(0) {
+    // empty
+}
+
+/**
+ * Constructs a reflection of the active variables of a program.
+ *
+ * @param program ID of a linked shader program
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetActiveAttrib.xml
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetActiveUniform.xml
+ */
+ProgramReflection::ProgramReflection(const GLuint program) : _program(program) {
+
+    // Make a buffer big enough to hold the name of any variable
+    GLint attributeLength;
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &attributeLength);
+    GLint uniformLength;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniformLength);
+    vector<GLchar> buf(max(max(attributeLength, uniformLength), 1));
+    const GLsizei len = buf.size();
+
+    // Make variables to hold size and type of a variable
+    GLint size;
+    GLenum type;
+
+    // Read active attributes in the order OpenGL reports them
+    GLint num;
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &num);
+    vector<Attribute> attributes;
+    vector<string> attributeNames;
+    for (int i = 0; i < num; ++i) {
+        glGetActiveAttrib(program, i, len, NULL, &size, &type, &buf[0]);
+        const GLint location = glGetAttribLocation(program, &buf[0]);
+        attributes.push_back(Attribute(location, &buf[0], program, size, type));
+        attributeNames.push_back(&buf[0]);
+    }
+
+    // Store them sorted by hash
+    const vector<int> attributeOrder = buildIndex(_attributeIndex, attributeNames);
+    _attributes.reserve(num);
+    for (int i = 0; i < num; ++i) {
+        _attributes.push_back(attributes[attributeOrder[i]]);
+    }
+
+    // Read active uniforms in the order OpenGL reports them
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &num);
+    vector<Uniform> uniforms;
+    vector<string> uniformNames;
+    for (int i = 0; i < num; ++i) {
+        glGetActiveUniform(program, i, len, NULL, &size, &type, &buf[0]);
+        const GLint location = glGetUniformLocation(program, &buf[0]);
+        uniforms.push_back(Uniform(location, &buf[0], program, size, type));
+        uniformNames.push_back(&buf[0]);
+    }
+
+    // Store them sorted by hash
+    const vector<int> uniformOrder = buildIndex(_uniformIndex, uniformNames);
+    _uniforms.reserve(num);
+    for (int i = 0; i < num; ++i) {
+        _uniforms.push_back(uniforms[uniformOrder[i]]);
+    }
+}
+
+/**
+ * Returns an active attribute by its key.
+ *
+ * @param key Key returned by @ref attributeKey
+ * @return Reference to the attribute
+ * @throws std::out_of_range if key is not a valid key for an attribute
+ */
+const Attribute& ProgramReflection::attribute(const int key) const {
+    if (GLOOP_CHECKS && ((key < 0) || (key >= (int) _attributes.size()))) {
+        throw out_of_range("[ProgramReflection] Key is out of range!");
+    }
+    return _attributes[key];
+}
+
+/**
+ * Looks up the key of an active attribute.
+ *
+ * @param name Name of the attribute
+ * @return Key to pass to @ref attribute, or `-1` if the attribute is not active
+ */
+int ProgramReflection::attributeKey(const char* name) const {
+    return find(_attributeIndex, name);
+}
+
+/**
+ * Returns all the active attributes, sorted by the hashes of their names.
+ *
+ * @return Reference to the active attributes
+ */
+const vector<Attribute>& ProgramReflection::attributes() const {
+    return _attributes;
+}
+
+/**
+ * Sorts variables by the hashes of their names and indexes them.
+ *
+ * @param index Index to fill in
+ * @param names Names of the variables, in the order OpenGL reports them
+ * @return Position of each variable in _names_, in sorted order
+ */
+vector<int> ProgramReflection::buildIndex(Index& index, const vector<string>& names) {
+
+    // Sort positions by hash
+    const int num = names.size();
+    vector<pair<GLuint,int> > sorted;
+    sorted.reserve(num);
+    for (int i = 0; i < num; ++i) {
+        sorted.push_back(pair<GLuint,int>(hash(names[i].c_str()), i));
+    }
+    sort(sorted.begin(), sorted.end());
+
+    // Copy hashes and names in sorted order
+    vector<int> order;
+    order.reserve(num);
+    index.hashes.reserve(num);
+    index.names.reserve(num);
+    for (int i = 0; i < num; ++i) {
+        order.push_back(sorted[i].second);
+        index.hashes.push_back(sorted[i].first);
+        index.names.push_back(names[sorted[i].second]);
+    }
+
+    // Make a table at most half full, with a power of two size
+    if (num == 0) {
+        return order;
+    }
+    size_t size = 2;
+    while (size < (size_t) (2 * num)) {
+        size *= 2;
+    }
+    index.slots.assign(size, -1);
+
+    // Put each variable into the first free slot from its hash
+    const GLuint mask = size - 1;
+    for (int i = 0; i < num; ++i) {
+        GLuint slot = index.hashes[i] & mask;
+        while (index.slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        index.slots[slot] = i;
+    }
+    return order;
+}
+
+/**
+ * Looks up the position of a variable in an index.
+ *
+ * @param index Index to search
+ * @param name Name of the variable
+ * @return Position of the variable, or `-1` if it is not in the index
+ */
+int ProgramReflection::find(const Index& index, const char* name) {
+
+    // Check if empty
+    if (index.slots.empty()) {
+        return -1;
+    }
+
+    // Probe from the slot of the hash until an empty slot
+    const GLuint h = hash(name);
+    const GLuint mask = index.slots.size() - 1;
+    for (GLuint slot = h & mask; index.slots[slot] >= 0; slot = (slot + 1) & mask) {
+        const int i = index.slots[slot];
+        if ((index.hashes[i] == h) && (index.names[i] == name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Finds an active attribute by name.
+ *
+ * @param name Name of the attribute
+ * @return Pointer to the attribute, or `NULL` if the attribute is not active
+ */
+const Attribute* ProgramReflection::findAttribute(const char* name) const {
+    const int key = find(_attributeIndex, name);
+    return (key < 0) ? NULL : &_attributes[key];
+}
+
+/**
+ * Finds an active uniform by name.
+ *
+ * @param name Name of the uniform
+ * @return Pointer to the uniform, or `NULL` if the uniform is not active
+ */
+const Uniform* ProgramReflection::findUniform(const char* name) const {
+    const int key = find(_uniformIndex, name);
+    return (key < 0) ? NULL : &_uniforms[key];
+}
+
+/**
+ * Computes the hash of a variable name, using 32-bit FNV-1a.
+ *
+ * @param name Name of a variable
+ * @return Hash of the name
+ */
+GLuint ProgramReflection::hash(const char* name) {
+    GLuint h = 2166136261u;
+    for (const char* c = name; (*c) != '\0'; ++c) {
+        h ^= (unsigned char) (*c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Returns the ID of the program this reflection describes.
+ *
+ * @return ID of the program, or `0` if this reflection is empty
+ */
+GLuint ProgramReflection::program() const {
+    return _program;
+}
+
+/**
+ * Returns an active uniform by its key.
+ *
+ * @param key Key returned by @ref uniformKey
+ * @return Reference to the uniform
+ * @throws std::out_of_range if key is not a valid key for a uniform
+ */
+const Uniform& ProgramReflection::uniform(const int key) const {
+    if (GLOOP_CHECKS && ((key < 0) || (key >= (int) _uniforms.size()))) {
+        throw out_of_range("[ProgramReflection] Key is out of range!");
+    }
+    return _uniforms[key];
+}
+
+/**
+ * Looks up the key of an active uniform.
+ *
+ * @param name Name of the uniform
+ * @return Key to pass to @ref uniform, or `-1` if the uniform is not active
+ */
+int ProgramReflection::uniformKey(const char* name) const {
+    return find(_uniformIndex, name);
+}
+
+/**
+ * Returns all the active uniforms, sorted by the hashes of their names.
+ *
+ * @return Reference to the active uniforms
+ */
+const vector<Uniform>& ProgramReflection::uniforms() const {
+    return _uniforms;
+}
+
+} /* namespace Gloop */
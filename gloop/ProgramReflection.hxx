@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_PROGRAMREFLECTION_HXX
+#define GLOOP_PROGRAMREFLECTION_HXX
+#include "gloop/common.h"
+#include <string>
+#include <vector>
+#include "gloop/Attribute.hxx"
+#include "gloop/Uniform.hxx"
+namespace Gloop {
+
+
+/**
+ * Active attributes and uniforms of a linked shader program.
+ *
+ * A _ProgramReflection_ asks OpenGL about the program's variables once, when
+ * it is constructed, and keeps them in contiguous arrays sorted by a hash of
+ * their names.  A small open-addressed table over those hashes finds a
+ * variable by name without allocating memory or calling OpenGL.
+ *
+ * ~~~
+ *     const ProgramReflection& reflection = program.reflect();
+ *     const Uniform* color = reflection.findUniform("Color");
+ *     if (color != NULL) {
+ *         color->load4f(1.0f, 0.0f, 0.0f, 1.0f);
+ *     }
+ * ~~~
+ *
+ * When the same variable is looked up every frame, its _key_ can be looked up
+ * once instead, and passed to @ref uniform or @ref attribute afterwards, which
+ * just index the arrays.  Keys are only valid for the reflection that returned
+ * them.
+ *
+ * A reflection describes the program as it was linked when it was made.
+ * @ref Program::link makes a new one and remembers it, so @ref Program::reflect
+ * always returns the one for the current link.
+ */
+class ProgramReflection {
+public:
+// Methods
+    ProgramReflection();
+    explicit ProgramReflection(GLuint program);
+    const Attribute& attribute(int key) const;
+    int attributeKey(const char* name) const;
+    const std::vector<Attribute>& attributes() const;
+    const Attribute* findAttribute(const char* name) const;
+    const Uniform* findUniform(const char* name) const;
+    static GLuint hash(const char* name);
+    GLuint program() const;
+    const Uniform& uniform(int key) const;
+    int uniformKey(const char* name) const;
+    const std::vector<Uniform>& uniforms() const;
+private:
+// Types
+    struct Index {
+        std::vector<GLuint> hashes;
+        std::vector<std::string> names;
+        std::vector<int> slots;
+    };
+// Attributes
+    GLuint _program;
+    std::vector<Attribute> _attributes;
+    Index _attributeIndex;
+    std::vector<Uniform> _uniforms;
+    Index _uniformIndex;
+// Methods
+    static std::vector<int> buildIndex(Index& index, const std::vector<std::string>& names);
+    static int find(const Index& index, const char* name);
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <sstream>
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/Program.hxx"
+#include "gloop/ProgramReflection.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for `ProgramReflection`.
+ */
+class ProgramReflectionTest {
+public:
+
+    /**
+     * Makes and links a program with the given shaders.
+     */
+    static Program createProgram(const string& vertexShader, const string& fragmentShader) {
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(vertexShader);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(fragmentShader);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.link();
+        if (!program.linked()) {
+            throw runtime_error(program.log());
+        }
+        return program;
+    }
+
+    /**
+     * Makes and links a program with many uniforms.
+     */
+    static Program createProgramWithManyUniforms(const int count) {
+
+        // Make vertex shader that uses each uniform
+        stringstream vs;
+        vs << "#version 140\n";
+        for (int i = 0; i < count; ++i) {
+            vs << "uniform float U" << i << ";\n";
+        }
+        vs << "in vec4 MCVertex;\n";
+        vs << "void main() {\n";
+        vs << "    float sum = 0;\n";
+        for (int i = 0; i < count; ++i) {
+            vs << "    sum += U" << i << ";\n";
+        }
+        vs << "    gl_Position = MCVertex * sum;\n";
+        vs << "}\n";
+
+        // Make fragment shader
+        const string fs =
+                "#version 140\n"
+                "out vec4 FragColor;\n"
+                "void main() {\n"
+                "    FragColor = vec4(1);\n"
+                "}\n";
+
+        return createProgram(vs.str(), fs);
+    }
+
+    /**
+     * Ensures `ProgramReflection::findAttribute` finds an active attribute.
+     */
+    void testFindAttribute() {
+        const Program program = createProgramWithManyUniforms(1);
+        const ProgramReflection reflection = program.reflect();
+        const Attribute* attribute = reflection.findAttribute("MCVertex");
+        CPPUNIT_ASSERT(attribute != NULL);
+        CPPUNIT_ASSERT_EQUAL(string("MCVertex"), attribute->name());
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_FLOAT_VEC4, attribute->type());
+        CPPUNIT_ASSERT_EQUAL(glGetAttribLocation(program.id(), "MCVertex"), attribute->location());
+        CPPUNIT_ASSERT(reflection.findAttribute("Color") == NULL);
+    }
+
+    /**
+     * Ensures `ProgramReflection::findUniform` finds every uniform of a program with many uniforms.
+     */
+    void testFindUniformWithManyUniforms() {
+
+        // Make program and reflect it
+        const Program program = createProgramWithManyUniforms(128);
+        const ProgramReflection reflection = program.reflect();
+        CPPUNIT_ASSERT_EQUAL((size_t) 128, reflection.uniforms().size());
+
+        // Check each uniform is found with the right location
+        for (int i = 0; i < 128; ++i) {
+            stringstream ss;
+            ss << "U" << i;
+            const Uniform* uniform = reflection.findUniform(ss.str().c_str());
+            CPPUNIT_ASSERT(uniform != NULL);
+            CPPUNIT_ASSERT_EQUAL(ss.str(), uniform->name());
+            CPPUNIT_ASSERT_EQUAL((GLenum) GL_FLOAT, uniform->type());
+            CPPUNIT_ASSERT_EQUAL(program.id(), uniform->program());
+            CPPUNIT_ASSERT_EQUAL(glGetUniformLocation(program.id(), ss.str().c_str()), uniform->location());
+        }
+
+        // Check inactive names are not found
+        CPPUNIT_ASSERT(reflection.findUniform("U128") == NULL);
+        CPPUNIT_ASSERT(reflection.findUniform("") == NULL);
+    }
+
+    /**
+     * Ensures a reflection of a program without variables finds nothing.
+     */
+    void testFindUniformWithNoUniforms() {
+        const ProgramReflection reflection;
+        CPPUNIT_ASSERT(reflection.findUniform("Color") == NULL);
+        CPPUNIT_ASSERT_EQUAL(-1, reflection.uniformKey("Color"));
+        CPPUNIT_ASSERT(reflection.uniforms().empty());
+    }
+
+    /**
+     * Ensures the variables of a reflection are sorted by the hashes of their names.
+     */
+    void testUniformsAreSortedByHash() {
+        const Program program = createProgramWithManyUniforms(32);
+        const ProgramReflection reflection = program.reflect();
+        const vector<Uniform>& uniforms = reflection.uniforms();
+        for (size_t i = 1; i < uniforms.size(); ++i) {
+            const GLuint previous = ProgramReflection::hash(uniforms[i - 1].name().c_str());
+            const GLuint current = ProgramReflection::hash(uniforms[i].name().c_str());
+            CPPUNIT_ASSERT(previous <= current);
+        }
+    }
+
+    /**
+     * Ensures `Program::reflect` returns the reflection made when the program was linked.
+     */
+    void testReflectIsRemembered() {
+
+        // Check the same reflection is returned each time
+        const Program program = createProgramWithManyUniforms(4);
+        const ProgramReflection* reflection = &program.reflect();
+        CPPUNIT_ASSERT_EQUAL(reflection, &program.reflect());
+        CPPUNIT_ASSERT_EQUAL((size_t) 4, reflection->uniforms().size());
+
+        // Check linking again makes a new one
+        program.link();
+        CPPUNIT_ASSERT_EQUAL((size_t) 4, program.reflect().uniforms().size());
+        CPPUNIT_ASSERT_EQUAL(program.id(), program.reflect().program());
+    }
+
+    /**
+     * Ensures `ProgramReflection::uniformKey` returns a key for `ProgramReflection::uniform`.
+     */
+    void testUniformKey() {
+
+        // Look up key
+        const Program program = createProgramWithManyUniforms(8);
+        const ProgramReflection reflection = program.reflect();
+        const int key = reflection.uniformKey("U5");
+        CPPUNIT_ASSERT(key >= 0);
+
+        // Check uniform
+        CPPUNIT_ASSERT_EQUAL(string("U5"), reflection.uniform(key).name());
+        CPPUNIT_ASSERT_EQUAL(reflection.findUniform("U5"), &reflection.uniform(key));
+
+        // Check invalid keys
+        if (GLOOP_CHECKS) {
+            CPPUNIT_ASSERT_THROW(reflection.uniform(-1), out_of_range);
+            CPPUNIT_ASSERT_THROW(reflection.uniform(8), out_of_range);
+        }
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    ProgramReflectionTest test;
+    try {
+        test.testFindAttribute();
+        test.testFindUniformWithManyUniforms();
+        test.testFindUniformWithNoUniforms();
+        test.testReflectIsRemembered();
+        test.testUniformsAreSortedByHash();
+        test.testUniformKey();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
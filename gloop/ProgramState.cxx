@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/ProgramState.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs state for a program nothing is known about yet.
+ */
+ProgramState::ProgramState() :
+        _linked(false),
+        _linkedKnown(false),
+        _reflectionKnown(false),
+        _shadersKnown(false),
+        _valid(false),
+        _validKnown(false) {
+    // empty
+}
+
+/**
+ * Records that a shader was attached to the program.
+ *
+ * @param shader ID of the shader that was attached
+ */
+void ProgramState::attach(const GLuint shader) {
+    if (_shadersKnown) {
+        _shaders.insert(shader);
+    }
+}
+
+/**
+ * Records that a shader was detached from the program.
+ *
+ * @param shader ID of the shader that was detached
+ */
+void ProgramState::detach(const GLuint shader) {
+    _shaders.erase(shader);
+}
+
+/**
+ * Looks up whether a shader is attached to the program.
+ *
+ * @param shader ID of the shader to look for
+ * @param attached Set to whether the shader is attached, if known
+ * @return `true` if the shaders attached to the program are known
+ */
+bool ProgramState::findAttached(const GLuint shader, bool& attached) const {
+    if (!_shadersKnown) {
+        return false;
+    }
+    attached = (_shaders.find(shader) != _shaders.end());
+    return true;
+}
+
+/**
+ * Looks up the remembered location of an attribute.
+ *
+ * @param name Name of the attribute
+ * @param location Set to the remembered location, if known
+ * @return `true` if the location is known
+ */
+bool ProgramState::findAttribLocation(const string& name, GLint& location) const {
+    const map<string,GLint>::const_iterator it = _attribLocations.find(name);
+    if (it == _attribLocations.end()) {
+        return false;
+    }
+    location = it->second;
+    return true;
+}
+
+/**
+ * Looks up the remembered link status of the program.
+ *
+ * @param linked Set to the remembered link status, if known
+ * @return `true` if the link status is known
+ */
+bool ProgramState::findLinked(bool& linked) const {
+    if (!_linkedKnown) {
+        return false;
+    }
+    linked = _linked;
+    return true;
+}
+
+/**
+ * Looks up the remembered location of a uniform.
+ *
+ * @param name Name of the uniform
+ * @param location Set to the remembered location, if known
+ * @return `true` if the location is known
+ */
+bool ProgramState::findUniformLocation(const string& name, GLint& location) const {
+    const map<string,GLint>::const_iterator it = _uniformLocations.find(name);
+    if (it == _uniformLocations.end()) {
+        return false;
+    }
+    location = it->second;
+    return true;
+}
+
+/**
+ * Looks up the remembered validation status of the program.
+ *
+ * @param valid Set to the remembered validation status, if known
+ * @return `true` if the validation status is known
+ */
+bool ProgramState::findValid(bool& valid) const {
+    if (!_validKnown) {
+        return false;
+    }
+    valid = _valid;
+    return true;
+}
+
+/**
+ * Finds the reflection of the program's active variables.
+ *
+ * @return Pointer to the remembered reflection, or `NULL` if not known
+ */
+const ProgramReflection* ProgramState::findReflection() const {
+    return _reflectionKnown ? &_reflection : NULL;
+}
+
+/**
+ * Forgets everything that linking the program again can change.
+ */
+void ProgramState::forgetLink() {
+    _linkedKnown = false;
+    _reflection = ProgramReflection();
+    _reflectionKnown = false;
+    _validKnown = false;
+    _attribLocations.clear();
+    _uniformLocations.clear();
+}
+
+/**
+ * Forgets the validation status of the program.
+ */
+void ProgramState::forgetValid() {
+    _validKnown = false;
+}
+
+/**
+ * Remembers the location of an attribute.
+ *
+ * @param name Name of the attribute
+ * @param location Location of the attribute, or `-1` if it is not active
+ */
+void ProgramState::storeAttribLocation(const string& name, const GLint location) {
+    _attribLocations[name] = location;
+}
+
+/**
+ * Remembers the link status of the program.
+ *
+ * @param linked `true` if the program is linked
+ */
+void ProgramState::storeLinked(const bool linked) {
+    _linked = linked;
+    _linkedKnown = true;
+}
+
+/**
+ * Remembers the reflection of the program's active variables.
+ *
+ * @param reflection Reflection made after the program was last linked
+ */
+void ProgramState::storeReflection(const ProgramReflection& reflection) {
+    _reflection = reflection;
+    _reflectionKnown = true;
+}
+
+/**
+ * Remembers all the shaders attached to the program.
+ *
+ * @param shaders IDs of the attached shaders
+ */
+void ProgramState::storeShaders(const vector<GLuint>& shaders) {
+    _shaders.clear();
+    _shaders.insert(shaders.begin(), shaders.end());
+    _shadersKnown = true;
+}
+
+/**
+ * Remembers the location of a uniform.
+ *
+ * @param name Name of the uniform
+ * @param location Location of the uniform, or `-1` if it is not active
+ */
+void ProgramState::storeUniformLocation(const string& name, const GLint location) {
+    _uniformLocations[name] = location;
+}
+
+/**
+ * Remembers the validation status of the program.
+ *
+ * @param valid `true` if the program is valid
+ */
+void ProgramState::storeValid(const bool valid) {
+    _valid = valid;
+    _validKnown = true;
+}
+
+} /* namespace Gloop */
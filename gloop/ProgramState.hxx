@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_PROGRAMSTATE_HXX
+#define GLOOP_PROGRAMSTATE_HXX
+#include "gloop/common.h"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "gloop/ProgramReflection.hxx"
+namespace Gloop {
+
+
+/**
+ * What Gloop knows about one shader program.
+ *
+ * @ref Program answers `linked`, `valid`, `attribLocation`, `uniformLocation`
+ * and whether a shader is attached from here, so setting up a program does not
+ * keep asking OpenGL the same questions.  Each piece is only known once it has
+ * been queried or changed through Gloop.  Linking forgets the link status, the
+ * validation status, the locations and the reflection, since all of them can
+ * change.
+ *
+ * Each @ref Context keeps one _ProgramState_ for each program it has seen.
+ * See @ref Context::programState.
+ */
+class ProgramState {
+public:
+// Methods
+    ProgramState();
+    void attach(GLuint shader);
+    void detach(GLuint shader);
+    bool findAttached(GLuint shader, bool& attached) const;
+    bool findAttribLocation(const std::string& name, GLint& location) const;
+    bool findLinked(bool& linked) const;
+    const ProgramReflection* findReflection() const;
+    bool findUniformLocation(const std::string& name, GLint& location) const;
+    bool findValid(bool& valid) const;
+    void forgetLink();
+    void forgetValid();
+    void storeAttribLocation(const std::string& name, GLint location);
+    void storeLinked(bool linked);
+    void storeReflection(const ProgramReflection& reflection);
+    void storeShaders(const std::vector<GLuint>& shaders);
+    void storeUniformLocation(const std::string& name, GLint location);
+    void storeValid(bool valid);
+private:
+// Attributes
+    std::map<std::string,GLint> _attribLocations;
+    bool _linked;
+    bool _linkedKnown;
+    ProgramReflection _reflection;
+    bool _reflectionKnown;
+    std::set<GLuint> _shaders;
+    bool _shadersKnown;
+    std::map<std::string,GLint> _uniformLocations;
+    bool _valid;
+    bool _validKnown;
+};
+
+} /* namespace Gloop */
+#endif
@@ -72,6 +72,23 @@ const char* GOOD_FRAGMENT_SHADER =
 class ProgramTest {
 public:
 
+    /**
+     * Makes a program from the good shaders and links it.
+     */
+    static Program createLinkedProgram() {
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(GOOD_VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(GOOD_FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.link();
+        return program;
+    }
+
     /**
      * Ensures the active attributes are returned correctly.
      */
@@ -274,17 +291,60 @@ public:
         // Use the program
         program.use();
         CPPUNIT_ASSERT_EQUAL(program.id(), Program::current().id());
-        glUseProgram(0);
+        Program::unuse();
     }
 
     /**
      * Ensures `Program::current` throws when there is no current program.
      */
     void testCurrentWhenNoCurrentProgram() {
-        glUseProgram(0);
+        Program::unuse();
         CPPUNIT_ASSERT_THROW(Program::current(), std::runtime_error);
     }
 
+    /**
+     * Ensures a shader can be attached again after it was detached.
+     */
+    void testAttachShaderAfterDetach() {
+        const Program program = Program::create();
+        const Shader shader = Shader::create(GL_VERTEX_SHADER);
+        program.attachShader(shader);
+        program.detachShader(shader);
+        program.attachShader(shader);
+        GLint attached;
+        glGetProgramiv(program.id(), GL_ATTACHED_SHADERS, &attached);
+        CPPUNIT_ASSERT_EQUAL((GLint) 1, attached);
+        CPPUNIT_ASSERT_THROW(program.attachShader(shader), logic_error);
+    }
+
+    /**
+     * Ensures the location of an attribute is looked up again after linking again.
+     */
+    void testAttribLocationAfterRelink() {
+
+        // Make the program
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(GOOD_VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(GOOD_FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+
+        // Link with one location
+        program.attribLocation("MCVertex", 3);
+        program.link();
+        CPPUNIT_ASSERT_EQUAL((GLint) 3, program.attribLocation("MCVertex"));
+
+        // Link with another location
+        program.attribLocation("MCVertex", 5);
+        program.link();
+        CPPUNIT_ASSERT_EQUAL((GLint) 5, program.attribLocation("MCVertex"));
+        program.dispose();
+    }
+
     /**
      * Ensures detaching an attached shader works correctly.
      */
@@ -513,6 +573,76 @@ public:
         CPPUNIT_ASSERT(loc >= 0);
     }
 
+    /**
+     * Ensures `Program::linked` uses the remembered status, but checks it when verifying.
+     */
+    void testLinkedWhenVerifying() {
+
+        // Link a program, then break it behind Gloop's back
+        const Program program = createLinkedProgram();
+        CPPUNIT_ASSERT(program.linked());
+        const vector<Shader> shaders = program.shaders();
+        for (size_t i = 0; i < shaders.size(); ++i) {
+            glDetachShader(program.id(), shaders[i].id());
+        }
+        glLinkProgram(program.id());
+
+        // Check remembered status is used normally, but caught when verifying
+        Context& context = Context::current();
+        CPPUNIT_ASSERT(program.linked());
+        context.verifying(true);
+        CPPUNIT_ASSERT_THROW(program.linked(), logic_error);
+        context.verifying(false);
+
+        // Check it is asked for again after invalidating the context
+        context.invalidate();
+        CPPUNIT_ASSERT(!program.linked());
+        program.dispose();
+    }
+
+    /**
+     * Ensures no program is current after calling `Program::unuse`.
+     */
+    void testUnuse() {
+
+        // Use a program
+        const Program program = createLinkedProgram();
+        program.use();
+
+        // Stop using it
+        Program::unuse();
+        GLint id;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &id);
+        CPPUNIT_ASSERT_EQUAL(0, id);
+        CPPUNIT_ASSERT_THROW(Program::current(), std::runtime_error);
+        program.dispose();
+    }
+
+    /**
+     * Ensures using a program that is already current does not call OpenGL again.
+     */
+    void testUseWhenAlreadyCurrent() {
+
+        // Use a program, then stop using it behind Gloop's back
+        const Program program = createLinkedProgram();
+        program.use();
+        glUseProgram(0);
+
+        // Check using it again is skipped
+        program.use();
+        GLint id;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &id);
+        CPPUNIT_ASSERT_EQUAL(0, id);
+
+        // Check it is used after invalidating the context
+        Context::current().invalidate();
+        program.use();
+        glGetIntegerv(GL_CURRENT_PROGRAM, &id);
+        CPPUNIT_ASSERT_EQUAL((GLint) program.id(), id);
+        Program::unuse();
+        program.dispose();
+    }
+
     /**
      * Ensures fromId does not throw an exception with a good ID.
      */
@@ -554,12 +684,14 @@ int main(int argc, char *argv[]) {
         test.testAttachShaderWithGoodAttachedShader();
         test.testCurrentWhenCurrentProgram();
         test.testCurrentWhenNoCurrentProgram();
+        test.testAttachShaderAfterDetach();
         test.testDetachShaderWithAttachedShader();
         test.testDetachShaderWithUnattachedShader();
         test.testLinkWithGoodVertexAndFragmentShader();
         test.testLinkWithBadVertexAndFragmentShader();
         test.testAttribLocationWithBadName();
         test.testAttribLocationWithGoodName();
+        test.testAttribLocationAfterRelink();
         test.testActiveAttributes();
         test.testFragDataLocationWithBadName();
         test.testFragDataLocationWithGoodName();
@@ -568,6 +700,9 @@ int main(int argc, char *argv[]) {
         test.testActiveUniforms();
         test.testFromIdWithGoodId();
         test.testFromIdWithBadId();
+        test.testLinkedWhenVerifying();
+        test.testUnuse();
+        test.testUseWhenAlreadyCurrent();
     } catch (exception& e) {
         cerr << e.what() << endl;
         throw;
@@ -54,6 +54,30 @@ RenderbufferObject::RenderbufferObject(const RenderbufferObject& renderbuffer) :
  */
 void RenderbufferObject::dispose() const {
     glDeleteRenderbuffers(1, &_id);
+    Context::current().forgetRenderbuffer(_id);
+}
+
+/**
+ * Records this renderbuffer to be deleted later with others, instead of right away.
+ *
+ * @param queue Queue to record the renderbuffer in
+ * @see DeletionQueue::flush
+ */
+void RenderbufferObject::dispose(DeletionQueue& queue) const {
+    queue.enqueue(GL_RENDERBUFFER, _id);
+}
+
+/**
+ * Gives the name of this renderbuffer back to a pool instead of deleting it.
+ *
+ * The renderbuffer keeps its OpenGL state, so it can be taken from the pool
+ * again with @ref generate(NamePool&) and set up from scratch.
+ *
+ * @param pool Pool of GL_RENDERBUFFER names to give the name to
+ * @throws std::invalid_argument if the pool is not for renderbuffers
+ */
+void RenderbufferObject::dispose(NamePool& pool) const {
+    pool.release(GL_RENDERBUFFER, _id);
 }
 
 /**
@@ -90,6 +114,41 @@ RenderbufferObject RenderbufferObject::generate() {
     return RenderbufferObject(id);
 }
 
+/**
+ * Creates handles for several new renderbuffers at once.
+ *
+ * @param n Number of renderbuffers to generate
+ * @return Handles for the new renderbuffers
+ * @throws std::invalid_argument if number is negative
+ * @throws std::runtime_error if the renderbuffers could not be generated
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGenRenderbuffers.xml
+ */
+std::vector<RenderbufferObject> RenderbufferObject::generate(const GLsizei n) {
+
+    // Generate all the IDs in one call
+    const std::vector<GLuint> ids = NamePool::generate(GL_RENDERBUFFER, n);
+
+    // Make handles
+    std::vector<RenderbufferObject> rbos;
+    rbos.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        rbos.push_back(RenderbufferObject(ids[i]));
+    }
+    return rbos;
+}
+
+/**
+ * Creates a handle for a renderbuffer taken from a pool.
+ *
+ * @param pool Pool of GL_RENDERBUFFER names to take the name from
+ * @return Handle for the renderbuffer, which may have been used before
+ * @throws std::invalid_argument if the pool is not for renderbuffers
+ * @throws std::runtime_error if the pool could not generate more names
+ */
+RenderbufferObject RenderbufferObject::generate(NamePool& pool) {
+    return RenderbufferObject(pool.take(GL_RENDERBUFFER));
+}
+
 /**
  * Returns the raw OpenGL identifier of this renderbuffer.
  *
@@ -26,6 +26,10 @@
 #ifndef GLOOP_RENDERBUFFER_OBJECT_HXX
 #define GLOOP_RENDERBUFFER_OBJECT_HXX
 #include "gloop/common.h"
+#include <vector>
+#include "gloop/Context.hxx"
+#include "gloop/DeletionQueue.hxx"
+#include "gloop/NamePool.hxx"
 namespace Gloop {
 
 
@@ -37,8 +41,12 @@ public:
 // Methods
     RenderbufferObject(const RenderbufferObject& renderbuffer);
     void dispose() const;
+    void dispose(DeletionQueue& queue) const;
+    void dispose(NamePool& pool) const;
     static RenderbufferObject fromId(GLuint id);
     static RenderbufferObject generate();
+    static std::vector<RenderbufferObject> generate(GLsizei n);
+    static RenderbufferObject generate(NamePool& pool);
     GLuint id() const;
     bool operator!=(const RenderbufferObject& renderbuffer) const;
     bool operator<(const RenderbufferObject& renderbuffer) const;
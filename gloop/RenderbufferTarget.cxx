@@ -24,7 +24,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "config.h"
-#include <cassert>
+#include <stdexcept>
 #include "gloop/RenderbufferTarget.hxx"
 namespace Gloop {
 
@@ -39,11 +39,13 @@ RenderbufferTarget::RenderbufferTarget() {
  * Returns the size of the current renderbuffer's alpha channel.
  *
  * @return Size of the current renderbuffer's alpha channel
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::alphaSize() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_ALPHA_SIZE);
 }
 
@@ -54,7 +56,25 @@ GLsizei RenderbufferTarget::alphaSize() const {
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindRenderbuffer.xml
  */
 void RenderbufferTarget::bind(const RenderbufferObject& renderbuffer) const {
-    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer.id());
+    bind(renderbuffer.id());
+}
+
+/**
+ * Binds a renderbuffer to the target, unless it is already bound.
+ *
+ * @param renderbuffer ID of renderbuffer to bind, or `0` to unbind
+ */
+void RenderbufferTarget::bind(const GLuint renderbuffer) const {
+
+    // Check if already bound
+    Context& context = Context::current();
+    if (context.integer(GL_RENDERBUFFER_BINDING) == (GLint) renderbuffer) {
+        return;
+    }
+
+    // Bind and remember it
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    context.integer(GL_RENDERBUFFER_BINDING, renderbuffer);
 }
 
 /**
@@ -64,20 +84,20 @@ void RenderbufferTarget::bind(const RenderbufferObject& renderbuffer) const {
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindRenderbuffer.xml
  */
 GLuint RenderbufferTarget::binding() const {
-    GLuint id;
-    glGetIntegerv(GL_RENDERBUFFER_BINDING, (GLint*) &id);
-    return id;
+    return Context::current().integer(GL_RENDERBUFFER_BINDING);
 }
 
 /**
  * Returns the size of the current renderbuffer's blue channel.
  *
  * @return Size of the current renderbuffer's blue channel
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::blueSize() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_BLUE_SIZE);
 }
 
@@ -96,11 +116,13 @@ bool RenderbufferTarget::bound(const RenderbufferObject& renderbuffer) const {
  * Returns the size of the current renderbuffer's depth channel.
  *
  * @return Size of the current renderbuffer's depth channel
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::depthSize() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_DEPTH_SIZE);
 }
 
@@ -111,9 +133,7 @@ GLsizei RenderbufferTarget::depthSize() const {
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGet.xml
  */
 GLsizei RenderbufferTarget::getMaxRenderbufferSize() {
-    GLint value;
-    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &value);
-    return (GLsizei) value;
+    return Context::current().capabilities().maxRenderbufferSize();
 }
 
 /**
@@ -133,11 +153,13 @@ GLint RenderbufferTarget::getParameter(const GLenum name) {
  * Returns the size of the current renderbuffer's green channel.
  *
  * @return Size of the current renderbuffer's green channel
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::greenSize() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_GREEN_SIZE);
 }
 
@@ -145,11 +167,13 @@ GLsizei RenderbufferTarget::greenSize() const {
  * Returns the height of the current renderbuffer.
  *
  * @return Height of the current renderbuffer
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::height() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_HEIGHT);
 }
 
@@ -157,11 +181,13 @@ GLsizei RenderbufferTarget::height() const {
  * Returns the internal format of the current renderbuffer.
  *
  * @return Internal format of the current renderbuffer
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLenum RenderbufferTarget::internalFormat() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLenum) getParameter(GL_RENDERBUFFER_INTERNAL_FORMAT);
 }
 
@@ -169,11 +195,13 @@ GLenum RenderbufferTarget::internalFormat() const {
  * Returns the size of the current renderbuffer's red channel.
  *
  * @return Size of the current renderbuffer's red channel
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::redSize() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_RED_SIZE);
 }
 
@@ -181,11 +209,13 @@ GLsizei RenderbufferTarget::redSize() const {
  * Returns the size of the current renderbuffer's stencil channel.
  *
  * @return Size of the current renderbuffer's stencil channel
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::stencilSize() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_STENCIL_SIZE);
 }
 
@@ -195,16 +225,22 @@ GLsizei RenderbufferTarget::stencilSize() const {
  * @param internalFormat Data type and size of image
  * @param width Width of image
  * @param height Height of image
- * @pre A renderbuffer is currently bound to the renderbuffer target
  * @pre Internal format is color-renderable, depth-renderable, or stencil-renderable
- * @pre Width and height are less than the value of `GL_MAX_RENDERBUFFER_SIZE`
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
+ * @throws std::invalid_argument if checking and width or height is greater than `GL_MAX_RENDERBUFFER_SIZE`
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glRenderbufferStorage.xml
  */
 void RenderbufferTarget::storage(const GLenum internalFormat, const GLsizei width, const GLsizei height) const {
-    assert (binding() != 0);
-    assert (width <= getMaxRenderbufferSize());
-    assert (height <= getMaxRenderbufferSize());
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
+    if (GLOOP_CHECKS && ((width > getMaxRenderbufferSize()) || (height > getMaxRenderbufferSize()))) {
+        throw std::invalid_argument("[RenderbufferTarget] Width or height is greater than GL_MAX_RENDERBUFFER_SIZE!");
+    }
     glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width, height);
+
+    // Framebuffers it is attached to may have changed
+    Context::current().touchFramebuffers(GL_RENDERBUFFER, binding());
 }
 
 /**
@@ -213,18 +249,20 @@ void RenderbufferTarget::storage(const GLenum internalFormat, const GLsizei widt
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindRenderbuffer.xml
  */
 void RenderbufferTarget::unbind() const {
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    bind(0);
 }
 
 /**
  * Returns the width of the current renderbuffer.
  *
  * @return Width of the current renderbuffer
- * @pre A renderbuffer is currently bound to the renderbuffer target
+ * @throws std::logic_error if checking and no renderbuffer is bound to the renderbuffer target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetRenderbufferParameter.xml
  */
 GLsizei RenderbufferTarget::width() const {
-    assert (binding() != 0);
+    if (GLOOP_CHECKS && (binding() == 0)) {
+        throw std::logic_error("[RenderbufferTarget] No renderbuffer bound to target!");
+    }
     return (GLsizei) getParameter(GL_RENDERBUFFER_WIDTH);
 }
 
@@ -26,6 +26,7 @@
 #ifndef GLOOP_RENDERBUFFER_TARGET_HXX
 #define GLOOP_RENDERBUFFER_TARGET_HXX
 #include "gloop/common.h"
+#include "gloop/Context.hxx"
 #include "gloop/RenderbufferObject.hxx"
 namespace Gloop {
 
@@ -53,6 +54,7 @@ public:
     GLsizei width() const;
 private:
 // Methods
+    void bind(GLuint renderbuffer) const;
     static GLint getParameter(GLenum name);
     static GLsizei getMaxRenderbufferSize();
 };
@@ -83,7 +83,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(renderbuffer.id(), id);
 
         // Unbind
-        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        target.unbind();
     }
 
     /**
@@ -104,7 +104,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(renderbuffer.id(), target.binding());
 
         // Unbind
-        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        target.unbind();
     }
 
     /**
@@ -147,7 +147,7 @@ public:
         CPPUNIT_ASSERT(target.bound(renderbuffer));
 
         // Unbind
-        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        target.unbind();
     }
 
     /**
@@ -281,6 +281,13 @@ public:
         target.unbind();
     }
 
+    /**
+     * Ensures `RenderbufferTarget::storage` throws an exception if no renderbuffer is bound.
+     */
+    void testStorageWithoutBinding() {
+        CPPUNIT_ASSERT_THROW(target.storage(GL_RGBA8, 2, 4), std::logic_error);
+    }
+
     /**
      * Ensures `RenderbufferTarget::unbind` works correctly.
      */
@@ -329,6 +336,9 @@ int main(int argc, char* argv[]) {
         test.testRedSize();
         test.testStencilSize();
         test.testStorage();
+        if (GLOOP_CHECKS) {
+            test.testStorageWithoutBinding();
+        }
         test.testUnbind();
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
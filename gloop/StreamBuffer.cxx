@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/StreamBuffer.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Creates a stream buffer, using persistent mapping if it is available.
+ *
+ * @param target Buffer target to bind the buffer object to when needed
+ * @param size Size of the whole buffer in bytes
+ * @param regions Number of regions to split the buffer into, usually 2 or 3
+ * @throws std::invalid_argument if size or number of regions is not positive
+ * @throws std::runtime_error if the buffer could not be mapped
+ */
+StreamBuffer::StreamBuffer(const BufferTarget& target, const GLsizeiptr size, const GLsizei regions) :
+        _buffer(BufferObject::generate()),
+        _head(0),
+        _mapped(NULL),
+        _persistent(Context::current().capabilities().hasBufferStorage()),
+        _region(0),
+        _regionSize(0),
+        _stalls(0),
+        _target(target) {
+    initialize(size, regions);
+}
+
+/**
+ * Creates a stream buffer, choosing whether to use persistent mapping.
+ *
+ * @param target Buffer target to bind the buffer object to when needed
+ * @param size Size of the whole buffer in bytes
+ * @param regions Number of regions to split the buffer into, usually 2 or 3
+ * @param persistent `true` to map persistently, `false` to map each allocation
+ * @throws std::invalid_argument if size or number of regions is not positive
+ * @throws std::runtime_error if persistent mapping is not supported, or the buffer could not be mapped
+ */
+StreamBuffer::StreamBuffer(const BufferTarget& target,
+                           const GLsizeiptr size,
+                           const GLsizei regions,
+                           const bool persistent) :
+        _buffer(BufferObject::generate()),
+        _head(0),
+        _mapped(NULL),
+        _persistent(persistent),
+        _region(0),
+        _regionSize(0),
+        _stalls(0),
+        _target(target) {
+    initialize(size, regions);
+}
+
+/**
+ * Finishes with the current region and moves on to the next one.
+ *
+ * Call this once per frame, after issuing the draw calls that use the current
+ * region.  Waits if OpenGL is still using the next region.
+ *
+ * @throws std::runtime_error if waiting for the next region fails
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glFenceSync.xml
+ */
+void StreamBuffer::advance() {
+
+    // Make sure nothing is left mapped
+    submit();
+
+    // Fence what OpenGL will read from this region
+    _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Move to the next region once OpenGL is done with it
+    _region = (_region + 1) % _fences.size();
+    _head = 0;
+    if (_fences[_region] != NULL) {
+        wait(_fences[_region]);
+        glDeleteSync(_fences[_region]);
+        _fences[_region] = NULL;
+    }
+}
+
+/**
+ * Reserves part of the current region for writing.
+ *
+ * @param size Number of bytes to reserve
+ * @param alignment Multiple the offset must be, e.g. the size of a vertex
+ * @param offset Set to the offset of the reserved bytes from the start of the buffer
+ * @return Pointer to write the reserved bytes to
+ * @throws std::invalid_argument if size or alignment is not positive
+ * @throws std::length_error if the current region does not have enough room left
+ * @throws std::runtime_error if the reserved bytes could not be mapped
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glMapBufferRange.xml
+ */
+GLvoid* StreamBuffer::allocate(const GLsizeiptr size, const GLsizeiptr alignment, GLintptr& offset) {
+
+    // Check arguments
+    if (size <= 0) {
+        throw invalid_argument("[StreamBuffer] Size is not positive!");
+    } else if (alignment <= 0) {
+        throw invalid_argument("[StreamBuffer] Alignment is not positive!");
+    }
+
+    // Find aligned space in the current region
+    const GLintptr start = _region * _regionSize;
+    const GLintptr aligned = ((start + _head + alignment - 1) / alignment) * alignment;
+    if (aligned + size > start + _regionSize) {
+        throw length_error("[StreamBuffer] Not enough room left in region!");
+    }
+    _head = (aligned + size) - start;
+    offset = aligned;
+
+    // Point into the persistent mapping
+    if (_persistent) {
+        return ((GLubyte*) _mapped) + aligned;
+    }
+
+    // Otherwise map just the reserved bytes, without waiting for OpenGL
+    submit();
+    if (!_target.bound(_buffer)) {
+        _target.bind(_buffer);
+    }
+    _mapped = glMapBufferRange(
+            _target.toEnum(),
+            aligned,
+            size,
+            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (_mapped == NULL) {
+        throw runtime_error("[StreamBuffer] Could not map buffer!");
+    }
+    return _mapped;
+}
+
+/**
+ * Returns the buffer object holding the stream.
+ *
+ * @return Handle to the buffer object
+ */
+BufferObject StreamBuffer::buffer() const {
+    return _buffer;
+}
+
+/**
+ * Deletes the fences and buffer object of this stream.
+ */
+void StreamBuffer::dispose() {
+
+    // Delete fences
+    for (size_t i = 0; i < _fences.size(); ++i) {
+        if (_fences[i] != NULL) {
+            glDeleteSync(_fences[i]);
+            _fences[i] = NULL;
+        }
+    }
+
+    // Delete buffer, which also unmaps it
+    _buffer.dispose();
+    _mapped = NULL;
+}
+
+/**
+ * Sets up the buffer object and its mapping.
+ *
+ * @param size Size of the whole buffer in bytes
+ * @param regions Number of regions to split the buffer into
+ */
+void StreamBuffer::initialize(const GLsizeiptr size, const GLsizei regions) {
+
+    // Check arguments
+    if ((size <= 0) || (regions <= 0) || (_persistent && !Context::current().capabilities().hasBufferStorage())) {
+        _buffer.dispose();
+        if (size <= 0) {
+            throw invalid_argument("[StreamBuffer] Size is not positive!");
+        } else if (regions <= 0) {
+            throw invalid_argument("[StreamBuffer] Number of regions is not positive!");
+        } else {
+            throw runtime_error("[StreamBuffer] Persistent mapping is not supported!");
+        }
+    }
+    _regionSize = size / regions;
+    _fences.assign(regions, NULL);
+
+    // Allocate storage
+    _target.bind(_buffer);
+    if (!_persistent) {
+        _target.data(size, NULL, GL_STREAM_DRAW);
+        return;
+    }
+
+    // Map it once for good
+#ifdef GL_MAP_PERSISTENT_BIT
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(_target.toEnum(), size, NULL, flags);
+    _mapped = glMapBufferRange(_target.toEnum(), 0, size, flags);
+    if (_mapped == NULL) {
+        _buffer.dispose();
+        throw runtime_error("[StreamBuffer] Could not map buffer!");
+    }
+#endif
+}
+
+/**
+ * Checks if the whole buffer is mapped persistently.
+ *
+ * @return `true` if allocations point into a persistent mapping
+ */
+bool StreamBuffer::persistent() const {
+    return _persistent;
+}
+
+/**
+ * Returns the index of the region allocations currently come from.
+ *
+ * @return Index of the current region
+ */
+GLsizei StreamBuffer::region() const {
+    return _region;
+}
+
+/**
+ * Returns the size of each region.
+ *
+ * @return Number of bytes that can be allocated from a region
+ */
+GLsizeiptr StreamBuffer::regionSize() const {
+    return _regionSize;
+}
+
+/**
+ * Returns how many times @ref advance had to wait for OpenGL to finish with a region.
+ *
+ * @return Number of times the CPU waited on a fence that was not signaled yet
+ */
+unsigned long StreamBuffer::stalls() const {
+    return _stalls;
+}
+
+/**
+ * Makes everything allocated so far ready to be used by OpenGL.
+ *
+ * Unmaps the last allocation when each one is mapped separately.  Does nothing
+ * with persistent, coherent mapping.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glMapBufferRange.xml
+ */
+void StreamBuffer::submit() {
+    if (_persistent || (_mapped == NULL)) {
+        return;
+    }
+    if (!_target.bound(_buffer)) {
+        _target.bind(_buffer);
+    }
+    glUnmapBuffer(_target.toEnum());
+    _mapped = NULL;
+}
+
+/**
+ * Waits until OpenGL passes a fence.
+ *
+ * @param fence Fence to wait for
+ * @throws std::runtime_error if waiting fails
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glClientWaitSync.xml
+ */
+void StreamBuffer::wait(const GLsync fence) {
+    const GLuint64 timeout = 1000000000;
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        ++_stalls;
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    if (result == GL_WAIT_FAILED) {
+        throw runtime_error("[StreamBuffer] Could not wait for fence!");
+    }
+}
+
+} /* namespace Gloop */
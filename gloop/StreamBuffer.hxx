@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_STREAMBUFFER_HXX
+#define GLOOP_STREAMBUFFER_HXX
+#include "gloop/common.h"
+#include <vector>
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+namespace Gloop {
+
+
+/**
+ * Buffer object for data rewritten every frame, such as particles or UI.
+ *
+ * A _StreamBuffer_ is split into equal _regions_, one for each frame that may
+ * still be in flight.  Each frame, @ref allocate hands out pieces of the
+ * current region that can be written directly, and @ref advance moves on to the
+ * next region.  A fence is placed after each region is used, and waited on
+ * before the region is used again, so OpenGL is never asked to synchronize
+ * implicitly.
+ *
+ * ~~~
+ *     StreamBuffer stream(BufferTarget::arrayBuffer(), 3 * 1024 * 1024, 3);
+ *     ...
+ *     GLintptr offset;
+ *     Vertex* vertices = (Vertex*) stream.allocate(count * sizeof(Vertex), sizeof(Vertex), offset);
+ *     ... write vertices ...
+ *     stream.submit();
+ *     ... draw from offset ...
+ *     stream.advance();
+ * ~~~
+ *
+ * When `glBufferStorage` is available, the whole buffer is mapped once with
+ * persistent, coherent mapping, and allocations point straight into it.
+ * Otherwise each allocation is mapped with `glMapBufferRange`, using
+ * `GL_MAP_UNSYNCHRONIZED_BIT` and `GL_MAP_INVALIDATE_RANGE_BIT`, and must be
+ * unmapped with @ref submit before drawing.  Calling @ref submit is harmless
+ * with persistent mapping, so code can be written the same way for both.
+ *
+ * Stream buffers cannot be copied, since each one owns its fences.  Call
+ * @ref dispose when finished with one.
+ */
+class StreamBuffer {
+public:
+// Methods
+    StreamBuffer(const BufferTarget& target, GLsizeiptr size, GLsizei regions);
+    StreamBuffer(const BufferTarget& target, GLsizeiptr size, GLsizei regions, bool persistent);
+    void advance();
+    GLvoid* allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr& offset);
+    BufferObject buffer() const;
+    void dispose();
+    bool persistent() const;
+    GLsizei region() const;
+    GLsizeiptr regionSize() const;
+    unsigned long stalls() const;
+    void submit();
+private:
+// Attributes
+    BufferObject _buffer;
+    std::vector<GLsync> _fences;
+    GLsizeiptr _head;
+    GLvoid* _mapped;
+    bool _persistent;
+    GLsizei _region;
+    GLsizeiptr _regionSize;
+    unsigned long _stalls;
+    BufferTarget _target;
+// Methods
+    StreamBuffer(const StreamBuffer& stream);
+    StreamBuffer& operator=(const StreamBuffer& stream);
+    void initialize(GLsizeiptr size, GLsizei regions);
+    void wait(GLsync fence);
+};
+
+} /* namespace Gloop */
+#endif
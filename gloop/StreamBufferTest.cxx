@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/StreamBuffer.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for `StreamBuffer`.
+ */
+class StreamBufferTest {
+public:
+
+    /**
+     * Reads a float back from the buffer object of a stream.
+     */
+    static GLfloat readFloat(const StreamBuffer& stream, const GLintptr offset) {
+        const BufferTarget target = BufferTarget::arrayBuffer();
+        target.bind(stream.buffer());
+        GLfloat value;
+        glGetBufferSubData(GL_ARRAY_BUFFER, offset, sizeof(value), &value);
+        return value;
+    }
+
+    /**
+     * Ensures allocations are aligned, written through, and limited to the current region.
+     */
+    void checkAllocate(const bool persistent) {
+
+        // Allocate and write
+        StreamBuffer stream(BufferTarget::arrayBuffer(), 3 * 256, 3, persistent);
+        CPPUNIT_ASSERT_EQUAL(persistent, stream.persistent());
+        GLintptr first, second;
+        GLfloat* p1 = (GLfloat*) stream.allocate(6, 4, first);
+        p1[0] = 1.5f;
+        GLfloat* p2 = (GLfloat*) stream.allocate(8, 8, second);
+        p2[0] = 2.5f;
+        p2[1] = 3.5f;
+        stream.submit();
+
+        // Check offsets and contents
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 0, first);
+        CPPUNIT_ASSERT_EQUAL((GLintptr) 8, second);
+        CPPUNIT_ASSERT_EQUAL(1.5f, readFloat(stream, first));
+        CPPUNIT_ASSERT_EQUAL(3.5f, readFloat(stream, second + 4));
+
+        // Check region cannot overflow
+        GLintptr offset;
+        CPPUNIT_ASSERT_THROW(stream.allocate(256, 4, offset), length_error);
+        stream.dispose();
+    }
+
+    /**
+     * Ensures `StreamBuffer::advance` cycles through the regions.
+     */
+    void checkAdvance(const bool persistent) {
+
+        // Use each region once, and the first one again
+        StreamBuffer stream(BufferTarget::arrayBuffer(), 3 * 256, 3, persistent);
+        GLintptr offset;
+        for (int i = 0; i < 4; ++i) {
+            CPPUNIT_ASSERT_EQUAL((GLsizei) (i % 3), stream.region());
+            GLfloat* p = (GLfloat*) stream.allocate(256, 4, offset);
+            CPPUNIT_ASSERT_EQUAL((GLintptr) ((i % 3) * 256), offset);
+            p[0] = (GLfloat) i;
+            stream.submit();
+            stream.advance();
+        }
+
+        // Check first region was rewritten
+        CPPUNIT_ASSERT_EQUAL(3.0f, readFloat(stream, 0));
+        CPPUNIT_ASSERT_EQUAL(1.0f, readFloat(stream, 256));
+        stream.dispose();
+    }
+
+    /**
+     * Ensures streaming works with a separate mapping for each allocation.
+     */
+    void testAllocateUnsynchronized() {
+        checkAllocate(false);
+        checkAdvance(false);
+    }
+
+    /**
+     * Ensures streaming works with persistent mapping, if it is supported.
+     */
+    void testAllocatePersistent() {
+        if (Context::current().capabilities().hasBufferStorage()) {
+            checkAllocate(true);
+            checkAdvance(true);
+        } else {
+            CPPUNIT_ASSERT_THROW(StreamBuffer(BufferTarget::arrayBuffer(), 256, 1, true), runtime_error);
+        }
+    }
+
+    /**
+     * Ensures bad sizes are rejected.
+     */
+    void testConstructorWithBadArguments() {
+        CPPUNIT_ASSERT_THROW(StreamBuffer(BufferTarget::arrayBuffer(), 0, 3), invalid_argument);
+        CPPUNIT_ASSERT_THROW(StreamBuffer(BufferTarget::arrayBuffer(), 256, 0), invalid_argument);
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    StreamBufferTest test;
+    try {
+        test.testAllocateUnsynchronized();
+        test.testAllocatePersistent();
+        test.testConstructorWithBadArguments();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -57,15 +57,46 @@ TextureObject::~TextureObject() {
 
 /**
  * Deletes the corresponding OpenGL texture object.
+ *
+ * Deleting a texture object unbinds it and discards its parameters, so the
+ * bindings and parameters remembered by the current context are forgotten.
  */
 void TextureObject::dispose() const {
     glDeleteTextures(1, &_id);
+    Context::current().forgetTexture(_id);
+}
+
+/**
+ * Records this texture object to be deleted later with others, instead of right away.
+ *
+ * @param queue Queue to record the texture object in
+ * @see DeletionQueue::flush
+ */
+void TextureObject::dispose(DeletionQueue& queue) const {
+    queue.enqueue(GL_TEXTURE, _id);
+}
+
+/**
+ * Gives the name of this texture object back to a pool instead of deleting it.
+ *
+ * The texture object keeps its OpenGL state, so it can be taken from the pool
+ * again with @ref generate(NamePool&) and set up from scratch.
+ *
+ * @param pool Pool of GL_TEXTURE names to give the name to
+ * @throws std::invalid_argument if the pool is not for texture objects
+ */
+void TextureObject::dispose(NamePool& pool) const {
+    pool.release(GL_TEXTURE, _id);
 }
 
 /**
  * Creates a texture object handle representing an existing OpenGL texture object.
  *
+ * The identifier is not checked with `glIsTexture`, so @ref TextureTarget::binding
+ * can make handles from remembered bindings without querying OpenGL.
+ *
  * @param id ID of the existing OpenGL texture object
+ * @pre Identifier is a number returned by `glGenTextures`
  */
 TextureObject TextureObject::fromId(const GLuint id) {
     return TextureObject(id);
@@ -92,6 +123,41 @@ TextureObject TextureObject::generate() {
     return TextureObject(id);
 }
 
+/**
+ * Creates handles for several new texture objects at once.
+ *
+ * @param n Number of texture objects to generate
+ * @return Handles for the new texture objects
+ * @throws std::invalid_argument if number is negative
+ * @throws std::runtime_error if the texture objects could not be generated
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGenTextures.xml
+ */
+vector<TextureObject> TextureObject::generate(const GLsizei n) {
+
+    // Generate all the IDs in one call
+    const vector<GLuint> ids = NamePool::generate(GL_TEXTURE, n);
+
+    // Make handles
+    vector<TextureObject> tos;
+    tos.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        tos.push_back(TextureObject(ids[i]));
+    }
+    return tos;
+}
+
+/**
+ * Creates a handle for a texture object taken from a pool.
+ *
+ * @param pool Pool of GL_TEXTURE names to take the name from
+ * @return Handle for the texture object, which may have been used before
+ * @throws std::invalid_argument if the pool is not for texture objects
+ * @throws std::runtime_error if the pool could not generate more names
+ */
+TextureObject TextureObject::generate(NamePool& pool) {
+    return TextureObject(pool.take(GL_TEXTURE));
+}
+
 
 /**
  * Returns the raw OpenGL identifier of this texture object handle.
@@ -26,6 +26,10 @@
 #ifndef GLOOP_TEXTUREOBJECT_HXX
 #define GLOOP_TEXTUREOBJECT_HXX
 #include "gloop/common.h"
+#include <vector>
+#include "gloop/Context.hxx"
+#include "gloop/DeletionQueue.hxx"
+#include "gloop/NamePool.hxx"
 namespace Gloop {
 
 
@@ -74,8 +78,9 @@ namespace Gloop {
  *
  * To get the raw OpenGL identifier of the texture object, use the @ref
  * TextureObject::id() method.  Since _TextureObject_ stores no state behind the
- * scenes, you can always pass the ID to any OpenGL function as normal without
- * worry.
+ * scenes, you can always pass the ID to any OpenGL function as normal.  Just
+ * remember that the current @ref Context keeps a copy of the texture object's
+ * parameters, so call @ref Context::invalidate after changing them directly.
  *
  * ~~~
  *     const GLuint id = to.id();
@@ -97,8 +102,12 @@ public:
     TextureObject(const TextureObject& textureObject);
     virtual ~TextureObject();
     void dispose() const;
+    void dispose(DeletionQueue& queue) const;
+    void dispose(NamePool& pool) const;
     static TextureObject fromId(GLuint id);
     static TextureObject generate();
+    static std::vector<TextureObject> generate(GLsizei n);
+    static TextureObject generate(NamePool& pool);
     GLuint id() const;
     bool operator!=(const TextureObject& textureObject) const;
     bool operator<(const TextureObject& textureObject) const;
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/TextureParameters.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs a parameter block that does not know any parameters yet.
+ */
+TextureParameters::TextureParameters() {
+    // empty
+}
+
+/**
+ * Looks up the remembered value of an integer parameter.
+ *
+ * @param name Name of the texture parameter, e.g. `GL_TEXTURE_MIN_FILTER`
+ * @param value Set to the remembered value if there is one
+ * @return `true` if the value of the parameter is known
+ */
+bool TextureParameters::find(const GLenum name, GLint& value) const {
+    const map<GLenum,GLint>::const_iterator it = _integers.find(name);
+    if (it == _integers.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+/**
+ * Looks up the remembered value of a floating-point parameter.
+ *
+ * @param name Name of the texture parameter, e.g. `GL_TEXTURE_LOD_BIAS`
+ * @param value Set to the remembered value if there is one
+ * @return `true` if the value of the parameter is known
+ */
+bool TextureParameters::find(const GLenum name, GLfloat& value) const {
+    const map<GLenum,GLfloat>::const_iterator it = _floats.find(name);
+    if (it == _floats.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+/**
+ * Remembers the value of an integer parameter.
+ *
+ * @param name Name of the texture parameter, e.g. `GL_TEXTURE_MIN_FILTER`
+ * @param value Value of the parameter in OpenGL
+ */
+void TextureParameters::store(const GLenum name, const GLint value) {
+    _integers[name] = value;
+}
+
+/**
+ * Remembers the value of a floating-point parameter.
+ *
+ * @param name Name of the texture parameter, e.g. `GL_TEXTURE_LOD_BIAS`
+ * @param value Value of the parameter in OpenGL
+ */
+void TextureParameters::store(const GLenum name, const GLfloat value) {
+    _floats[name] = value;
+}
+
+} /* namespace Gloop */
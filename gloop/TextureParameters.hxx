@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_TEXTUREPARAMETERS_HXX
+#define GLOOP_TEXTUREPARAMETERS_HXX
+#include "gloop/common.h"
+#include <map>
+namespace Gloop {
+
+
+/**
+ * Copy of the parameters of one texture object, as set through Gloop.
+ *
+ * @ref TextureTarget answers its getters from the parameters of the bound
+ * texture object, and skips calling `glTexParameter` when a setter is given the
+ * value the texture object already has.  A parameter is only known once it has
+ * been queried or changed, so each one is queried from OpenGL at most once.
+ *
+ * Each @ref Context keeps one _TextureParameters_ for each texture object it
+ * has seen.  See @ref Context::textureParameters.
+ */
+class TextureParameters {
+public:
+// Methods
+    TextureParameters();
+    bool find(GLenum name, GLint& value) const;
+    bool find(GLenum name, GLfloat& value) const;
+    void store(GLenum name, GLint value);
+    void store(GLenum name, GLfloat value);
+private:
+// Attributes
+    std::map<GLenum,GLfloat> _floats;
+    std::map<GLenum,GLint> _integers;
+};
+
+} /* namespace Gloop */
+#endif
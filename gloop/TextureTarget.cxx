@@ -112,25 +112,27 @@ void TextureTarget::baseLevel(const GLint baseLevel) const {
 }
 
 /**
- * Binds a texture object to the texture target.
+ * Binds a texture object to the texture target, unless it is already bound.
  *
  * @param textureObject Texture object to bind to this texture target
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindTexture.xml
  */
 void TextureTarget::bind(const TextureObject& textureObject) const {
-    glBindTexture(_id, textureObject.id());
+    Context& context = Context::current();
+    if (context.textureBinding(_key) != textureObject.id()) {
+        glBindTexture(_id, textureObject.id());
+        context.textureBinding(_key, textureObject.id());
+    }
 }
 
 /**
  * Determines the texture object bound to this texture target.
  *
  * @return Texture object bound to this texture target
- * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGet.xml
+ * @see Context::textureBinding(GLenum)
  */
 TextureObject TextureTarget::binding() const {
-    GLint id;
-    glGetIntegerv(_key, &id);
-    return TextureObject::fromId((GLuint) id);
+    return TextureObject::fromId(Context::current().textureBinding(_key));
 }
 
 /**
@@ -291,6 +293,7 @@ TextureTarget TextureTarget::fromEnum(const GLenum enumeration) {
 void TextureTarget::generateMipmap() const {
     assert (isAbleToGenerateMipmapFor(_id));
     glGenerateMipmap(_id);
+    touchFramebuffers();
 }
 
 /**
@@ -299,8 +302,7 @@ void TextureTarget::generateMipmap() const {
  * @return Absolute value of the texture level-of-detail bias
  */
 GLfloat TextureTarget::getMaxTextureLodBias() {
-    GLfloat value;
-    glGetFloatv(GL_MAX_TEXTURE_LOD_BIAS, &value);
+    const GLfloat value = Context::current().capabilities().maxTextureLodBias();
     assert (value >= 2.0f);
     return value;
 }
@@ -312,9 +314,7 @@ GLfloat TextureTarget::getMaxTextureLodBias() {
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGet.xml
  */
 GLsizei TextureTarget::getMaxTextureSize() {
-    GLint maxTextureSize;
-    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
-    return maxTextureSize;
+    return Context::current().capabilities().maxTextureSize();
 }
 
 /**
@@ -333,31 +333,73 @@ GLint TextureTarget::getTexLevelParameteri(const GLint level, const GLenum name)
 }
 
 /**
- * Retrieves the value of a texture parameter as an integer.
+ * Retrieves the value of a texture parameter as an integer, querying OpenGL only if it is not already known.
  *
  * @param name Name of the texture parameter
  * @return Value of the specified texture parameter as an integer
+ * @throws std::logic_error if verifying and the remembered value differs from the one in OpenGL
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetTexParameter.xml
  */
 GLint TextureTarget::getTexParameteri(const GLenum name) const {
+
+    // Use the remembered value if there is one
+    Context& context = Context::current();
+    TextureParameters& parameters = getTexParameters(context);
+    GLint remembered;
+    const bool known = parameters.find(name, remembered);
+    if (known && !context.verifying()) {
+        return remembered;
+    }
+
+    // Otherwise ask OpenGL
     GLint value;
     glGetTexParameteriv(_id, name, &value);
+    if (known && (remembered != value)) {
+        throw logic_error("[TextureTarget] Remembered parameter differs from OpenGL!");
+    }
+    parameters.store(name, value);
     return value;
 }
 
 /**
- * Retrieves the value of a texture parameter as a float.
+ * Retrieves the value of a texture parameter as a float, querying OpenGL only if it is not already known.
  *
  * @param name Name of the texture parameter
  * @return Value of the specified texture parameter as a float
+ * @throws std::logic_error if verifying and the remembered value differs from the one in OpenGL
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetTexParameter.xml
  */
 GLfloat TextureTarget::getTexParameterf(const GLenum name) const {
+
+    // Use the remembered value if there is one
+    Context& context = Context::current();
+    TextureParameters& parameters = getTexParameters(context);
+    GLfloat remembered;
+    const bool known = parameters.find(name, remembered);
+    if (known && !context.verifying()) {
+        return remembered;
+    }
+
+    // Otherwise ask OpenGL
     GLfloat value;
     glGetTexParameterfv(_id, name, &value);
+    if (known && (remembered != value)) {
+        throw logic_error("[TextureTarget] Remembered parameter differs from OpenGL!");
+    }
+    parameters.store(name, value);
     return value;
 }
 
+/**
+ * Finds the remembered parameters of the texture object bound to this texture target.
+ *
+ * @param context Context the texture object belongs to
+ * @return Reference to the remembered parameters of the bound texture object
+ */
+TextureParameters& TextureTarget::getTexParameters(Context& context) const {
+    return context.textureParameters(_id, context.textureBinding(_key));
+}
+
 /**
  * Retrieves the size of the green component of an image in the texture object bound to this texture target.
  *
@@ -1030,6 +1072,7 @@ void TextureTarget::texImage1d(const GLint level,
     assert (isDataFormat(format));
     assert (isDataType(type));
     glTexImage1D(_id, level, internalFormat, width, 0, format, type, data);
+    touchFramebuffers();
 }
 
 /**
@@ -1060,6 +1103,7 @@ void TextureTarget::texImage2d(const GLint level,
     assert (isDataFormat(format));
     assert (isDataType(type));
     glTexImage2D(_id, level, internalFormat, width, height, 0, format, type, data);
+    touchFramebuffers();
 }
 
 /**
@@ -1093,6 +1137,7 @@ void TextureTarget::texImage3d(const GLint level,
     assert (isDataFormat(format));
     assert (isDataType(type));
     glTexImage3D(_id, level, internalFormat, width, height, depth, 0, format, type, data);
+    touchFramebuffers();
 }
 
 /**
@@ -1103,8 +1148,19 @@ void TextureTarget::texImage3d(const GLint level,
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glTexParameter.xml
  */
 void TextureTarget::texParameteri(const GLenum name, const GLint value) const {
+
     assert (isSingleValuedTextureParameter(name));
+
+    // Skip it if the texture already has the value
+    TextureParameters& parameters = getTexParameters(Context::current());
+    GLint remembered;
+    if (parameters.find(name, remembered) && (remembered == value)) {
+        return;
+    }
+
+    // Otherwise change it
     glTexParameteri(_id, name, value);
+    parameters.store(name, value);
 }
 
 /**
@@ -1115,8 +1171,19 @@ void TextureTarget::texParameteri(const GLenum name, const GLint value) const {
  * @see http://www.opengl.org/sdk/docs/man3/xhtml/glTexParameter.xml
  */
 void TextureTarget::texParameterf(const GLenum name, const GLfloat value) const {
+
     assert (isSingleValuedTextureParameter(name));
+
+    // Skip it if the texture already has the value
+    TextureParameters& parameters = getTexParameters(Context::current());
+    GLfloat remembered;
+    if (parameters.find(name, remembered) && (remembered == value)) {
+        return;
+    }
+
+    // Otherwise change it
     glTexParameterf(_id, name, value);
+    parameters.store(name, value);
 }
 
 /**
@@ -1293,11 +1360,24 @@ GLenum TextureTarget::toEnum() const {
     return _id;
 }
 
+/**
+ * Records that the images of the bound texture changed, so framebuffers it is
+ * attached to must have their completeness checked again.
+ */
+void TextureTarget::touchFramebuffers() const {
+    Context& context = Context::current();
+    context.touchFramebuffers(GL_TEXTURE, context.textureBinding(_key));
+}
+
 /**
  * Unbinds any texture object currently bound to this texture target.
  */
 void TextureTarget::unbind() const {
-    glBindTexture(_id, 0);
+    Context& context = Context::current();
+    if (context.textureBinding(_key) != 0) {
+        glBindTexture(_id, 0);
+        context.textureBinding(_key, 0);
+    }
 }
 
 /**
@@ -26,6 +26,7 @@
 #ifndef GLOOP_TEXTURETARGET_HXX
 #define GLOOP_TEXTURETARGET_HXX
 #include "gloop/common.h"
+#include "gloop/Context.hxx"
 #include "gloop/TextureObject.hxx"
 namespace Gloop {
 
@@ -81,6 +82,12 @@ namespace Gloop {
  * ~~~
  *     target.minFilter(GL_LINEAR);
  * ~~~
+ *
+ * The binding of each target and the parameters of each texture object are
+ * remembered by the current @ref Context, so getters do not query OpenGL more
+ * than once, and setters do nothing if the parameter already has the value.
+ * After binding textures or changing parameters by calling OpenGL directly,
+ * invalidate the context.
  */
 class TextureTarget {
 // Friends
@@ -164,6 +171,7 @@ private:
     GLint getTexLevelParameteri(GLint level, GLenum name) const;
     GLfloat getTexParameterf(GLenum name) const;
     GLint getTexParameteri(GLenum name) const;
+    TextureParameters& getTexParameters(Context& context) const;
     static bool isAbleToGenerateMipmapFor(GLenum enumeration);
     static bool isCompareFunc(GLenum enumeration);
     static bool isCompareMode(GLenum enumeration);
@@ -181,6 +189,7 @@ private:
     static bool isWrap(GLenum enumeration);
     void texParameteri(GLenum name, GLint value) const;
     void texParameterf(GLenum name, GLfloat value) const;
+    void touchFramebuffers() const;
 };
 
 } /* namespace Gloop */
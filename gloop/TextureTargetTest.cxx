@@ -30,9 +30,11 @@
 #include <map>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <GL/glfw.h>
 #include "gloop/TextureTarget.hxx"
+#include "gloop/TextureUnit.hxx"
 using namespace std;
 using namespace Gloop;
 
@@ -178,6 +180,7 @@ public:
         // Set the base level manually
         const GLint expected = 2;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, expected);
+        Context::current().invalidate();
 
         // Check the base level
         const TextureTarget target = TextureTarget::texture2d();
@@ -185,7 +188,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        target.baseLevel(0);
     }
 
     /**
@@ -216,6 +219,7 @@ public:
         GLuint id;
         glGenTextures(1, &id);
         glBindTexture(GL_TEXTURE_2D, id);
+        Context::current().invalidate();
 
         // Check binding
         const TextureTarget target = TextureTarget::texture2d();
@@ -239,6 +243,60 @@ public:
         CPPUNIT_ASSERT_EQUAL(texture.id(), (GLuint) binding);
     }
 
+    /**
+     * Ensures TextureTarget::bind(const TextureObject&) does not call OpenGL when the texture object is already bound.
+     */
+    void testBindTextureObjectWhenAlreadyBound() {
+
+        // Bind a texture, then unbind it behind Gloop's back
+        const TextureObject texture = TextureObject::generate();
+        const TextureTarget target = TextureTarget::texture2d();
+        target.bind(texture);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // Check binding it again is skipped
+        target.bind(texture);
+        GLint binding;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &binding);
+        CPPUNIT_ASSERT_EQUAL(0, binding);
+
+        // Clean up
+        Context::current().invalidate();
+        texture.dispose();
+    }
+
+    /**
+     * Ensures bindings are remembered separately for each texture unit.
+     */
+    void testBindingWithTwoTextureUnits() {
+
+        // Bind a different texture on two texture units
+        const TextureObject t0 = TextureObject::generate();
+        const TextureObject t1 = TextureObject::generate();
+        const TextureTarget target = TextureTarget::texture2d();
+        const TextureUnit u0 = TextureUnit::fromEnum(GL_TEXTURE0);
+        const TextureUnit u1 = TextureUnit::fromEnum(GL_TEXTURE1);
+        u0.activate();
+        target.bind(t0);
+        u1.activate();
+        target.bind(t1);
+
+        // Check each unit keeps its own binding
+        CPPUNIT_ASSERT(target.bound(t1));
+        u0.activate();
+        CPPUNIT_ASSERT(target.bound(t0));
+        GLint binding;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &binding);
+        CPPUNIT_ASSERT_EQUAL(t0.id(), (GLuint) binding);
+
+        // Check disposing a texture unbinds it from every unit
+        t1.dispose();
+        u1.activate();
+        CPPUNIT_ASSERT_EQUAL((GLuint) 0, target.binding().id());
+        u0.activate();
+        t0.dispose();
+    }
+
     /**
      * Ensures TextureTarget::blueSize() return zero for GL_R8.
      */
@@ -360,6 +418,7 @@ public:
         // Set the parameter manually
         const GLenum expected = GL_ALWAYS;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, expected);
+        Context::current().invalidate();
 
         // Check the parameter
         const TextureTarget target = TextureTarget::texture2d();
@@ -367,7 +426,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        target.compareFunc(GL_LEQUAL);
     }
 
     /**
@@ -397,6 +456,7 @@ public:
         // Set the parameter manually
         const GLenum expected = GL_COMPARE_REF_TO_TEXTURE;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, expected);
+        Context::current().invalidate();
 
         // Check the parameter
         const TextureTarget target = TextureTarget::texture2d();
@@ -404,7 +464,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        target.compareMode(GL_NONE);
     }
 
     /**
@@ -897,6 +957,7 @@ public:
         // Set the value manually
         const GLfloat expected = 1.0f;
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -904,7 +965,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, 0.0f);
+        target.lodBias(0.0f);
     }
 
     /**
@@ -935,6 +996,7 @@ public:
         // Set the value manually
         const GLenum expected = GL_NEAREST;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -942,7 +1004,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        target.magFilter(GL_LINEAR);
     }
 
     /**
@@ -972,6 +1034,7 @@ public:
         // Set the value manually
         const GLint expected = 500;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -979,7 +1042,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+        target.maxLevel(1000);
     }
 
     /**
@@ -1009,6 +1072,7 @@ public:
         // Set the value manually
         const GLfloat expected = 500.0f;
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_LOD, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -1016,7 +1080,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_LOD, 1000.0f);
+        target.maxLod(1000.0f);
     }
 
     /**
@@ -1046,6 +1110,7 @@ public:
         // Set the value manually
         const GLenum expected = GL_NEAREST;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -1053,7 +1118,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        target.minFilter(GL_NEAREST_MIPMAP_LINEAR);
     }
 
     /**
@@ -1075,6 +1140,58 @@ public:
         target.minFilter(GL_NEAREST_MIPMAP_LINEAR);
     }
 
+    /**
+     * Ensures TextureTarget::minFilter(GLenum) does not call OpenGL when the value is unchanged.
+     */
+    void testMinFilterEnumWithSameValue() {
+
+        // Bind a new texture and set the value
+        const TextureObject texture = TextureObject::generate();
+        const TextureTarget target = TextureTarget::texture2d();
+        target.bind(texture);
+        target.minFilter(GL_LINEAR);
+
+        // Change it behind Gloop's back, then set the same value again
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        target.minFilter(GL_LINEAR);
+
+        // Check the second call was skipped and the getter uses the remembered value
+        GLint actual;
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &actual);
+        CPPUNIT_ASSERT_EQUAL((GLint) GL_NEAREST, actual);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_LINEAR, target.minFilter());
+
+        // Check verifying catches the difference
+        Context& context = Context::current();
+        context.verifying(true);
+        CPPUNIT_ASSERT_THROW(target.minFilter(), logic_error);
+        context.verifying(false);
+        texture.dispose();
+    }
+
+    /**
+     * Ensures texture parameters are remembered for each texture object separately.
+     */
+    void testMinFilterWithTwoTextures() {
+
+        // Set a different value on two textures
+        const TextureObject t1 = TextureObject::generate();
+        const TextureObject t2 = TextureObject::generate();
+        const TextureTarget target = TextureTarget::texture2d();
+        target.bind(t1);
+        target.minFilter(GL_LINEAR);
+        target.bind(t2);
+        target.minFilter(GL_NEAREST);
+
+        // Check each keeps its own value
+        target.bind(t1);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_LINEAR, target.minFilter());
+        target.bind(t2);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NEAREST, target.minFilter());
+        t1.dispose();
+        t2.dispose();
+    }
+
     /**
      * Ensures TextureTarget::minLod() works correctly.
      */
@@ -1083,6 +1200,7 @@ public:
         // Set the value manually
         const GLfloat expected = -500.0f;
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_LOD, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -1090,7 +1208,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_LOD, -1000.0f);
+        target.minLod(-1000.0f);
     }
 
     /**
@@ -1633,6 +1751,7 @@ public:
         // Set the value manually
         const GLenum expected = GL_CLAMP_TO_EDGE;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -1640,7 +1759,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_REPEAT);
+        target.wrapR(GL_REPEAT);
     }
 
     /**
@@ -1670,6 +1789,7 @@ public:
         // Set the value manually
         const GLenum expected = GL_CLAMP_TO_EDGE;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -1677,7 +1797,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        target.wrapS(GL_REPEAT);
     }
 
     /**
@@ -1707,6 +1827,7 @@ public:
         // Set the value manually
         const GLenum expected = GL_CLAMP_TO_EDGE;
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, expected);
+        Context::current().invalidate();
 
         // Check the value
         const TextureTarget target = TextureTarget::texture2d();
@@ -1714,7 +1835,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(expected, actual);
 
         // Set it back to the default
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        target.wrapT(GL_REPEAT);
     }
 
     /**
@@ -1768,6 +1889,8 @@ int main(int argc, char* argv[]) {
         test.testBaseLevelInt();
         test.testBinding();
         test.testBindTextureObject();
+        test.testBindTextureObjectWhenAlreadyBound();
+        test.testBindingWithTwoTextureUnits();
         test.testBlueSizeWithR8();
         test.testBlueSizeWithRg8();
         test.testBlueSizeWithRgb8();
@@ -1822,6 +1945,8 @@ int main(int argc, char* argv[]) {
         test.testMaxLodFloat();
         test.testMinFilter();
         test.testMinFilterEnum();
+        test.testMinFilterEnumWithSameValue();
+        test.testMinFilterWithTwoTextures();
         test.testMinLod();
         test.testMinLodFloat();
         test.testRedSizeWithR8();
@@ -55,21 +55,26 @@ TextureUnit::~TextureUnit() {
 }
 
 /**
- * Activates this texture unit.
+ * Activates this texture unit, unless it is already the active texture unit.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glActiveTexture.xml
  */
 void TextureUnit::activate() const {
-    glActiveTexture(_id);
+    Context& context = Context::current();
+    if (context.integer(GL_ACTIVE_TEXTURE) != (GLint) _id) {
+        glActiveTexture(_id);
+        context.integer(GL_ACTIVE_TEXTURE, _id);
+    }
 }
 
 /**
  * Returns a handle to the active texture unit.
  *
  * @return Handle to the active texture unit
+ * @see Context::integer(GLenum)
  */
 TextureUnit TextureUnit::active() {
-    GLint id;
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &id);
-    return TextureUnit((GLenum) id);
+    return TextureUnit((GLenum) Context::current().integer(GL_ACTIVE_TEXTURE));
 }
 
 /**
@@ -120,8 +125,7 @@ bool TextureUnit::isTextureUnitOrdinal(const GLint ordinal) {
  * @return Number of texture units this implementation supports
  */
 GLint TextureUnit::maxCombinedTextureImageUnits() {
-    GLint value;
-    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &value);
+    const GLint value = Context::current().capabilities().maxCombinedTextureImageUnits();
     assert (value >= MIN_COMBINED_TEXTURE_IMAGE_UNITS);
     return value;
 }
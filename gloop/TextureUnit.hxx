@@ -26,6 +26,7 @@
 #ifndef GLOOP_TEXTUREUNIT_HXX
 #define GLOOP_TEXTUREUNIT_HXX
 #include "gloop/common.h"
+#include "gloop/Context.hxx"
 namespace Gloop {
 
 
@@ -43,6 +44,8 @@ namespace Gloop {
  * `GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS`.  It will be at least `48`.
  *
  * By default, the first texture unit, represented as `GL_TEXTURE0`, is active.
+ * The active texture unit is remembered by the current @ref Context, so
+ * activating the texture unit that is already active does not call OpenGL.
  *
  * The example below binds a new texture as a 2D texture on the second texture
  * unit, filling it with data and changing its minification filter.
@@ -73,8 +76,8 @@ namespace Gloop {
  * just call `toOrdinal` on a _TextureUnit_ instance.
  *
  * ~~~
- *     const map<string,Uniform> uniforms = program.activeUniforms();
- *     const Uniform uniform = uniforms["texture"];
+ *     const ProgramReflection& reflection = program.reflect();
+ *     const Uniform& uniform = *reflection.findUniform("texture");
  *     uniform.load1i(unit.toOrdinal());
  * ~~~
  */
@@ -56,7 +56,28 @@ public:
         CPPUNIT_ASSERT_EQUAL((GLenum) active, unit.toEnum());
 
         // Reset it
+        TextureUnit::fromEnum(GL_TEXTURE0).activate();
+    }
+
+    /**
+     * Ensures TextureUnit::activate() does not call OpenGL when the texture unit is already active.
+     */
+    void testActivateWhenAlreadyActive() {
+
+        // Activate the second texture unit, then change it behind Gloop's back
+        const TextureUnit unit = TextureUnit::fromEnum(GL_TEXTURE1);
+        unit.activate();
         glActiveTexture(GL_TEXTURE0);
+
+        // Check activating it again is skipped
+        unit.activate();
+        GLint active;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
+        CPPUNIT_ASSERT_EQUAL((GLint) GL_TEXTURE0, active);
+
+        // Reset it
+        Context::current().invalidate();
+        TextureUnit::fromEnum(GL_TEXTURE0).activate();
     }
 
     /**
@@ -64,9 +85,10 @@ public:
      */
     void testActive() {
         glActiveTexture(GL_TEXTURE1);
+        Context::current().invalidate();
         const TextureUnit unit = TextureUnit::active();
         CPPUNIT_ASSERT_EQUAL((GLenum) GL_TEXTURE1, unit.toEnum());
-        glActiveTexture(GL_TEXTURE0);
+        TextureUnit::fromEnum(GL_TEXTURE0).activate();
     }
 
     /**
@@ -234,6 +256,7 @@ int main(int argc, char* argv[]) {
     TextureUnitTest test;
     try {
         test.testActivate();
+        test.testActivateWhenAlreadyActive();
         test.testActive();
         test.testAddToStlMap();
         test.testAddToStlSet();
@@ -26,6 +26,7 @@
 #include "config.h"
 #include <cassert>
 #include "gloop/Uniform.hxx"
+#include "gloop/Context.hxx"
 namespace Gloop {
 
 /**
@@ -53,10 +54,12 @@ Uniform::Uniform(GLint location,
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_FLOAT`
  */
-void Uniform::load1f(GLfloat x) {
+void Uniform::load1f(GLfloat x) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT);
-    glUniform1f(location(), x);
+    if (changed(&x, 1, sizeof(x), false)) {
+        glUniform1f(location(), x);
+    }
 }
 
 /**
@@ -67,10 +70,13 @@ void Uniform::load1f(GLfloat x) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_FLOAT_VEC2`
  */
-void Uniform::load2f(GLfloat x, GLfloat y) {
+void Uniform::load2f(GLfloat x, GLfloat y) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_VEC2);
-    glUniform2f(location(), x, y);
+    const GLfloat value[] = { x, y };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform2f(location(), x, y);
+    }
 }
 
 /**
@@ -82,10 +88,13 @@ void Uniform::load2f(GLfloat x, GLfloat y) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_FLOAT_VEC3`
  */
-void Uniform::load3f(GLfloat x, GLfloat y, GLfloat z) {
+void Uniform::load3f(GLfloat x, GLfloat y, GLfloat z) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_VEC3);
-    glUniform3f(location(), x, y, z);
+    const GLfloat value[] = { x, y, z };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform3f(location(), x, y, z);
+    }
 }
 
 /**
@@ -98,10 +107,13 @@ void Uniform::load3f(GLfloat x, GLfloat y, GLfloat z) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_FLOAT_VEC4`
  */
-void Uniform::load4f(GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+void Uniform::load4f(GLfloat x, GLfloat y, GLfloat z, GLfloat w) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_VEC4);
-    glUniform4f(location(), x, y, z, w);
+    const GLfloat value[] = { x, y, z, w };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform4f(location(), x, y, z, w);
+    }
 }
 
 /**
@@ -111,10 +123,12 @@ void Uniform::load4f(GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_INT`
  */
-void Uniform::load1i(GLint x) {
+void Uniform::load1i(GLint x) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT);
-    glUniform1i(location(), x);
+    if (changed(&x, 1, sizeof(x), false)) {
+        glUniform1i(location(), x);
+    }
 }
 
 /**
@@ -125,10 +139,13 @@ void Uniform::load1i(GLint x) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_INT_VEC2`
  */
-void Uniform::load2i(GLint x, GLint y) {
+void Uniform::load2i(GLint x, GLint y) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT_VEC2);
-    glUniform2i(location(), x, y);
+    const GLint value[] = { x, y };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform2i(location(), x, y);
+    }
 }
 
 /**
@@ -140,10 +157,13 @@ void Uniform::load2i(GLint x, GLint y) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_INT_VEC3`
  */
-void Uniform::load3i(GLint x, GLint y, GLint z) {
+void Uniform::load3i(GLint x, GLint y, GLint z) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT_VEC3);
-    glUniform3i(location(), x, y, z);
+    const GLint value[] = { x, y, z };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform3i(location(), x, y, z);
+    }
 }
 
 /**
@@ -156,10 +176,13 @@ void Uniform::load3i(GLint x, GLint y, GLint z) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_INT_VEC4`
  */
-void Uniform::load4i(GLint x, GLint y, GLint z, GLint w) {
+void Uniform::load4i(GLint x, GLint y, GLint z, GLint w) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT_VEC4);
-    glUniform4i(location(), x, y, z, w);
+    const GLint value[] = { x, y, z, w };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform4i(location(), x, y, z, w);
+    }
 }
 
 /**
@@ -169,10 +192,12 @@ void Uniform::load4i(GLint x, GLint y, GLint z, GLint w) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_UNSIGNED_INT`
  */
-void Uniform::load1ui(GLuint x) {
+void Uniform::load1ui(GLuint x) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT);
-    glUniform1ui(location(), x);
+    if (changed(&x, 1, sizeof(x), false)) {
+        glUniform1ui(location(), x);
+    }
 }
 
 /**
@@ -183,10 +208,13 @@ void Uniform::load1ui(GLuint x) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_UNSIGNED_INT_VEC2`
  */
-void Uniform::load2ui(GLuint x, GLuint y) {
+void Uniform::load2ui(GLuint x, GLuint y) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT_VEC2);
-    glUniform2ui(location(), x, y);
+    const GLuint value[] = { x, y };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform2ui(location(), x, y);
+    }
 }
 
 /**
@@ -198,10 +226,13 @@ void Uniform::load2ui(GLuint x, GLuint y) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_UNSIGNED_INT_VEC3`
  */
-void Uniform::load3ui(GLuint x, GLuint y, GLuint z) {
+void Uniform::load3ui(GLuint x, GLuint y, GLuint z) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT_VEC3);
-    glUniform3ui(location(), x, y, z);
+    const GLuint value[] = { x, y, z };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform3ui(location(), x, y, z);
+    }
 }
 
 /**
@@ -214,10 +245,13 @@ void Uniform::load3ui(GLuint x, GLuint y, GLuint z) {
  * @pre Current program is this uniform's program
  * @pre Uniform's type is `GL_UNSIGNED_INT_VEC4`
  */
-void Uniform::load4ui(GLuint x, GLuint y, GLuint z, GLuint w) {
+void Uniform::load4ui(GLuint x, GLuint y, GLuint z, GLuint w) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT_VEC4);
-    glUniform4ui(location(), x, y, z, w);
+    const GLuint value[] = { x, y, z, w };
+    if (changed(value, 1, sizeof(value), false)) {
+        glUniform4ui(location(), x, y, z, w);
+    }
 }
 
 /**
@@ -229,11 +263,13 @@ void Uniform::load4ui(GLuint x, GLuint y, GLuint z, GLuint w) {
  * @pre Uniform's type is `GL_FLOAT`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load1fv(GLsizei count, const GLfloat* value) {
+void Uniform::load1fv(GLsizei count, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT);
     assert (count <= size());
-    glUniform1fv(location(), count, value);
+    if (changed(value, count, count * 1 * sizeof(GLfloat), false)) {
+        glUniform1fv(location(), count, value);
+    }
 }
 
 /**
@@ -245,11 +281,13 @@ void Uniform::load1fv(GLsizei count, const GLfloat* value) {
  * @pre Uniform's type is `GL_FLOAT_VEC2`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load2fv(GLsizei count, const GLfloat* value) {
+void Uniform::load2fv(GLsizei count, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_VEC2);
     assert (count <= size());
-    glUniform2fv(location(), count, value);
+    if (changed(value, count, count * 2 * sizeof(GLfloat), false)) {
+        glUniform2fv(location(), count, value);
+    }
 }
 
 /**
@@ -261,11 +299,13 @@ void Uniform::load2fv(GLsizei count, const GLfloat* value) {
  * @pre Uniform's type is `GL_FLOAT_VEC3`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load3fv(GLsizei count, const GLfloat* value) {
+void Uniform::load3fv(GLsizei count, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_VEC3);
     assert (count <= size());
-    glUniform3fv(location(), count, value);
+    if (changed(value, count, count * 3 * sizeof(GLfloat), false)) {
+        glUniform3fv(location(), count, value);
+    }
 }
 
 /**
@@ -277,11 +317,13 @@ void Uniform::load3fv(GLsizei count, const GLfloat* value) {
  * @pre Uniform's type is `GL_FLOAT_VEC4`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load4fv(GLsizei count, const GLfloat* value) {
+void Uniform::load4fv(GLsizei count, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_VEC4);
     assert (count <= size());
-    glUniform4fv(location(), count, value);
+    if (changed(value, count, count * 4 * sizeof(GLfloat), false)) {
+        glUniform4fv(location(), count, value);
+    }
 }
 
 /**
@@ -293,11 +335,13 @@ void Uniform::load4fv(GLsizei count, const GLfloat* value) {
  * @pre Uniform's type is `GL_INT`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load1iv(GLsizei count, const GLint* value) {
+void Uniform::load1iv(GLsizei count, const GLint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT);
     assert (count <= size());
-    glUniform1iv(location(), count, value);
+    if (changed(value, count, count * 1 * sizeof(GLint), false)) {
+        glUniform1iv(location(), count, value);
+    }
 }
 
 /**
@@ -309,11 +353,13 @@ void Uniform::load1iv(GLsizei count, const GLint* value) {
  * @pre Uniform's type is `GL_INT_VEC2`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load2iv(GLsizei count, const GLint* value) {
+void Uniform::load2iv(GLsizei count, const GLint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT_VEC2);
     assert (count <= size());
-    glUniform2iv(location(), count, value);
+    if (changed(value, count, count * 2 * sizeof(GLint), false)) {
+        glUniform2iv(location(), count, value);
+    }
 }
 
 /**
@@ -325,11 +371,13 @@ void Uniform::load2iv(GLsizei count, const GLint* value) {
  * @pre Uniform's type is `GL_INT_VEC3`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load3iv(GLsizei count, const GLint* value) {
+void Uniform::load3iv(GLsizei count, const GLint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT_VEC3);
     assert (count <= size());
-    glUniform3iv(location(), count, value);
+    if (changed(value, count, count * 3 * sizeof(GLint), false)) {
+        glUniform3iv(location(), count, value);
+    }
 }
 
 /**
@@ -341,11 +389,13 @@ void Uniform::load3iv(GLsizei count, const GLint* value) {
  * @pre Uniform's type is `GL_INT_VEC4`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load4iv(GLsizei count, const GLint* value) {
+void Uniform::load4iv(GLsizei count, const GLint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_INT_VEC4);
     assert (count <= size());
-    glUniform4iv(location(), count, value);
+    if (changed(value, count, count * 4 * sizeof(GLint), false)) {
+        glUniform4iv(location(), count, value);
+    }
 }
 
 /**
@@ -357,11 +407,13 @@ void Uniform::load4iv(GLsizei count, const GLint* value) {
  * @pre Uniform's type is `GL_UNSIGNED_INT`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load1uiv(GLsizei count, const GLuint* value) {
+void Uniform::load1uiv(GLsizei count, const GLuint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT);
     assert (count <= size());
-    glUniform1uiv(location(), count, value);
+    if (changed(value, count, count * 1 * sizeof(GLuint), false)) {
+        glUniform1uiv(location(), count, value);
+    }
 }
 
 /**
@@ -373,11 +425,13 @@ void Uniform::load1uiv(GLsizei count, const GLuint* value) {
  * @pre Uniform's type is `GL_UNSIGNED_INT_VEC2`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load2uiv(GLsizei count, const GLuint* value) {
+void Uniform::load2uiv(GLsizei count, const GLuint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT_VEC2);
     assert (count <= size());
-    glUniform2uiv(location(), count, value);
+    if (changed(value, count, count * 2 * sizeof(GLuint), false)) {
+        glUniform2uiv(location(), count, value);
+    }
 }
 
 /**
@@ -389,11 +443,13 @@ void Uniform::load2uiv(GLsizei count, const GLuint* value) {
  * @pre Uniform's type is `GL_UNSIGNED_INT_VEC3`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load3uiv(GLsizei count, const GLuint* value) {
+void Uniform::load3uiv(GLsizei count, const GLuint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT_VEC3);
     assert (count <= size());
-    glUniform3uiv(location(), count, value);
+    if (changed(value, count, count * 3 * sizeof(GLuint), false)) {
+        glUniform3uiv(location(), count, value);
+    }
 }
 
 /**
@@ -405,11 +461,13 @@ void Uniform::load3uiv(GLsizei count, const GLuint* value) {
  * @pre Uniform's type is `GL_UNSIGNED_INT_VEC4`
  * @pre Number of values to load is less than or equal to size of uniform
  */
-void Uniform::load4uiv(GLsizei count, const GLuint* value) {
+void Uniform::load4uiv(GLsizei count, const GLuint* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_UNSIGNED_INT_VEC4);
     assert (count <= size());
-    glUniform4uiv(location(), count, value);
+    if (changed(value, count, count * 4 * sizeof(GLuint), false)) {
+        glUniform4uiv(location(), count, value);
+    }
 }
 
 /**
@@ -422,11 +480,13 @@ void Uniform::load4uiv(GLsizei count, const GLuint* value) {
  * @pre Uniform's type is `GL_FLOAT_MAT2`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix2fv(GLsizei count, GLboolean transpose, const GLfloat* value) {
+void Uniform::loadMatrix2fv(GLsizei count, GLboolean transpose, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT2);
     assert (count <= size());
-    glUniformMatrix2fv(location(), count, transpose, value);
+    if (changed(value, count, count * 4 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix2fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -439,11 +499,13 @@ void Uniform::loadMatrix2fv(GLsizei count, GLboolean transpose, const GLfloat* v
  * @pre Uniform's type is `GL_FLOAT_MAT3`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix3fv(GLsizei count, GLboolean transpose, const GLfloat* value) {
+void Uniform::loadMatrix3fv(GLsizei count, GLboolean transpose, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT3);
     assert (count <= size());
-    glUniformMatrix3fv(location(), count, transpose, value);
+    if (changed(value, count, count * 9 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix3fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -456,11 +518,13 @@ void Uniform::loadMatrix3fv(GLsizei count, GLboolean transpose, const GLfloat* v
  * @pre Uniform's type is `GL_FLOAT_MAT4`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix4fv(GLsizei count, GLboolean transpose, const GLfloat* value) {
+void Uniform::loadMatrix4fv(GLsizei count, GLboolean transpose, const GLfloat* value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT4);
     assert (count <= size());
-    glUniformMatrix4fv(location(), count, transpose, value);
+    if (changed(value, count, count * 16 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix4fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -473,11 +537,13 @@ void Uniform::loadMatrix4fv(GLsizei count, GLboolean transpose, const GLfloat* v
  * @pre Uniform's type is `GL_FLOAT_MAT2x3`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix2x3fv(GLsizei count, GLboolean transpose, const GLfloat *value) {
+void Uniform::loadMatrix2x3fv(GLsizei count, GLboolean transpose, const GLfloat *value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT2x3);
     assert (count <= size());
-    glUniformMatrix2x3fv(location(), count, transpose, value);
+    if (changed(value, count, count * 6 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix2x3fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -490,11 +556,13 @@ void Uniform::loadMatrix2x3fv(GLsizei count, GLboolean transpose, const GLfloat
  * @pre Uniform's type is `GL_FLOAT_MAT3x2`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix3x2fv(GLsizei count, GLboolean transpose, const GLfloat *value) {
+void Uniform::loadMatrix3x2fv(GLsizei count, GLboolean transpose, const GLfloat *value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT3x2);
     assert (count <= size());
-    glUniformMatrix3x2fv(location(), count, transpose, value);
+    if (changed(value, count, count * 6 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix3x2fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -507,11 +575,13 @@ void Uniform::loadMatrix3x2fv(GLsizei count, GLboolean transpose, const GLfloat
  * @pre Uniform's type is `GL_FLOAT_MAT2x4`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix2x4fv(GLsizei count, GLboolean transpose, const GLfloat *value) {
+void Uniform::loadMatrix2x4fv(GLsizei count, GLboolean transpose, const GLfloat *value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT2x4);
     assert (count <= size());
-    glUniformMatrix2x4fv(location(), count, transpose, value);
+    if (changed(value, count, count * 8 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix2x4fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -524,11 +594,13 @@ void Uniform::loadMatrix2x4fv(GLsizei count, GLboolean transpose, const GLfloat
  * @pre Uniform's type is `GL_FLOAT_MAT4x2`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix4x2fv(GLsizei count, GLboolean transpose, const GLfloat *value) {
+void Uniform::loadMatrix4x2fv(GLsizei count, GLboolean transpose, const GLfloat *value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT4x2);
     assert (count <= size());
-    glUniformMatrix4x2fv(location(), count, transpose, value);
+    if (changed(value, count, count * 8 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix4x2fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -541,11 +613,13 @@ void Uniform::loadMatrix4x2fv(GLsizei count, GLboolean transpose, const GLfloat
  * @pre Uniform's type is `GL_FLOAT_MAT3x4`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix3x4fv(GLsizei count, GLboolean transpose, const GLfloat *value) {
+void Uniform::loadMatrix3x4fv(GLsizei count, GLboolean transpose, const GLfloat *value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT3x4);
     assert (count <= size());
-    glUniformMatrix3x4fv(location(), count, transpose, value);
+    if (changed(value, count, count * 12 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix3x4fv(location(), count, transpose, value);
+    }
 }
 
 /**
@@ -558,19 +632,37 @@ void Uniform::loadMatrix3x4fv(GLsizei count, GLboolean transpose, const GLfloat
  * @pre Uniform's type is `GL_FLOAT_MAT4x3`
  * @pre Number of matrices to load is less than or equal to size of uniform
  */
-void Uniform::loadMatrix4x3fv(GLsizei count, GLboolean transpose, const GLfloat *value) {
+void Uniform::loadMatrix4x3fv(GLsizei count, GLboolean transpose, const GLfloat *value) const {
     assert (currentProgram() == program());
     assert (type() == GL_FLOAT_MAT4x3);
     assert (count <= size());
-    glUniformMatrix4x3fv(location(), count, transpose, value);
+    if (changed(value, count, count * 12 * sizeof(GLfloat), transpose)) {
+        glUniformMatrix4x3fv(location(), count, transpose, value);
+    }
 }
 
 // HELPERS
 
+/**
+ * Checks if a value differs from the one last loaded into the uniform, remembering it if so.
+ *
+ * @param count Number of array elements being loaded
+ * @param value Pointer to the value being loaded
+ * @param size Size of the value in bytes
+ * @param transposed Whether the value is a matrix being loaded in row-major order
+ * @return `true` if the value needs to be loaded into OpenGL
+ */
+bool Uniform::changed(const void* value, const GLsizei count, const size_t size, const bool transposed) const {
+    return Context::current().uniforms().update(program(), location(), count, value, size, transposed);
+}
+
+/**
+ * Determines the program in use, as remembered by the current context.
+ *
+ * @return ID of the program in use, or `0` if none
+ */
 GLuint Uniform::currentProgram() {
-    GLint program;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
-    return program;
+    return (GLuint) Context::current().integer(GL_CURRENT_PROGRAM);
 }
 
 } /* namespace Gloop */
@@ -32,48 +32,53 @@ namespace Gloop {
 
 /**
  * OpenGL uniform information.
+ *
+ * Loading a value that the uniform already has is skipped without calling
+ * OpenGL.  See @ref UniformCache.
  */
 class Uniform : public Variable {
 // Friends
     friend class Program;
+    friend class ProgramReflection;
 public:
 // Methods
-    void load1f(GLfloat x);
-    void load2f(GLfloat x, GLfloat y);
-    void load3f(GLfloat x, GLfloat y, GLfloat z);
-    void load4f(GLfloat x, GLfloat y, GLfloat z, GLfloat w);
-    void load1i(GLint x);
-    void load2i(GLint x, GLint y);
-    void load3i(GLint x, GLint y, GLint z);
-    void load4i(GLint x, GLint y, GLint z, GLint w);
-    void load1ui(GLuint x);
-    void load2ui(GLuint x, GLuint y);
-    void load3ui(GLuint x, GLuint y, GLuint z);
-    void load4ui(GLuint x, GLuint y, GLuint z, GLuint w);
-    void load1fv(GLsizei count, const GLfloat* value);
-    void load2fv(GLsizei count, const GLfloat* value);
-    void load3fv(GLsizei count, const GLfloat* value);
-    void load4fv(GLsizei count, const GLfloat* value);
-    void load1iv(GLsizei count, const GLint* value);
-    void load2iv(GLsizei count, const GLint* value);
-    void load3iv(GLsizei count, const GLint* value);
-    void load4iv(GLsizei count, const GLint* value);
-    void load1uiv(GLsizei count, const GLuint* value);
-    void load2uiv(GLsizei count, const GLuint* value);
-    void load3uiv(GLsizei count, const GLuint* value);
-    void load4uiv(GLsizei count, const GLuint* value);
-    void loadMatrix2fv(GLsizei count, GLboolean transpose, const GLfloat* value);
-    void loadMatrix3fv(GLsizei count, GLboolean transpose, const GLfloat* value);
-    void loadMatrix4fv(GLsizei count, GLboolean transpose, const GLfloat* value);
-    void loadMatrix2x3fv(GLsizei count, GLboolean transpose, const GLfloat *value);
-    void loadMatrix3x2fv(GLsizei count, GLboolean transpose, const GLfloat *value);
-    void loadMatrix2x4fv(GLsizei count, GLboolean transpose, const GLfloat *value);
-    void loadMatrix4x2fv(GLsizei count, GLboolean transpose, const GLfloat *value);
-    void loadMatrix3x4fv(GLsizei count, GLboolean transpose, const GLfloat *value);
-    void loadMatrix4x3fv(GLsizei count, GLboolean transpose, const GLfloat *value);
+    void load1f(GLfloat x) const;
+    void load2f(GLfloat x, GLfloat y) const;
+    void load3f(GLfloat x, GLfloat y, GLfloat z) const;
+    void load4f(GLfloat x, GLfloat y, GLfloat z, GLfloat w) const;
+    void load1i(GLint x) const;
+    void load2i(GLint x, GLint y) const;
+    void load3i(GLint x, GLint y, GLint z) const;
+    void load4i(GLint x, GLint y, GLint z, GLint w) const;
+    void load1ui(GLuint x) const;
+    void load2ui(GLuint x, GLuint y) const;
+    void load3ui(GLuint x, GLuint y, GLuint z) const;
+    void load4ui(GLuint x, GLuint y, GLuint z, GLuint w) const;
+    void load1fv(GLsizei count, const GLfloat* value) const;
+    void load2fv(GLsizei count, const GLfloat* value) const;
+    void load3fv(GLsizei count, const GLfloat* value) const;
+    void load4fv(GLsizei count, const GLfloat* value) const;
+    void load1iv(GLsizei count, const GLint* value) const;
+    void load2iv(GLsizei count, const GLint* value) const;
+    void load3iv(GLsizei count, const GLint* value) const;
+    void load4iv(GLsizei count, const GLint* value) const;
+    void load1uiv(GLsizei count, const GLuint* value) const;
+    void load2uiv(GLsizei count, const GLuint* value) const;
+    void load3uiv(GLsizei count, const GLuint* value) const;
+    void load4uiv(GLsizei count, const GLuint* value) const;
+    void loadMatrix2fv(GLsizei count, GLboolean transpose, const GLfloat* value) const;
+    void loadMatrix3fv(GLsizei count, GLboolean transpose, const GLfloat* value) const;
+    void loadMatrix4fv(GLsizei count, GLboolean transpose, const GLfloat* value) const;
+    void loadMatrix2x3fv(GLsizei count, GLboolean transpose, const GLfloat *value) const;
+    void loadMatrix3x2fv(GLsizei count, GLboolean transpose, const GLfloat *value) const;
+    void loadMatrix2x4fv(GLsizei count, GLboolean transpose, const GLfloat *value) const;
+    void loadMatrix4x2fv(GLsizei count, GLboolean transpose, const GLfloat *value) const;
+    void loadMatrix3x4fv(GLsizei count, GLboolean transpose, const GLfloat *value) const;
+    void loadMatrix4x3fv(GLsizei count, GLboolean transpose, const GLfloat *value) const;
 private:
 // Methods
     Uniform(GLint location, const std::string& name, GLuint program, GLint size, GLenum type);
+    bool changed(const void* value, GLsizei count, size_t size, bool transposed) const;
     static GLuint currentProgram();
 };
 
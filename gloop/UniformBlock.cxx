@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <stdexcept>
+#include "gloop/UniformBlock.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs a uniform block.
+ *
+ * @param layout Layout of the block
+ * @param buffer Buffer object holding the block
+ * @param binding Uniform buffer binding point reserved for the block
+ */
+UniformBlock::UniformBlock(const UniformBlockLayout& layout, const BufferObject& buffer, const GLuint binding) :
+        _binding(binding),
+        _buffer(buffer),
+        _data(layout.size(), 0),
+        _dirtyBegin(0),
+        _dirtyEnd(layout.size()),
+        _layout(layout) {
+    // empty
+}
+
+/**
+ * Makes a program read a uniform block from this buffer.
+ *
+ * @param program Linked program with a uniform block laid out like this one
+ * @param name Name of the uniform block in the program
+ * @throws std::invalid_argument if the program has no such block
+ * @throws std::logic_error if the block in the program is laid out differently
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glUniformBlockBinding.xml
+ */
+void UniformBlock::attach(const Program& program, const string& name) const {
+    _layout.validate(program.id(), name);
+    const GLuint index = glGetUniformBlockIndex(program.id(), name.c_str());
+    glUniformBlockBinding(program.id(), index, _binding);
+}
+
+/**
+ * Returns the uniform buffer binding point reserved for this block.
+ *
+ * @return Index of the binding point
+ */
+GLuint UniformBlock::binding() const {
+    return _binding;
+}
+
+/**
+ * Returns the buffer object holding this block.
+ *
+ * @return Handle to the buffer object
+ */
+BufferObject UniformBlock::buffer() const {
+    return _buffer;
+}
+
+/**
+ * Creates a uniform block with a new buffer object and binding point.
+ *
+ * The buffer object is left bound to `GL_UNIFORM_BUFFER`.
+ *
+ * @param layout Layout of the block
+ * @return Uniform block whose values are all zero
+ * @throws std::invalid_argument if the layout has no members
+ * @throws std::runtime_error if no uniform buffer binding points are free
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBindBufferBase.xml
+ */
+UniformBlock UniformBlock::create(const UniformBlockLayout& layout) {
+
+    // Check layout
+    if (layout.size() == 0) {
+        throw invalid_argument("[UniformBlock] Layout is empty!");
+    }
+
+    // Make a buffer big enough for it
+    const BufferObject buffer = BufferObject::generate();
+    const BufferTarget target = BufferTarget::uniformBuffer();
+    target.bind(buffer);
+    target.data(layout.size(), NULL, GL_DYNAMIC_DRAW);
+
+    // Bind it to its own binding point
+    const GLuint binding = Context::current().reserveUniformBufferBinding();
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer.id());
+
+    return UniformBlock(layout, buffer, binding);
+}
+
+/**
+ * Deletes the buffer object and releases the binding point of this block.
+ */
+void UniformBlock::dispose() const {
+    Context::current().releaseUniformBufferBinding(_binding);
+    _buffer.dispose();
+}
+
+/**
+ * Returns the layout of this block.
+ *
+ * @return Reference to the layout
+ */
+const UniformBlockLayout& UniformBlock::layout() const {
+    return _layout;
+}
+
+/**
+ * Records that part of the block changed since the last update.
+ *
+ * @param begin Offset of the first changed byte
+ * @param end Offset after the last changed byte
+ */
+void UniformBlock::touch(const GLsizeiptr begin, const GLsizeiptr end) {
+    if (_dirtyBegin >= _dirtyEnd) {
+        _dirtyBegin = begin;
+        _dirtyEnd = end;
+    } else {
+        _dirtyBegin = min(_dirtyBegin, begin);
+        _dirtyEnd = max(_dirtyEnd, end);
+    }
+}
+
+/**
+ * Writes everything changed since the last update to the buffer object.
+ *
+ * Changes are sent with one `glBufferSubData` covering all of them, and
+ * nothing is sent if nothing changed.  The buffer object is left bound to
+ * `GL_UNIFORM_BUFFER`.
+ *
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glBufferSubData.xml
+ */
+void UniformBlock::update() {
+
+    // Check if anything changed
+    if (_dirtyBegin >= _dirtyEnd) {
+        return;
+    }
+
+    // Write changed range
+    const BufferTarget target = BufferTarget::uniformBuffer();
+    if (!target.bound(_buffer)) {
+        target.bind(_buffer);
+    }
+    target.subData(_dirtyBegin, _dirtyEnd - _dirtyBegin, &_data[_dirtyBegin]);
+    _dirtyBegin = 0;
+    _dirtyEnd = 0;
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_UNIFORMBLOCK_HXX
+#define GLOOP_UNIFORMBLOCK_HXX
+#include "gloop/common.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/UniformBlockLayout.hxx"
+namespace Gloop {
+
+
+/**
+ * Uniform buffer holding the values of a uniform block.
+ *
+ * A _UniformBlock_ owns a buffer object sized for a @ref UniformBlockLayout
+ * and a copy of its contents in memory.  Each one is given its own uniform
+ * buffer binding point from the current @ref Context when it is created, so
+ * programs using the block only need to be attached once.
+ *
+ * ~~~
+ *     UniformBlock transforms = UniformBlock::create(layout);
+ *     transforms.attach(program, "Transforms");
+ * ~~~
+ *
+ * Values are written into the copy in memory with @ref set, which places them
+ * at the offsets computed for the member.  Nothing is sent to OpenGL until
+ * @ref update, which writes everything changed since the last update with a
+ * single `glBufferSubData`.
+ *
+ * ~~~
+ *     transforms.set<MVPMatrix>(mvp);
+ *     transforms.set<Elapsed>(elapsed);
+ *     transforms.update();
+ * ~~~
+ */
+class UniformBlock {
+public:
+// Methods
+    void attach(const Program& program, const std::string& name) const;
+    GLuint binding() const;
+    BufferObject buffer() const;
+    static UniformBlock create(const UniformBlockLayout& layout);
+    void dispose() const;
+    const UniformBlockLayout& layout() const;
+    template<typename M> void set(const typename M::Type::Component& value);
+    template<typename M> void set(const typename M::Type::Component* value);
+    void update();
+private:
+// Attributes
+    GLuint _binding;
+    BufferObject _buffer;
+    std::vector<GLubyte> _data;
+    GLsizeiptr _dirtyBegin;
+    GLsizeiptr _dirtyEnd;
+    UniformBlockLayout _layout;
+// Methods
+    UniformBlock(const UniformBlockLayout& layout, const BufferObject& buffer, GLuint binding);
+    void touch(GLsizeiptr begin, GLsizeiptr end);
+};
+
+/**
+ * Changes the value of a scalar member.
+ *
+ * @param value Value of the member
+ */
+template<typename M>
+void UniformBlock::set(const typename M::Type::Component& value) {
+    set<M>(&value);
+}
+
+/**
+ * Changes the value of a member.
+ *
+ * @param value Tightly packed values of the member, with matrices in column-major order
+ * @throws std::out_of_range if checking and the member does not fit in the block
+ */
+template<typename M>
+void UniformBlock::set(const typename M::Type::Component* value) {
+    if (GLOOP_CHECKS && (M::end > (int) _data.size())) {
+        throw std::out_of_range("[UniformBlock] Member does not fit in block!");
+    }
+    UniformBlockLayout::copy(&_data[0],
+                             value,
+                             M::offset,
+                             M::Type::count,
+                             M::Type::arrayStride,
+                             M::Type::columns,
+                             M::Type::columnStride,
+                             M::Type::rows);
+    touch(M::offset, M::end);
+}
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <stdexcept>
+#include "gloop/UniformBlockLayout.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs an empty layout.
+ */
+UniformBlockLayout::UniformBlockLayout() : _size(0) {
+    // empty
+}
+
+/**
+ * Adds a member to the layout, after its offset and strides have been computed.
+ *
+ * @param name Name OpenGL reports for the member
+ * @param offset Offset of the member from the start of the block, in bytes
+ * @param type Type of the member, e.g. `GL_FLOAT_VEC4`
+ * @param count Number of elements in the member, `1` unless it is an array
+ * @param arrayStride Bytes between elements if an array, or `0`
+ * @param matrixStride Bytes between columns if a matrix, or `0`
+ * @param end Offset after the member, rounded up to 16 bytes
+ */
+void UniformBlockLayout::addEntry(const string& name,
+                                  const GLint offset,
+                                  const GLenum type,
+                                  const GLint count,
+                                  const GLint arrayStride,
+                                  const GLint matrixStride,
+                                  const GLsizeiptr end) {
+    if (name.empty()) {
+        throw invalid_argument("[UniformBlockLayout] Name is empty!");
+    }
+    Entry entry;
+    entry.name = name;
+    entry.offset = offset;
+    entry.type = type;
+    entry.count = count;
+    entry.arrayStride = arrayStride;
+    entry.matrixStride = matrixStride;
+    _entries.push_back(entry);
+    _size = max(_size, end);
+}
+
+/**
+ * Copies tightly packed values into a block, spreading them out to match the layout.
+ *
+ * @param block Start of the block's data
+ * @param value Tightly packed values, with matrices in column-major order
+ * @param offset Offset of the member in the block, in bytes
+ * @param count Number of array elements to copy
+ * @param arrayStride Bytes between array elements in the block
+ * @param columns Number of columns in each element
+ * @param columnStride Bytes between columns in the block
+ * @param rows Number of 4-byte components in each column
+ */
+void UniformBlockLayout::copy(GLubyte* block,
+                              const void* value,
+                              const int offset,
+                              const int count,
+                              const int arrayStride,
+                              const int columns,
+                              const int columnStride,
+                              const int rows) {
+    const GLubyte* src = (const GLubyte*) value;
+    const size_t len = rows * 4;
+    for (int i = 0; i < count; ++i) {
+        GLubyte* dst = block + offset + (i * arrayStride);
+        for (int c = 0; c < columns; ++c) {
+            memcpy(dst + (c * columnStride), src, len);
+            src += len;
+        }
+    }
+}
+
+/**
+ * Returns the size of a block with this layout.
+ *
+ * @return Size of the block in bytes, rounded up to 16
+ */
+GLsizeiptr UniformBlockLayout::size() const {
+    return _size;
+}
+
+/**
+ * Checks this layout matches a uniform block in a linked program.
+ *
+ * @param program ID of a linked program
+ * @param block Name of the uniform block in the program
+ * @throws std::invalid_argument if the program has no active block or member by that name
+ * @throws std::logic_error if a member differs from the program, or the block is larger than the layout
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetActiveUniformBlock.xml
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGetActiveUniforms.xml
+ */
+void UniformBlockLayout::validate(const GLuint program, const string& block) const {
+
+    // Find the block
+    const GLuint index = glGetUniformBlockIndex(program, block.c_str());
+    if (index == GL_INVALID_INDEX) {
+        throw invalid_argument("[UniformBlockLayout] Block is not active in program!");
+    }
+
+    // Check the layout covers it
+    GLint dataSize;
+    glGetActiveUniformBlockiv(program, index, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+    if (dataSize > _size) {
+        throw logic_error("[UniformBlockLayout] Block is larger than layout!");
+    }
+
+    // Check each member
+    for (vector<Entry>::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+
+        // Find the member
+        const GLchar* name = it->name.c_str();
+        GLuint uniform;
+        glGetUniformIndices(program, 1, &name, &uniform);
+        if (uniform == GL_INVALID_INDEX) {
+            throw invalid_argument("[UniformBlockLayout] Member is not active in program!");
+        }
+
+        // Get how OpenGL laid it out
+        GLint blockIndex, offset, type, count, arrayStride, matrixStride;
+        glGetActiveUniformsiv(program, 1, &uniform, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+        glGetActiveUniformsiv(program, 1, &uniform, GL_UNIFORM_OFFSET, &offset);
+        glGetActiveUniformsiv(program, 1, &uniform, GL_UNIFORM_TYPE, &type);
+        glGetActiveUniformsiv(program, 1, &uniform, GL_UNIFORM_SIZE, &count);
+        glGetActiveUniformsiv(program, 1, &uniform, GL_UNIFORM_ARRAY_STRIDE, &arrayStride);
+        glGetActiveUniformsiv(program, 1, &uniform, GL_UNIFORM_MATRIX_STRIDE, &matrixStride);
+
+        // Compare
+        if (blockIndex != (GLint) index) {
+            throw invalid_argument("[UniformBlockLayout] Member is not in block!");
+        } else if (offset != it->offset) {
+            throw logic_error("[UniformBlockLayout] Offset of member differs from program!");
+        } else if (((GLenum) type != it->type) || (count != it->count)) {
+            throw logic_error("[UniformBlockLayout] Type of member differs from program!");
+        } else if ((arrayStride != it->arrayStride) || (matrixStride != it->matrixStride)) {
+            throw logic_error("[UniformBlockLayout] Stride of member differs from program!");
+        }
+    }
+}
+
+} /* namespace Gloop */
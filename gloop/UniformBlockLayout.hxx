@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_UNIFORMBLOCKLAYOUT_HXX
+#define GLOOP_UNIFORMBLOCKLAYOUT_HXX
+#include "gloop/common.h"
+#include <string>
+#include <vector>
+namespace Gloop {
+
+
+/**
+ * Description of a uniform block laid out with the `std140` rules.
+ *
+ * The offset of each member is computed by the compiler from the types of the
+ * members before it.  Describe the block as a chain of _Member_ types, each
+ * naming its type and the member before it, starting from _Begin_.
+ *
+ * ~~~
+ *     // layout(std140) uniform Transforms {
+ *     //     mat4 MVPMatrix;
+ *     //     vec3 LightPosition;
+ *     //     float Elapsed;
+ *     //     vec4 Colors[4];
+ *     // };
+ *     typedef UniformBlockLayout L;
+ *     typedef L::Member<L::Mat4, L::Begin> MVPMatrix;          // offset 0
+ *     typedef L::Member<L::Vec3, MVPMatrix> LightPosition;     // offset 64
+ *     typedef L::Member<L::Float, LightPosition> Elapsed;      // offset 76
+ *     typedef L::Member<L::Array<L::Vec4,4>, Elapsed> Colors;  // offset 80
+ * ~~~
+ *
+ * A _UniformBlockLayout_ instance collects the members under the names OpenGL
+ * reports for them, so the layout can be checked against a linked program with
+ * @ref validate before it is used.  See @ref UniformBlock for filling and
+ * binding a buffer with this layout.
+ *
+ * ~~~
+ *     UniformBlockLayout layout;
+ *     layout.add<MVPMatrix>("MVPMatrix");
+ *     layout.add<LightPosition>("LightPosition");
+ *     layout.add<Elapsed>("Elapsed");
+ *     layout.add<Colors>("Colors[0]");
+ *     layout.validate(program.id(), "Transforms");
+ * ~~~
+ */
+class UniformBlockLayout {
+public:
+// Types
+    /**
+     * Rounds an offset up to a multiple of an alignment.
+     */
+    template<int OFFSET, int ALIGNMENT>
+    struct Align {
+        enum { value = ((OFFSET + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT };
+    };
+
+    /**
+     * Scalar, vector or column-major matrix type.
+     *
+     * Matrices are stored as arrays of column vectors, each padded to 16 bytes.
+     * Vectors of three or four components are aligned to 16 bytes.
+     */
+    template<typename COMPONENT, GLenum TYPE, int COLUMNS, int ROWS>
+    struct Basic {
+        typedef COMPONENT Component;
+        enum {
+            type = TYPE,
+            columns = COLUMNS,
+            rows = ROWS,
+            count = 1,
+            array = 0,
+            matrixStride = (COLUMNS > 1) ? 16 : 0,
+            columnStride = (COLUMNS > 1) ? 16 : ROWS * 4,
+            alignment = ((COLUMNS > 1) || (ROWS > 2)) ? 16 : ROWS * 4,
+            size = COLUMNS * columnStride,
+            arrayStride = size
+        };
+    };
+
+    /**
+     * Array of a scalar, vector or matrix type, with each element padded to 16 bytes.
+     */
+    template<typename T, int N>
+    struct Array {
+        typedef typename T::Component Component;
+        enum {
+            type = T::type,
+            columns = T::columns,
+            rows = T::rows,
+            count = N,
+            array = 1,
+            matrixStride = T::matrixStride,
+            columnStride = T::columnStride,
+            alignment = 16,
+            arrayStride = Align<T::size, 16>::value,
+            size = arrayStride * N
+        };
+    };
+
+    /**
+     * Start of a block, before its first member.
+     */
+    struct Begin {
+        enum { end = 0 };
+    };
+
+    /**
+     * Member of a block, placed after another member.
+     */
+    template<typename T, typename PREVIOUS>
+    struct Member {
+        typedef T Type;
+        enum {
+            offset = Align<PREVIOUS::end, T::alignment>::value,
+            end = offset + T::size
+        };
+    };
+
+    /**
+     * Size of a block whose last member is given, rounded up to 16 bytes.
+     */
+    template<typename LAST>
+    struct Size {
+        enum { value = Align<LAST::end, 16>::value };
+    };
+
+    typedef Basic<GLfloat,GL_FLOAT,1,1> Float;
+    typedef Basic<GLfloat,GL_FLOAT_VEC2,1,2> Vec2;
+    typedef Basic<GLfloat,GL_FLOAT_VEC3,1,3> Vec3;
+    typedef Basic<GLfloat,GL_FLOAT_VEC4,1,4> Vec4;
+    typedef Basic<GLint,GL_INT,1,1> Int;
+    typedef Basic<GLint,GL_INT_VEC2,1,2> IVec2;
+    typedef Basic<GLint,GL_INT_VEC3,1,3> IVec3;
+    typedef Basic<GLint,GL_INT_VEC4,1,4> IVec4;
+    typedef Basic<GLuint,GL_UNSIGNED_INT,1,1> UInt;
+    typedef Basic<GLuint,GL_UNSIGNED_INT_VEC2,1,2> UVec2;
+    typedef Basic<GLuint,GL_UNSIGNED_INT_VEC3,1,3> UVec3;
+    typedef Basic<GLuint,GL_UNSIGNED_INT_VEC4,1,4> UVec4;
+    typedef Basic<GLint,GL_BOOL,1,1> Boolean;
+    typedef Basic<GLfloat,GL_FLOAT_MAT2,2,2> Mat2;
+    typedef Basic<GLfloat,GL_FLOAT_MAT3,3,3> Mat3;
+    typedef Basic<GLfloat,GL_FLOAT_MAT4,4,4> Mat4;
+// Methods
+    UniformBlockLayout();
+    template<typename M> void add(const std::string& name);
+    static void copy(GLubyte* block, const void* value, int offset, int count, int arrayStride,
+                     int columns, int columnStride, int rows);
+    GLsizeiptr size() const;
+    void validate(GLuint program, const std::string& block) const;
+private:
+// Types
+    struct Entry {
+        std::string name;
+        GLint offset;
+        GLenum type;
+        GLint count;
+        GLint arrayStride;
+        GLint matrixStride;
+    };
+// Attributes
+    std::vector<Entry> _entries;
+    GLsizeiptr _size;
+// Methods
+    void addEntry(const std::string& name, GLint offset, GLenum type, GLint count,
+                  GLint arrayStride, GLint matrixStride, GLsizeiptr end);
+};
+
+/**
+ * Adds a member to the layout.
+ *
+ * @param name Name OpenGL reports for the member, e.g. `Colors[0]` for an array
+ */
+template<typename M>
+void UniformBlockLayout::add(const std::string& name) {
+    addEntry(name,
+             M::offset,
+             M::Type::type,
+             M::Type::count,
+             M::Type::array ? M::Type::arrayStride : 0,
+             M::Type::matrixStride,
+             Align<M::end,16>::value);
+}
+
+} /* namespace Gloop */
+#endif
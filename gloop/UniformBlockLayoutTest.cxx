@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/Program.hxx"
+#include "gloop/UniformBlockLayout.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+typedef UniformBlockLayout L;
+typedef L::Member<L::Mat4, L::Begin> MVPMatrix;
+typedef L::Member<L::Vec3, MVPMatrix> LightPosition;
+typedef L::Member<L::Float, LightPosition> Elapsed;
+typedef L::Member<L::Array<L::Vec2,3>, Elapsed> Offsets;
+typedef L::Member<L::Mat3, Offsets> NormalMatrix;
+typedef L::Member<L::Int, NormalMatrix> Mode;
+
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "layout(std140) uniform Transforms {\n"
+        "    mat4 MVPMatrix;\n"
+        "    vec3 LightPosition;\n"
+        "    float Elapsed;\n"
+        "    vec2 Offsets[3];\n"
+        "    mat3 NormalMatrix;\n"
+        "    int Mode;\n"
+        "};\n"
+        "in vec4 MCVertex;\n"
+        "void main() {\n"
+        "    vec3 v = NormalMatrix * (LightPosition + vec3(Offsets[Mode], Elapsed));\n"
+        "    gl_Position = MVPMatrix * MCVertex + vec4(v, 0);\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = vec4(1);\n"
+        "}\n";
+
+
+/**
+ * Unit test for `UniformBlockLayout`.
+ */
+class UniformBlockLayoutTest {
+public:
+
+    /**
+     * Makes a program with the test block and links it.
+     */
+    static Program createProgram() {
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.link();
+        if (!program.linked()) {
+            throw runtime_error(program.log());
+        }
+        return program;
+    }
+
+    /**
+     * Makes a layout describing the test block.
+     */
+    static UniformBlockLayout createLayout() {
+        UniformBlockLayout layout;
+        layout.add<MVPMatrix>("MVPMatrix");
+        layout.add<LightPosition>("LightPosition");
+        layout.add<Elapsed>("Elapsed");
+        layout.add<Offsets>("Offsets[0]");
+        layout.add<NormalMatrix>("NormalMatrix");
+        layout.add<Mode>("Mode");
+        return layout;
+    }
+
+    /**
+     * Ensures offsets follow the std140 rules.
+     */
+    void testOffsets() {
+        CPPUNIT_ASSERT_EQUAL(0, (int) MVPMatrix::offset);
+        CPPUNIT_ASSERT_EQUAL(64, (int) LightPosition::offset);
+        CPPUNIT_ASSERT_EQUAL(76, (int) Elapsed::offset);
+        CPPUNIT_ASSERT_EQUAL(80, (int) Offsets::offset);
+        CPPUNIT_ASSERT_EQUAL(16, (int) Offsets::Type::arrayStride);
+        CPPUNIT_ASSERT_EQUAL(128, (int) NormalMatrix::offset);
+        CPPUNIT_ASSERT_EQUAL(176, (int) Mode::offset);
+        CPPUNIT_ASSERT_EQUAL(192, (int) L::Size<Mode>::value);
+        CPPUNIT_ASSERT_EQUAL((GLsizeiptr) 192, createLayout().size());
+    }
+
+    /**
+     * Ensures `UniformBlockLayout::validate` accepts a layout matching the program.
+     */
+    void testValidateWithMatchingLayout() {
+        const Program program = createProgram();
+        createLayout().validate(program.id(), "Transforms");
+        program.dispose();
+    }
+
+    /**
+     * Ensures `UniformBlockLayout::validate` rejects a layout with a wrong offset.
+     */
+    void testValidateWithWrongOffset() {
+        typedef L::Member<L::Vec3, L::Begin> WrongPosition;
+        const Program program = createProgram();
+        UniformBlockLayout layout = createLayout();
+        layout.add<WrongPosition>("LightPosition");
+        CPPUNIT_ASSERT_THROW(layout.validate(program.id(), "Transforms"), logic_error);
+        program.dispose();
+    }
+
+    /**
+     * Ensures `UniformBlockLayout::validate` rejects a layout missing trailing members.
+     */
+    void testValidateWithMissingMembers() {
+        const Program program = createProgram();
+        UniformBlockLayout layout;
+        layout.add<MVPMatrix>("MVPMatrix");
+        CPPUNIT_ASSERT_THROW(layout.validate(program.id(), "Transforms"), logic_error);
+        program.dispose();
+    }
+
+    /**
+     * Ensures `UniformBlockLayout::validate` rejects an unknown block or member.
+     */
+    void testValidateWithUnknownNames() {
+        const Program program = createProgram();
+        CPPUNIT_ASSERT_THROW(createLayout().validate(program.id(), "Lights"), invalid_argument);
+        UniformBlockLayout layout = createLayout();
+        layout.add<Elapsed>("Speed");
+        CPPUNIT_ASSERT_THROW(layout.validate(program.id(), "Transforms"), invalid_argument);
+        program.dispose();
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    UniformBlockLayoutTest test;
+    try {
+        test.testOffsets();
+        test.testValidateWithMatchingLayout();
+        test.testValidateWithWrongOffset();
+        test.testValidateWithMissingMembers();
+        test.testValidateWithUnknownNames();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
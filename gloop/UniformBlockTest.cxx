@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <stdexcept>
+#include "gloop/common.h"
+#include "gloop/UniformBlock.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+typedef UniformBlockLayout L;
+typedef L::Member<L::Mat3, L::Begin> NormalMatrix;
+typedef L::Member<L::Float, NormalMatrix> Scale;
+typedef L::Member<L::Array<L::Float,2>, Scale> Weights;
+
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "layout(std140) uniform Transforms {\n"
+        "    mat3 NormalMatrix;\n"
+        "    float Scale;\n"
+        "    float Weights[2];\n"
+        "};\n"
+        "in vec4 MCVertex;\n"
+        "void main() {\n"
+        "    vec3 v = NormalMatrix * MCVertex.xyz * Scale * (Weights[0] + Weights[1]);\n"
+        "    gl_Position = vec4(v, 1);\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = vec4(1);\n"
+        "}\n";
+
+
+/**
+ * Unit test for `UniformBlock`.
+ */
+class UniformBlockTest {
+public:
+
+    /**
+     * Makes a layout describing the test block.
+     */
+    static UniformBlockLayout createLayout() {
+        UniformBlockLayout layout;
+        layout.add<NormalMatrix>("NormalMatrix");
+        layout.add<Scale>("Scale");
+        layout.add<Weights>("Weights[0]");
+        return layout;
+    }
+
+    /**
+     * Reads a float from the buffer object of a block.
+     */
+    static GLfloat readFloat(const UniformBlock& block, const GLintptr offset) {
+        const BufferTarget target = BufferTarget::uniformBuffer();
+        target.bind(block.buffer());
+        GLfloat value;
+        glGetBufferSubData(GL_UNIFORM_BUFFER, offset, sizeof(value), &value);
+        return value;
+    }
+
+    /**
+     * Ensures `UniformBlock::attach` binds the program's block to the block's binding point.
+     */
+    void testAttach() {
+
+        // Make program
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.link();
+        CPPUNIT_ASSERT(program.linked());
+
+        // Attach and check binding
+        const UniformBlock block = UniformBlock::create(createLayout());
+        block.attach(program, "Transforms");
+        const GLuint index = glGetUniformBlockIndex(program.id(), "Transforms");
+        GLint binding;
+        glGetActiveUniformBlockiv(program.id(), index, GL_UNIFORM_BLOCK_BINDING, &binding);
+        CPPUNIT_ASSERT_EQUAL((GLint) block.binding(), binding);
+
+        // Check a mismatched layout is rejected
+        UniformBlockLayout layout;
+        layout.add<L::Member<L::Vec4, L::Begin> >("NormalMatrix");
+        const UniformBlock wrong = UniformBlock::create(layout);
+        CPPUNIT_ASSERT_THROW(wrong.attach(program, "Transforms"), logic_error);
+
+        // Clean up
+        wrong.dispose();
+        block.dispose();
+        program.dispose();
+    }
+
+    /**
+     * Ensures each block gets its own binding point, which is reused after dispose.
+     */
+    void testBinding() {
+        const UniformBlock b1 = UniformBlock::create(createLayout());
+        const UniformBlock b2 = UniformBlock::create(createLayout());
+        CPPUNIT_ASSERT(b1.binding() != b2.binding());
+        const GLuint binding = b1.binding();
+        b1.dispose();
+        const UniformBlock b3 = UniformBlock::create(createLayout());
+        CPPUNIT_ASSERT_EQUAL(binding, b3.binding());
+        b2.dispose();
+        b3.dispose();
+    }
+
+    /**
+     * Ensures `UniformBlock::set` places values at std140 offsets once updated.
+     */
+    void testSetAndUpdate() {
+
+        // Make block and set values
+        UniformBlock block = UniformBlock::create(createLayout());
+        const GLfloat normalMatrix[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        const GLfloat weights[] = { 0.25f, 0.75f };
+        block.set<NormalMatrix>(normalMatrix);
+        block.set<Scale>(2.0f);
+        block.set<Weights>(weights);
+        block.update();
+
+        // Check columns are padded to 16 bytes
+        CPPUNIT_ASSERT_EQUAL(1.0f, readFloat(block, 0));
+        CPPUNIT_ASSERT_EQUAL(3.0f, readFloat(block, 8));
+        CPPUNIT_ASSERT_EQUAL(4.0f, readFloat(block, 16));
+        CPPUNIT_ASSERT_EQUAL(9.0f, readFloat(block, 40));
+
+        // Check scalar and array elements padded to 16 bytes
+        CPPUNIT_ASSERT_EQUAL(2.0f, readFloat(block, 48));
+        CPPUNIT_ASSERT_EQUAL(0.25f, readFloat(block, 64));
+        CPPUNIT_ASSERT_EQUAL(0.75f, readFloat(block, 80));
+
+        // Change one value and update again
+        block.set<Scale>(3.0f);
+        block.update();
+        CPPUNIT_ASSERT_EQUAL(3.0f, readFloat(block, 48));
+        CPPUNIT_ASSERT_EQUAL(1.0f, readFloat(block, 0));
+        block.dispose();
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    UniformBlockTest test;
+    try {
+        test.testAttach();
+        test.testBinding();
+        test.testSetAndUpdate();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
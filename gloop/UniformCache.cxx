@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include "gloop/UniformCache.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Constructs an empty uniform cache.
+ */
+UniformCache::UniformCache() : _hits(0), _misses(0), _widest(1) {
+    // empty
+}
+
+/**
+ * Forgets the values of every uniform in every program.
+ */
+void UniformCache::clear() {
+    _values.clear();
+    _widest = 1;
+}
+
+/**
+ * Forgets the values of every uniform in a program.
+ *
+ * @param program ID of the program whose values will be forgotten
+ */
+void UniformCache::forget(const GLuint program) {
+    const map<Key,Value>::iterator first = _values.lower_bound(Key(program, INT_MIN));
+    const map<Key,Value>::iterator last = _values.upper_bound(Key(program, INT_MAX));
+    _values.erase(first, last);
+}
+
+/**
+ * Forgets the values remembered at other locations that a new value overlaps.
+ *
+ * An array occupies one location per element, so a value loaded at one
+ * location may change elements remembered at another.
+ *
+ * @param program ID of the program the uniform is in
+ * @param location Location the new value was loaded at
+ * @param count Number of locations the new value covers
+ */
+void UniformCache::forgetOverlapping(const GLuint program, const GLint location, const GLsizei count) {
+    typedef map<Key,Value>::iterator value_iterator;
+
+    // Forget later locations the new value covers
+    value_iterator it = _values.upper_bound(Key(program, location));
+    while ((it != _values.end()) && (it->first.first == program) && (it->first.second < location + count)) {
+        _values.erase(it++);
+    }
+
+    // Forget earlier locations whose values cover the new one
+    const GLint first = (location > INT_MIN + _widest) ? location - _widest : INT_MIN;
+    it = _values.lower_bound(Key(program, first));
+    while ((it != _values.end()) && (it->first < Key(program, location))) {
+        if (it->first.second + it->second.count > location) {
+            _values.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * Returns the number of loads skipped because the uniform already had the value.
+ *
+ * @return Number of loads skipped since the counters were last reset
+ */
+unsigned long UniformCache::hits() const {
+    return _hits;
+}
+
+/**
+ * Returns the number of loads that had to be passed on to OpenGL.
+ *
+ * @return Number of loads passed on to OpenGL since the counters were last reset
+ */
+unsigned long UniformCache::misses() const {
+    return _misses;
+}
+
+/**
+ * Sets the number of hits and misses back to zero.
+ */
+void UniformCache::resetCounters() {
+    _hits = 0;
+    _misses = 0;
+}
+
+/**
+ * Records a value about to be loaded into a uniform, unless the uniform already has it.
+ *
+ * Loading an array into a uniform only changes as many elements as are given,
+ * so a value that matches the start of what was loaded before is also a hit.
+ *
+ * @param program ID of the program the uniform is in
+ * @param location Location of the uniform in the program
+ * @param count Number of array elements being loaded, each at its own location
+ * @param value Pointer to the value being loaded
+ * @param size Size of the value in bytes
+ * @param transposed Whether the value is a matrix being loaded in row-major order
+ * @return `true` if the value is different and needs to be loaded into OpenGL
+ */
+bool UniformCache::update(const GLuint program,
+                          const GLint location,
+                          const GLsizei count,
+                          const void* value,
+                          const size_t size,
+                          const bool transposed) {
+
+    // Loading nothing never changes anything
+    if (size == 0) {
+        ++_hits;
+        return false;
+    }
+
+    // Check if the uniform already has the value
+    Value& current = _values[Key(program, location)];
+    if ((current.transposed == transposed)
+            && (size <= current.bytes.size())
+            && (memcmp(&current.bytes[0], value, size) == 0)) {
+        ++_hits;
+        return false;
+    }
+
+    // Otherwise remember the new one
+    if (current.transposed != transposed) {
+        current.bytes.clear();
+        current.count = 0;
+    }
+    if (size > current.bytes.size()) {
+        current.bytes.resize(size);
+    }
+    memcpy(&current.bytes[0], value, size);
+    current.count = max(current.count, count);
+    current.transposed = transposed;
+    _widest = max(_widest, current.count);
+
+    // Forget elements it changed that were remembered at other locations
+    forgetOverlapping(program, location, count);
+    ++_misses;
+    return true;
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_UNIFORMCACHE_HXX
+#define GLOOP_UNIFORMCACHE_HXX
+#include "gloop/common.h"
+#include <map>
+#include <utility>
+#include <vector>
+namespace Gloop {
+
+
+/**
+ * Copy of the values last loaded into the uniforms of each program.
+ *
+ * Applications commonly load the same values into uniforms over and over, for
+ * example the position of a light or the texture unit of a sampler before every
+ * draw.  To skip the redundant calls, @ref Uniform remembers what it loaded into
+ * each location of each program, and only calls `glUniform` when the new value
+ * is different.  Comparing a few bytes in memory is much cheaper than a call
+ * into the driver.
+ *
+ * Each @ref Context has one _UniformCache_, shared by all of its programs.  The
+ * number of loads that were skipped and the number that went through to OpenGL
+ * are counted, so the savings can be measured.
+ *
+ * ~~~
+ *     const UniformCache& cache = Context::current().uniforms();
+ *     cout << cache.hits() << " of " << (cache.hits() + cache.misses()) << endl;
+ * ~~~
+ *
+ * Each element of an array uniform has its own location.  Loading an element
+ * through its location forgets what was remembered for any array loaded
+ * through a location whose elements include it, and the other way around, so
+ * both stay correct.
+ *
+ * Since the cache only sees loads made through Gloop, call @ref forget for a
+ * program after loading its uniforms with `glUniform` directly.  Linking or
+ * deleting a program with @ref Program does so automatically.
+ */
+class UniformCache {
+public:
+// Methods
+    UniformCache();
+    void clear();
+    void forget(GLuint program);
+    unsigned long hits() const;
+    unsigned long misses() const;
+    void resetCounters();
+    bool update(GLuint program, GLint location, GLsizei count, const void* value, size_t size, bool transposed);
+private:
+// Types
+    typedef std::pair<GLuint,GLint> Key;
+    struct Value {
+        std::vector<unsigned char> bytes;
+        GLsizei count;
+        bool transposed;
+        Value() : count(0), transposed(false) { }
+    };
+// Attributes
+    std::map<Key,Value> _values;
+    unsigned long _hits;
+    unsigned long _misses;
+    GLsizei _widest;
+// Methods
+    void forgetOverlapping(GLuint program, GLint location, GLsizei count);
+};
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cppunit/extensions/HelperMacros.h>
+#include <map>
+#include <stdexcept>
+#include <GL/glfw.h>
+#include "gloop/Context.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/Shader.hxx"
+#include "gloop/Uniform.hxx"
+#include "gloop/UniformCache.hxx"
+using namespace std;
+using namespace Gloop;
+
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "uniform mat4 MVPMatrix = mat4(1);\n"
+        "in vec4 MCVertex;\n"
+        "void main() {\n"
+        "    gl_Position = MVPMatrix * MCVertex;\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "uniform vec4 Color = vec4(1);\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = Color;\n"
+        "}\n";
+
+/**
+ * Unit test for UniformCache.
+ */
+class UniformCacheTest {
+public:
+
+    /**
+     * Makes and links a program with a `Color` and `MVPMatrix` uniform.
+     */
+    static Program createProgram() {
+        const Program program = Program::create();
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.link();
+        return program;
+    }
+
+    /**
+     * Ensures forgetting a program only forgets the values for that program.
+     */
+    void testForget() {
+        UniformCache cache;
+        const GLint value = 1;
+        cache.update(1, 0, 1, &value, sizeof(value), false);
+        cache.update(2, 0, 1, &value, sizeof(value), false);
+        cache.forget(1);
+        CPPUNIT_ASSERT(cache.update(1, 0, 1, &value, sizeof(value), false));
+        CPPUNIT_ASSERT(!cache.update(2, 0, 1, &value, sizeof(value), false));
+    }
+
+    /**
+     * Ensures loading the same value into a uniform twice only calls OpenGL once.
+     */
+    void testLoadWithSameValue() {
+
+        // Load a value
+        const Program program = createProgram();
+        program.use();
+        Uniform color = program.activeUniforms().find("Color")->second;
+        UniformCache& cache = Context::current().uniforms();
+        cache.resetCounters();
+        color.load4f(0.1f, 0.2f, 0.3f, 0.4f);
+        CPPUNIT_ASSERT_EQUAL(0ul, cache.hits());
+        CPPUNIT_ASSERT_EQUAL(1ul, cache.misses());
+
+        // Change it behind Gloop's back, then load it again
+        glUniform4f(color.location(), 1, 1, 1, 1);
+        color.load4f(0.1f, 0.2f, 0.3f, 0.4f);
+        CPPUNIT_ASSERT_EQUAL(1ul, cache.hits());
+        CPPUNIT_ASSERT_EQUAL(1ul, cache.misses());
+
+        // Check the second load was skipped
+        GLfloat value[4];
+        glGetUniformfv(program.id(), color.location(), value);
+        CPPUNIT_ASSERT_EQUAL(1.0f, value[0]);
+        program.dispose();
+    }
+
+    /**
+     * Ensures loading a different value into a uniform calls OpenGL.
+     */
+    void testLoadWithDifferentValue() {
+
+        // Load two different values
+        const Program program = createProgram();
+        program.use();
+        Uniform color = program.activeUniforms().find("Color")->second;
+        color.load4f(0.1f, 0.2f, 0.3f, 0.4f);
+        color.load4f(0.5f, 0.6f, 0.7f, 0.8f);
+
+        // Check the second one is in OpenGL
+        GLfloat value[4];
+        glGetUniformfv(program.id(), color.location(), value);
+        CPPUNIT_ASSERT_EQUAL(0.5f, value[0]);
+        CPPUNIT_ASSERT_EQUAL(0.8f, value[3]);
+        program.dispose();
+    }
+
+    /**
+     * Ensures a matrix loaded with a different transpose flag is loaded again.
+     */
+    void testLoadMatrixWithDifferentTranspose() {
+
+        // Load a matrix, then the same one transposed
+        const Program program = createProgram();
+        program.use();
+        Uniform mvp = program.activeUniforms().find("MVPMatrix")->second;
+        const GLfloat matrix[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+        mvp.loadMatrix4fv(1, GL_FALSE, matrix);
+        mvp.loadMatrix4fv(1, GL_TRUE, matrix);
+
+        // Check the transposed one is in OpenGL
+        GLfloat value[16];
+        glGetUniformfv(program.id(), mvp.location(), value);
+        CPPUNIT_ASSERT_EQUAL(5.0f, value[1]);
+        program.dispose();
+    }
+
+    /**
+     * Ensures values are forgotten when the program is linked again.
+     */
+    void testLoadAfterLink() {
+
+        // Load a value, then link again to reset it
+        const Program program = createProgram();
+        program.use();
+        Uniform color = program.activeUniforms().find("Color")->second;
+        color.load4f(0.1f, 0.2f, 0.3f, 0.4f);
+        program.link();
+        color = program.activeUniforms().find("Color")->second;
+
+        // Check loading it again goes to OpenGL
+        color.load4f(0.1f, 0.2f, 0.3f, 0.4f);
+        GLfloat value[4];
+        glGetUniformfv(program.id(), color.location(), value);
+        CPPUNIT_ASSERT_EQUAL(0.1f, value[0]);
+        program.dispose();
+    }
+
+    /**
+     * Ensures loading one element of an array through its own location forgets the array.
+     */
+    void testUpdateElementThenArray() {
+        UniformCache cache;
+        const GLfloat values[] = { 1, 2, 3, 4 };
+        const GLfloat element = 5;
+
+        // Load the array, then change element 2 through its location
+        CPPUNIT_ASSERT(cache.update(1, 3, 4, values, sizeof(values), false));
+        CPPUNIT_ASSERT(cache.update(1, 5, 1, &element, sizeof(element), false));
+
+        // Check reloading the whole array goes to OpenGL
+        CPPUNIT_ASSERT(cache.update(1, 3, 4, values, sizeof(values), false));
+
+        // Check the element it changed back is loaded again too
+        CPPUNIT_ASSERT(cache.update(1, 5, 1, &element, sizeof(element), false));
+
+        // Check locations past the end of the array are kept
+        CPPUNIT_ASSERT(cache.update(1, 7, 1, &element, sizeof(element), false));
+        CPPUNIT_ASSERT(cache.update(1, 3, 4, values, sizeof(values), false));
+        CPPUNIT_ASSERT(!cache.update(1, 7, 1, &element, sizeof(element), false));
+    }
+
+    /**
+     * Ensures a value matching the start of a longer array is a hit.
+     */
+    void testUpdateWithPrefix() {
+        UniformCache cache;
+        const GLfloat values[] = { 1, 2, 3 };
+        CPPUNIT_ASSERT(cache.update(1, 0, 3, values, sizeof(values), false));
+        CPPUNIT_ASSERT(!cache.update(1, 0, 2, values, sizeof(GLfloat) * 2, false));
+        CPPUNIT_ASSERT_EQUAL(1ul, cache.hits());
+        CPPUNIT_ASSERT_EQUAL(1ul, cache.misses());
+    }
+
+    /**
+     * Ensures changing part of an array keeps the rest of it.
+     */
+    void testUpdateWithShorterDifferentValue() {
+        UniformCache cache;
+        const GLfloat values[] = { 1, 2, 3 };
+        const GLfloat first = 4;
+        const GLfloat expected[] = { 4, 2, 3 };
+        cache.update(1, 0, 3, values, sizeof(values), false);
+        CPPUNIT_ASSERT(cache.update(1, 0, 1, &first, sizeof(first), false));
+        CPPUNIT_ASSERT(!cache.update(1, 0, 3, expected, sizeof(expected), false));
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    UniformCacheTest test;
+    try {
+        test.testForget();
+        test.testLoadWithSameValue();
+        test.testLoadWithDifferentValue();
+        test.testLoadMatrixWithDifferentTranspose();
+        test.testLoadAfterLink();
+        test.testUpdateElementThenArray();
+        test.testUpdateWithPrefix();
+        test.testUpdateWithShorterDifferentValue();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -64,11 +64,91 @@ VertexArrayObject::~VertexArrayObject() {
 /**
  * Binds the vertex array object represented by this handle into the current OpenGL context.
  *
+ * Since the `GL_ELEMENT_ARRAY_BUFFER` binding is part of the state of a
+ * vertex array object, the current context forgets which buffer object was
+ * bound to it.  Nothing is done if the vertex array object is already bound.
+ *
  * @see @ref unbind
  * @see @ref bound
  */
 void VertexArrayObject::bind() const {
+
+    // Check if already bound
+    Context& context = Context::current();
+    if (context.integer(GL_VERTEX_ARRAY_BINDING) == (GLint) _id) {
+        return;
+    }
+
+    // Bind it
     glBindVertexArray(_id);
+    context.integer(GL_VERTEX_ARRAY_BINDING, _id);
+    context.forget(GL_ELEMENT_ARRAY_BUFFER_BINDING);
+}
+
+/**
+ * Binds a buffer object to a vertex buffer binding point of this vertex array object.
+ *
+ * Every vertex attribute assigned to the binding point with @ref
+ * vertexAttribBinding reads from the buffer object, starting at _offset_ and
+ * advancing _stride_ bytes per vertex.  Changing the buffer object for a mesh
+ * is therefore one call, no matter how many attributes it has, and one vertex
+ * array object can be shared by every buffer with the same vertex format.
+ *
+ * @param binding Index of the vertex buffer binding point
+ * @param buffer Buffer object holding the vertices
+ * @param offset Offset of the first vertex in the buffer object, in bytes
+ * @param stride Bytes between vertices
+ * @throws logic_error if checking and this vertex array object is not bound
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @throws invalid_argument if checking and binding is greater than or equal to `GL_MAX_VERTEX_ATTRIB_BINDINGS`, or offset or stride is negative
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glBindVertexBuffer.xml
+ */
+void VertexArrayObject::bindVertexBuffer(const GLuint binding,
+                                         const BufferObject& buffer,
+                                         const GLintptr offset,
+                                         const GLsizei stride) const {
+
+    // Check if supported
+    if (!Context::current().capabilities().hasVertexAttribBinding()) {
+        throw runtime_error("[VertexArrayObject] Vertex attribute bindings are not supported!");
+    }
+
+    // Check if bound
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
+    }
+
+    // Check binding
+    if (GLOOP_CHECKS && (binding >= (GLuint) maxVertexAttribBindings())) {
+        throw invalid_argument("[VertexArrayObject] Binding is greater than or equal to GL_MAX_VERTEX_ATTRIB_BINDINGS!");
+    }
+
+    // Check offset and stride
+    if (GLOOP_CHECKS && ((offset < 0) || (stride < 0))) {
+        throw invalid_argument("[VertexArrayObject] Offset and stride must not be negative!");
+    }
+
+    // Bind it
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    glBindVertexBuffer(binding, buffer.id(), offset, stride);
+#endif
+}
+
+/**
+ * Binds a range of a buffer object handed out by a buffer heap to a vertex buffer binding point.
+ *
+ * @param binding Index of the vertex buffer binding point
+ * @param allocation Range of a buffer object holding the vertices
+ * @param stride Bytes between vertices
+ * @throws logic_error if checking and this vertex array object is not bound
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @throws invalid_argument if checking and binding is greater than or equal to `GL_MAX_VERTEX_ATTRIB_BINDINGS`, or stride is negative
+ * @see @ref BufferHeap
+ */
+void VertexArrayObject::bindVertexBuffer(const GLuint binding,
+                                         const BufferAllocation& allocation,
+                                         const GLsizei stride) const {
+    bindVertexBuffer(binding, allocation.buffer(), allocation.offset(), stride);
 }
 
 /**
@@ -78,21 +158,73 @@ void VertexArrayObject::bind() const {
  * @see @ref bind
  */
 bool VertexArrayObject::bound() const {
+    return Context::current().integer(GL_VERTEX_ARRAY_BINDING) == (GLint) _id;
+}
 
-    // Get the current binding
-    GLint binding;
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &binding);
+/**
+ * Checks that the data type of a vertex attribute pointer can be read as its declared shader type.
+ *
+ * @param pointer Vertex attribute pointer to check
+ * @throws invalid_argument if an integer attribute is not an integer type or is normalized,
+ *                          or a double-precision attribute is not `GL_DOUBLE`
+ * @throws runtime_error if a double-precision attribute is used but not supported
+ */
+void VertexArrayObject::checkShaderType(const VertexAttribPointer& pointer) {
+    switch (shaderBaseType(pointer._shaderType)) {
+    case GL_INT:
+        if (!isIntegerVertexAttribType(pointer._type)) {
+            throw invalid_argument("[VertexArrayObject] Type of an integer attribute must be an integer type!");
+        } else if (pointer._normalized) {
+            throw invalid_argument("[VertexArrayObject] Integer attributes cannot be normalized!");
+        }
+        break;
+    case GL_DOUBLE:
+        if (pointer._type != GL_DOUBLE) {
+            throw invalid_argument("[VertexArrayObject] Type of a double-precision attribute must be GL_DOUBLE!");
+        } else if (!Context::current().capabilities().hasVertexAttrib64Bit()) {
+            throw runtime_error("[VertexArrayObject] Double-precision attributes are not supported!");
+        }
+        break;
+    }
+}
 
-    // Check if equal
-    return _id == binding;
+/**
+ * Disables the vertex arrays of a matrix vertex attribute.
+ *
+ * @param index Index of the vertex attribute for the first column
+ * @param columns Number of columns in the matrix, which each take one index
+ * @throws logic_error if checking and this vertex array object is not currently bound
+ * @throws invalid_argument if checking and any index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @see @ref matrixAttribPointer
+ */
+void VertexArrayObject::disableMatrixAttribArray(const GLuint index, const GLsizei columns) const {
+    for (GLsizei i = 0; i < columns; ++i) {
+        disableVertexAttribArray(index + i);
+    }
+}
+
+/**
+ * Disables the vertex arrays of a matrix vertex attribute set up with a pointer.
+ *
+ * @param pointer Vertex attribute pointer the matrix was set up with
+ * @param columns Number of columns in the matrix, which take two indices each for a `dmat3` or `dmat4`
+ * @throws logic_error if checking and this vertex array object is not currently bound
+ * @throws invalid_argument if checking and any index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @see @ref matrixAttribPointer
+ */
+void VertexArrayObject::disableMatrixAttribArray(const VertexAttribPointer& pointer, const GLsizei columns) const {
+    const GLuint step = indicesPerColumn(pointer);
+    for (GLsizei i = 0; i < columns; ++i) {
+        disableVertexAttribArray(pointer._index + i * step);
+    }
 }
 
 /**
  * Disables a vertex array.
  *
  * @param index Index of vertex attribute the vertex array is for
- * @throws logic_error if this vertex array object is not currently bound
- * @throws invalid_argument if index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @throws logic_error if checking and this vertex array object is not currently bound
+ * @throws invalid_argument if checking and index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
  * @see @ref vertexAttribPointer
  * @see @ref enableVertexAttribArray
  * @see @ref Program::attribLocation
@@ -100,17 +232,17 @@ bool VertexArrayObject::bound() const {
 void VertexArrayObject::disableVertexAttribArray(const GLuint index) const {
 
     // Check if bound
-    if (!bound()) {
+    if (GLOOP_CHECKS && !bound()) {
         throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
     }
 
     // Check index
-    if (index >= maxVertexAttribs()) {
+    if (GLOOP_CHECKS && (index >= (GLuint) maxVertexAttribs())) {
         throw invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS!");
     }
 
-    // Enable it
-    glEnableVertexAttribArray(index);
+    // Disable it
+    glDisableVertexAttribArray(index);
 }
 
 /**
@@ -118,14 +250,69 @@ void VertexArrayObject::disableVertexAttribArray(const GLuint index) const {
  */
 void VertexArrayObject::dispose() const {
     glDeleteVertexArrays(1, &_id);
+    Context::current().forgetVertexArray(_id);
+}
+
+/**
+ * Records this vertex array object to be deleted later with others, instead of right away.
+ *
+ * @param queue Queue to record the vertex array object in
+ * @see DeletionQueue::flush
+ */
+void VertexArrayObject::dispose(DeletionQueue& queue) const {
+    queue.enqueue(GL_VERTEX_ARRAY, _id);
+}
+
+/**
+ * Gives the name of this vertex array object back to a pool instead of deleting it.
+ *
+ * The vertex array object keeps its OpenGL state, so it can be taken from the pool
+ * again with @ref generate(NamePool&) and set up from scratch.
+ *
+ * @param pool Pool of GL_VERTEX_ARRAY names to give the name to
+ * @throws std::invalid_argument if the pool is not for vertex array objects
+ */
+void VertexArrayObject::dispose(NamePool& pool) const {
+    pool.release(GL_VERTEX_ARRAY, _id);
+}
+
+/**
+ * Enables the vertex arrays of a matrix vertex attribute.
+ *
+ * @param index Index of the vertex attribute for the first column
+ * @param columns Number of columns in the matrix, which each take one index
+ * @throws logic_error if checking and this vertex array object is not currently bound
+ * @throws invalid_argument if checking and any index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @see @ref matrixAttribPointer
+ */
+void VertexArrayObject::enableMatrixAttribArray(const GLuint index, const GLsizei columns) const {
+    for (GLsizei i = 0; i < columns; ++i) {
+        enableVertexAttribArray(index + i);
+    }
+}
+
+/**
+ * Enables the vertex arrays of a matrix vertex attribute set up with a pointer.
+ *
+ * @param pointer Vertex attribute pointer the matrix was set up with
+ * @param columns Number of columns in the matrix, which take two indices each for a `dmat3` or `dmat4`
+ * @throws logic_error if checking and this vertex array object is not currently bound
+ * @throws invalid_argument if checking and any index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @see @ref matrixAttribPointer
+ */
+void VertexArrayObject::enableMatrixAttribArray(const VertexAttribPointer& pointer, const GLsizei columns) const {
+    const GLuint step = indicesPerColumn(pointer);
+    for (GLsizei i = 0; i < columns; ++i) {
+        enableVertexAttribArray(pointer._index + i * step);
+    }
 }
 
 /**
  * Enables a vertex array.
  *
  * @param index Index of vertex attribute the vertex array is for
- * @throws logic_error if this vertex array object is not currently bound
- * @throws invalid_argument if index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @throws logic_error if checking and this vertex array object is not currently bound
+ * @throws invalid_argument if checking and index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
  * @see @ref vertexAttribPointer
  * @see @ref disableVertexAttribArray
  * @see @ref Program::attribLocation
@@ -133,12 +320,12 @@ void VertexArrayObject::dispose() const {
 void VertexArrayObject::enableVertexAttribArray(const GLuint index) const {
 
     // Check if bound
-    if (!bound()) {
+    if (GLOOP_CHECKS && !bound()) {
         throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
     }
 
     // Check index
-    if (index >= maxVertexAttribs()) {
+    if (GLOOP_CHECKS && (index >= (GLuint) maxVertexAttribs())) {
         throw invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS!");
     }
 
@@ -183,6 +370,41 @@ VertexArrayObject VertexArrayObject::generate() {
     return VertexArrayObject(id);
 }
 
+/**
+ * Creates handles for several new vertex array objects at once.
+ *
+ * @param n Number of vertex array objects to generate
+ * @return Handles for the new vertex array objects
+ * @throws std::invalid_argument if number is negative
+ * @throws std::runtime_error if the vertex array objects could not be generated
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glGenVertexArrays.xml
+ */
+vector<VertexArrayObject> VertexArrayObject::generate(const GLsizei n) {
+
+    // Generate all the IDs in one call
+    const vector<GLuint> ids = NamePool::generate(GL_VERTEX_ARRAY, n);
+
+    // Make handles
+    vector<VertexArrayObject> vaos;
+    vaos.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        vaos.push_back(VertexArrayObject(ids[i]));
+    }
+    return vaos;
+}
+
+/**
+ * Creates a handle for a vertex array object taken from a pool.
+ *
+ * @param pool Pool of GL_VERTEX_ARRAY names to take the name from
+ * @return Handle for the vertex array object, which may have been used before
+ * @throws std::invalid_argument if the pool is not for vertex array objects
+ * @throws std::runtime_error if the pool could not generate more names
+ */
+VertexArrayObject VertexArrayObject::generate(NamePool& pool) {
+    return VertexArrayObject(pool.take(GL_VERTEX_ARRAY));
+}
+
 /**
  * Returns the internal OpenGL identifier of the vertex array object this handle represents.
  *
@@ -192,15 +414,181 @@ GLuint VertexArrayObject::id() const {
     return _id;
 }
 
+/**
+ * Determines how many indices each column of a matrix vertex attribute takes.
+ *
+ * @param pointer Vertex attribute pointer for the first column
+ * @return `2` if the columns are passed to the shader as `dvec3` or `dvec4`, otherwise `1`
+ */
+GLuint VertexArrayObject::indicesPerColumn(const VertexAttribPointer& pointer) {
+    if ((shaderBaseType(pointer._shaderType) == GL_DOUBLE) && (pointer._size > 2)) {
+        return 2;
+    } else {
+        return 1;
+    }
+}
+
+/**
+ * Checks if an enumeration is a data type an integer vertex attribute can be read from.
+ *
+ * @param enumeration Enumeration to check
+ * @return `true` if enumeration is a signed or unsigned byte, short or int
+ */
+bool VertexArrayObject::isIntegerVertexAttribType(const GLenum enumeration) {
+    switch (enumeration) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Checks if an enumeration is a valid data type for a vertex attribute pointer.
+ *
+ * @param enumeration Enumeration to check
+ * @return `true` if enumeration is a valid data type for a vertex attribute pointer
+ */
+bool VertexArrayObject::isVertexAttribType(const GLenum enumeration) {
+    switch (enumeration) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_HALF_FLOAT:
+    case GL_FLOAT:
+    case GL_DOUBLE:
+#ifdef GL_INT_2_10_10_10_REV
+    case GL_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Specifies the location and data format of a vertex array for a matrix vertex attribute.
+ *
+ * A matrix vertex attribute, such as a `mat4`, takes one index for each of its
+ * columns, or two for a `dmat3` or `dmat4` passed through as doubles.  The
+ * pointer for each column is set up with the next free index, and an offset
+ * advanced by the size of a column.  _size_ is the number of rows, and
+ * _type_ must be a floating-point type.
+ *
+ * If _stride_ is zero, the matrices are assumed to be tightly packed one after
+ * another, rather than each column after the last.
+ *
+ * @param pointer Vertex attribute pointer for the first column
+ * @param columns Number of columns in the matrix, from one to four
+ * @throws logic_error if checking and vertex array object is not bound, or if a buffer object is not bound to `GL_ARRAY_BUFFER`
+ * @throws invalid_argument if checking and vertex attribute pointer or number of columns is invalid
+ * @see @ref enableMatrixAttribArray
+ */
+void VertexArrayObject::matrixAttribPointer(const VertexAttribPointer& pointer, const GLsizei columns) const {
+
+    // Check columns
+    if (GLOOP_CHECKS && ((columns < 1) || (columns > 4))) {
+        throw invalid_argument("[VertexArrayObject] Columns must be 1, 2, 3, or 4!");
+    }
+
+    // Determine size of a column
+    GLsizei component;
+    switch (pointer._type) {
+    case GL_HALF_FLOAT:
+        component = sizeof(GLhalf);
+        break;
+    case GL_FLOAT:
+        component = sizeof(GLfloat);
+        break;
+    case GL_DOUBLE:
+        component = sizeof(GLdouble);
+        break;
+    default:
+        throw invalid_argument("[VertexArrayObject] Matrix type must be GL_HALF_FLOAT, GL_FLOAT or GL_DOUBLE!");
+    }
+    const GLsizei column = pointer._size * component;
+
+    // Set up a pointer for each column
+    VertexAttribPointer vap(pointer);
+    if (pointer._stride == 0) {
+        vap.stride(column * columns);
+    }
+    const GLuint step = indicesPerColumn(pointer);
+    for (GLsizei i = 0; i < columns; ++i) {
+        vap.index(pointer._index + i * step);
+        vap.offset(pointer._offset + i * column);
+        vertexAttribPointer(vap);
+    }
+}
+
+/**
+ * Determines the value of `GL_MAX_VERTEX_ATTRIB_BINDINGS`.
+ *
+ * @return Value of `GL_MAX_VERTEX_ATTRIB_BINDINGS`
+ * @throws runtime_error if vertex attribute bindings are not supported
+ */
+GLint VertexArrayObject::maxVertexAttribBindings() {
+    const Capabilities& capabilities = Context::current().capabilities();
+    if (!capabilities.hasVertexAttribBinding()) {
+        throw runtime_error("[VertexArrayObject] Vertex attribute bindings are not supported!");
+    }
+    return capabilities.maxVertexAttribBindings();
+}
+
 /**
  * Determines the value of `GL_MAX_VERTEX_ATTRIBS`.
  *
  * @return Value of `GL_MAX_VERTEX_ATTRIBS`
  */
 GLint VertexArrayObject::maxVertexAttribs() {
-    GLint value;
-    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &value);
-    return value;
+    return Context::current().capabilities().maxVertexAttribs();
+}
+
+/**
+ * Determines how values are passed to a vertex attribute declared with a type.
+ *
+ * @param shaderType Type of the vertex attribute as declared in the shader, e.g. `GL_INT_VEC4`
+ * @return `GL_INT` for signed and unsigned integer types, `GL_DOUBLE` for double-precision types, otherwise `GL_FLOAT`
+ */
+GLenum VertexArrayObject::shaderBaseType(const GLenum shaderType) {
+    switch (shaderType) {
+    case GL_INT:
+    case GL_INT_VEC2:
+    case GL_INT_VEC3:
+    case GL_INT_VEC4:
+    case GL_UNSIGNED_INT:
+    case GL_UNSIGNED_INT_VEC2:
+    case GL_UNSIGNED_INT_VEC3:
+    case GL_UNSIGNED_INT_VEC4:
+        return GL_INT;
+#ifdef GL_VERSION_4_1
+    case GL_DOUBLE:
+    case GL_DOUBLE_VEC2:
+    case GL_DOUBLE_VEC3:
+    case GL_DOUBLE_VEC4:
+    case GL_DOUBLE_MAT2:
+    case GL_DOUBLE_MAT3:
+    case GL_DOUBLE_MAT4:
+    case GL_DOUBLE_MAT2x3:
+    case GL_DOUBLE_MAT2x4:
+    case GL_DOUBLE_MAT3x2:
+    case GL_DOUBLE_MAT3x4:
+    case GL_DOUBLE_MAT4x2:
+    case GL_DOUBLE_MAT4x3:
+        return GL_DOUBLE;
+#endif
+    default:
+        return GL_FLOAT;
+    }
 }
 
 /**
@@ -247,71 +635,262 @@ bool VertexArrayObject::operator<(const VertexArrayObject& vao) const {
 /**
  * Unbinds the vertex array object represented by this handle.
  *
- * @throws logic_error if vertex array object is not already bound
+ * @throws logic_error if checking and vertex array object is not already bound
  * @see @ref bind
  */
 void VertexArrayObject::unbind() const {
-    if (!bound()) {
+    if (GLOOP_CHECKS && !bound()) {
         throw logic_error("[VertexArrayObject] Vertex array object is not already bound!");
     }
     glBindVertexArray(0);
+    Context& context = Context::current();
+    context.integer(GL_VERTEX_ARRAY_BINDING, 0);
+    context.forget(GL_ELEMENT_ARRAY_BUFFER_BINDING);
 }
 
 /**
  * Specifies the location and data format of a vertex array.
  *
+ * Vertex attributes declared in the shader as integers are set up with
+ * `glVertexAttribIPointer`, and those declared as doubles with
+ * `glVertexAttribLPointer`, so their values are not converted to floats.  See
+ * @ref VertexAttribPointer::shaderType.
+ *
  * @param pointer Vertex attribute pointer specifying the location and data format of a vertex array
- * @throws logic_error if vertex array object is not bound, or if a buffer object is not bound to `GL_ARRAY_BUFFER`
- * @throws invalid_argument if vertex attribute pointer is invalid
+ * @throws logic_error if checking and vertex array object is not bound, or if a buffer object is not bound to `GL_ARRAY_BUFFER`
+ * @throws invalid_argument if checking and vertex attribute pointer is invalid
+ * @throws runtime_error if checking and the attribute is double-precision but that is not supported
  * @see @ref enableVertexAttribArray
  */
 void VertexArrayObject::vertexAttribPointer(const VertexAttribPointer& pointer) const {
 
     // Check if bound
-    if (!bound()) {
+    if (GLOOP_CHECKS && !bound()) {
         throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
     }
 
     // Check if a buffer object is bound to the array buffer
     const BufferTarget arrayBuffer = BufferTarget::arrayBuffer();
-    if (!arrayBuffer.bound()) {
+    if (GLOOP_CHECKS && !arrayBuffer.bound()) {
         throw logic_error("[VertexArrayObject] No buffer object currently bound to GL_ARRAY_BUFFER!");
     }
 
     // Check index
-    if (pointer._index >= maxVertexAttribs()) {
+    if (GLOOP_CHECKS && (pointer._index >= (GLuint) maxVertexAttribs())) {
         throw invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS");
     }
 
     // Check size
-    if ((pointer._size < 1) || (pointer._size > 4)) {
+    if (GLOOP_CHECKS && ((pointer._size < 1) || (pointer._size > 4))) {
         throw invalid_argument("[VertexArrayObject] Size must be 1, 2, 3, or 4!");
     }
 
     // Check type
-    switch (pointer._type) {
-    case GL_BYTE:
-    case GL_UNSIGNED_BYTE:
-    case GL_SHORT:
-    case GL_UNSIGNED_SHORT:
+    if (GLOOP_CHECKS && !isVertexAttribType(pointer._type)) {
+        throw invalid_argument("[VertexArrayObject] Type is invalid!");
+    }
+
+    // Check type against shader type
+    if (GLOOP_CHECKS) {
+        checkShaderType(pointer);
+    }
+
+    // Set up pointer
+    switch (shaderBaseType(pointer._shaderType)) {
     case GL_INT:
-    case GL_UNSIGNED_INT:
-    case GL_HALF_FLOAT:
-    case GL_FLOAT:
+        glVertexAttribIPointer(
+                pointer._index,
+                pointer._size,
+                pointer._type,
+                pointer._stride,
+                (const GLvoid*) (size_t) pointer._offset);
+        break;
+#ifdef GL_VERSION_4_1
     case GL_DOUBLE:
+        glVertexAttribLPointer(
+                pointer._index,
+                pointer._size,
+                pointer._type,
+                pointer._stride,
+                (const GLvoid*) (size_t) pointer._offset);
         break;
+#endif
     default:
+        glVertexAttribPointer(
+                pointer._index,
+                pointer._size,
+                pointer._type,
+                pointer._normalized,
+                pointer._stride,
+                (const GLvoid*) (size_t) pointer._offset);
+    }
+
+    // Set divisor unless it is known to be the same
+    Context& context = Context::current();
+    GLuint divisor;
+    if (!context.findVertexAttribDivisor(pointer._index, divisor) || (divisor != pointer._divisor)) {
+        glVertexAttribDivisor(pointer._index, pointer._divisor);
+        context.vertexAttribDivisor(pointer._index, pointer._divisor);
+    }
+}
+
+/**
+ * Assigns a vertex attribute to a vertex buffer binding point.
+ *
+ * @param index Index of the vertex attribute
+ * @param binding Index of the vertex buffer binding point to read the attribute from
+ * @throws logic_error if checking and this vertex array object is not bound
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @throws invalid_argument if checking and index or binding is out of range
+ * @see @ref vertexAttribFormat
+ * @see @ref bindVertexBuffer
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribBinding.xml
+ */
+void VertexArrayObject::vertexAttribBinding(const GLuint index, const GLuint binding) const {
+
+    // Check if supported
+    if (!Context::current().capabilities().hasVertexAttribBinding()) {
+        throw runtime_error("[VertexArrayObject] Vertex attribute bindings are not supported!");
+    }
+
+    // Check if bound
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
+    }
+
+    // Check binding
+    if (GLOOP_CHECKS && (binding >= (GLuint) maxVertexAttribBindings())) {
+        throw invalid_argument("[VertexArrayObject] Binding is greater than or equal to GL_MAX_VERTEX_ATTRIB_BINDINGS!");
+    }
+
+    // Check index
+    if (GLOOP_CHECKS && (index >= (GLuint) maxVertexAttribs())) {
+        throw invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS!");
+    }
+
+    // Assign it
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    glVertexAttribBinding(index, binding);
+    Context::current().forgetVertexAttribDivisors(_id);
+#endif
+}
+
+/**
+ * Specifies the data format of a vertex attribute, separately from where its vertices are stored.
+ *
+ * Only the index, size, type, normalization, shader type and offset of the
+ * pointer are used, with the offset taken relative to the start of each
+ * vertex.  The stride and divisor belong to the vertex buffer binding point
+ * the attribute is assigned to, and are given with @ref bindVertexBuffer and
+ * @ref vertexBindingDivisor instead.
+ *
+ * ~~~
+ *     vao.vertexAttribFormat(VertexAttribPointer()
+ *             .index(0)
+ *             .size(3)
+ *             .type(GL_FLOAT)
+ *             .offset(offsetof(Vertex, position)));
+ *     vao.vertexAttribBinding(0, 0);
+ *     vao.enableVertexAttribArray(0);
+ *     ...
+ *     vao.bindVertexBuffer(0, myBufferObject, 0, sizeof(Vertex));
+ * ~~~
+ *
+ * @param pointer Vertex attribute pointer specifying the data format of the attribute
+ * @throws logic_error if checking and this vertex array object is not bound
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @throws invalid_argument if checking and vertex attribute pointer is invalid
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribFormat.xml
+ */
+void VertexArrayObject::vertexAttribFormat(const VertexAttribPointer& pointer) const {
+
+    // Check if supported
+    if (!Context::current().capabilities().hasVertexAttribBinding()) {
+        throw runtime_error("[VertexArrayObject] Vertex attribute bindings are not supported!");
+    }
+
+    // Check if bound
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
+    }
+
+    // Check index
+    if (GLOOP_CHECKS && (pointer._index >= (GLuint) maxVertexAttribs())) {
+        throw invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS!");
+    }
+
+    // Check size
+    if (GLOOP_CHECKS && ((pointer._size < 1) || (pointer._size > 4))) {
+        throw invalid_argument("[VertexArrayObject] Size must be 1, 2, 3, or 4!");
+    }
+
+    // Check type
+    if (GLOOP_CHECKS && !isVertexAttribType(pointer._type)) {
         throw invalid_argument("[VertexArrayObject] Type is invalid!");
     }
 
-    // Set up pointer
-    glVertexAttribPointer(
-            pointer._index,
-            pointer._size,
-            pointer._type,
-            pointer._normalized,
-            pointer._stride,
-            (const GLvoid*) pointer._offset);
+    // Check offset
+    if (GLOOP_CHECKS && (pointer._offset < 0)) {
+        throw invalid_argument("[VertexArrayObject] Offset must not be negative!");
+    }
+
+    // Check type against shader type
+    if (GLOOP_CHECKS) {
+        checkShaderType(pointer);
+    }
+
+    // Specify format
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    switch (shaderBaseType(pointer._shaderType)) {
+    case GL_INT:
+        glVertexAttribIFormat(pointer._index, pointer._size, pointer._type, pointer._offset);
+        break;
+    case GL_DOUBLE:
+        glVertexAttribLFormat(pointer._index, pointer._size, pointer._type, pointer._offset);
+        break;
+    default:
+        glVertexAttribFormat(
+                pointer._index,
+                pointer._size,
+                pointer._type,
+                pointer._normalized,
+                pointer._offset);
+    }
+#endif
+}
+
+/**
+ * Changes how often the vertices of a vertex buffer binding point advance during instanced drawing.
+ *
+ * @param binding Index of the vertex buffer binding point
+ * @param divisor Number of instances per vertex, or `0` to advance once per vertex
+ * @throws logic_error if checking and this vertex array object is not bound
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @throws invalid_argument if checking and binding is greater than or equal to `GL_MAX_VERTEX_ATTRIB_BINDINGS`
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexBindingDivisor.xml
+ */
+void VertexArrayObject::vertexBindingDivisor(const GLuint binding, const GLuint divisor) const {
+
+    // Check if supported
+    if (!Context::current().capabilities().hasVertexAttribBinding()) {
+        throw runtime_error("[VertexArrayObject] Vertex attribute bindings are not supported!");
+    }
+
+    // Check if bound
+    if (GLOOP_CHECKS && !bound()) {
+        throw logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
+    }
+
+    // Check binding
+    if (GLOOP_CHECKS && (binding >= (GLuint) maxVertexAttribBindings())) {
+        throw invalid_argument("[VertexArrayObject] Binding is greater than or equal to GL_MAX_VERTEX_ATTRIB_BINDINGS!");
+    }
+
+    // Change it
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    glVertexBindingDivisor(binding, divisor);
+    Context::current().forgetVertexAttribDivisors(_id);
+#endif
 }
 
 } /* namespace Gloop */
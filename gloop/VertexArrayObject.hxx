@@ -26,8 +26,15 @@
 #ifndef GLOOP_VERTEXARRAYOBJECT_HXX
 #define GLOOP_VERTEXARRAYOBJECT_HXX
 #include "gloop/common.h"
+#include <stdexcept>
+#include <vector>
 #include "gloop/VertexAttribPointer.hxx"
+#include "gloop/VertexLayout.hxx"
+#include "gloop/BufferAllocation.hxx"
 #include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+#include "gloop/DeletionQueue.hxx"
+#include "gloop/NamePool.hxx"
 namespace Gloop {
 
 
@@ -91,6 +98,60 @@ namespace Gloop {
  *     vao.enableVertexAttribArray(pointer.index);
  * ~~~
  *
+ * Per-instance data, such as a transform for each instance, is set up the same
+ * way but with a _divisor_, so the value only advances once per instance.  A
+ * `mat4` attribute takes four consecutive locations, one for each column, which
+ * @ref matrixAttribPointer and @ref enableMatrixAttribArray set up together.
+ * Columns of a `dmat3` or `dmat4` take two locations each, so enable those by
+ * passing the pointer instead of just its index.
+ * Draw it with an instanced @ref DrawCommand.
+ *
+ * ~~~
+ *     const GLuint location = myShaderProgram.attribLocation("ModelMatrix");
+ *     arrayBuffer.bind(myInstanceBufferObject);
+ *     vao.matrixAttribPointer(VertexAttribPointer()
+ *             .index(location)
+ *             .size(4)
+ *             .divisor(1), 4);
+ *     vao.enableMatrixAttribArray(location, 4);
+ * ~~~
+ *
+ * Integer and double-precision attributes declared in the shader, such as an
+ * `ivec4` of bone indices, should be given their declared type with @ref
+ * VertexAttribPointer::shaderType, so their values reach the shader without
+ * being converted to floats and back.  @ref VertexAttribPointer::attribute
+ * takes both the index and the declared type from an active attribute.
+ *
+ * ~~~
+ *     const map<string,Attribute> attributes = myShaderProgram.activeAttributes();
+ *     vao.vertexAttribPointer(VertexAttribPointer()
+ *             .attribute(attributes.find("BoneIndices")->second)
+ *             .size(4)
+ *             .type(GL_UNSIGNED_BYTE));
+ * ~~~
+ *
+ * When every attribute comes from one buffer of vertex structures, describe
+ * them with a @ref VertexLayout instead, and set up and enable all of the
+ * pointers with a single call to @ref vertexLayout.
+ *
+ * ~~~
+ *     arrayBuffer.bind(myBufferObject);
+ *     vao.vertexLayout<MyVertexFormat>();
+ * ~~~
+ *
+ * Where vertex attribute bindings are supported, the format of each vertex
+ * array can be specified apart from the buffer object it is stored in, using
+ * @ref vertexAttribFormat and @ref vertexAttribBinding.  One vertex array
+ * object then serves every mesh with that format, and switching meshes only
+ * takes one call to @ref bindVertexBuffer, which works with a range handed out
+ * by a @ref BufferHeap too.
+ *
+ * ~~~
+ *     vao.vertexLayout<MyVertexFormat>(0);
+ *     ...
+ *     vao.bindVertexBuffer(0, myAllocation, MyVertexFormat::stride);
+ * ~~~
+ *
  * From there, repeat the process with other vertex arrays, then unbind the
  * vertex array object until you need to use it for rendering, or to change it
  * again later.
@@ -98,6 +159,12 @@ namespace Gloop {
  * ~~~
  *     vao.unbind();
  * ~~~
+ *
+ * Each of these methods checks that it is being used correctly, for example
+ * that the vertex array object is bound, and throws an exception if not.  Since
+ * several of the checks have to query OpenGL, they are only made when Gloop
+ * was built with a checking policy that allows them.  See `GLOOP_CHECKING` in
+ * `gloop/common.h`.
  */
 class VertexArrayObject {
 public:
@@ -105,27 +172,122 @@ public:
     VertexArrayObject(const VertexArrayObject& vao);
     ~VertexArrayObject();
     void bind() const;
+    void bindVertexBuffer(GLuint binding, const BufferObject& buffer, GLintptr offset, GLsizei stride) const;
+    void bindVertexBuffer(GLuint binding, const BufferAllocation& allocation, GLsizei stride) const;
     bool bound() const;
+    void disableMatrixAttribArray(GLuint index, GLsizei columns) const;
+    void disableMatrixAttribArray(const VertexAttribPointer& pointer, GLsizei columns) const;
     void disableVertexAttribArray(GLuint index) const;
     void dispose() const;
+    void dispose(DeletionQueue& queue) const;
+    void dispose(NamePool& pool) const;
+    void enableMatrixAttribArray(GLuint index, GLsizei columns) const;
+    void enableMatrixAttribArray(const VertexAttribPointer& pointer, GLsizei columns) const;
     void enableVertexAttribArray(GLuint index) const;
     static VertexArrayObject fromId(GLuint id);
     static VertexArrayObject generate();
+    static std::vector<VertexArrayObject> generate(GLsizei n);
+    static VertexArrayObject generate(NamePool& pool);
     GLuint id() const;
+    void matrixAttribPointer(const VertexAttribPointer& pointer, GLsizei columns) const;
     VertexArrayObject& operator=(const VertexArrayObject& vao);
     bool operator==(const VertexArrayObject& vao) const;
     bool operator!=(const VertexArrayObject& vao) const;
     bool operator<(const VertexArrayObject& vao) const;
     void unbind() const;
+    void vertexAttribBinding(GLuint index, GLuint binding) const;
+    void vertexAttribFormat(const VertexAttribPointer& pointer) const;
     void vertexAttribPointer(const VertexAttribPointer& pointer) const;
+    void vertexBindingDivisor(GLuint binding, GLuint divisor) const;
+    template<typename FORMAT> void vertexLayout() const;
+    template<typename FORMAT> void vertexLayout(GLuint binding) const;
 private:
 // Attributes
     GLuint _id;
 // Methods
     VertexArrayObject();
     explicit VertexArrayObject(GLuint id);
+    static void checkShaderType(const VertexAttribPointer& pointer);
+    static GLuint indicesPerColumn(const VertexAttribPointer& pointer);
+    static bool isIntegerVertexAttribType(GLenum enumeration);
+    static bool isVertexAttribType(GLenum enumeration);
+    static GLint maxVertexAttribBindings();
     static int maxVertexAttribs();
+    static GLenum shaderBaseType(GLenum shaderType);
 };
 
+/**
+ * Sets up and enables the pointers for every attribute of a vertex structure at once.
+ *
+ * The parameters of each pointer are fixed at compile time by the format, so
+ * only the vertex array object, the array buffer and the largest index are
+ * checked, once for the whole format.
+ *
+ * @throws logic_error if checking and vertex array object is not bound, or if a buffer object is not bound to `GL_ARRAY_BUFFER`
+ * @throws invalid_argument if checking and an index is greater than or equal to `GL_MAX_VERTEX_ATTRIBS`
+ * @see @ref VertexLayout
+ */
+template<typename FORMAT>
+void VertexArrayObject::vertexLayout() const {
+
+    // Check if bound
+    if (GLOOP_CHECKS && !bound()) {
+        throw std::logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
+    }
+
+    // Check if a buffer object is bound to the array buffer
+    if (GLOOP_CHECKS && !BufferTarget::arrayBuffer().bound()) {
+        throw std::logic_error("[VertexArrayObject] No buffer object currently bound to GL_ARRAY_BUFFER!");
+    }
+
+    // Check largest index
+    if (GLOOP_CHECKS && (FORMAT::index >= maxVertexAttribs())) {
+        throw std::invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS");
+    }
+
+    // Set up pointers
+    FORMAT::apply();
+}
+
+/**
+ * Specifies the format of every attribute of a vertex structure at once, reading from one binding point.
+ *
+ * No buffer object needs to be bound.  Bind one to the binding point with
+ * @ref bindVertexBuffer, using the stride of the format.  The divisor of the
+ * binding point is left as it was.
+ *
+ * @param binding Index of the vertex buffer binding point to assign every attribute to
+ * @throws logic_error if checking and vertex array object is not bound
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @throws invalid_argument if checking and binding or an index is out of range
+ * @see @ref VertexLayout
+ */
+template<typename FORMAT>
+void VertexArrayObject::vertexLayout(const GLuint binding) const {
+
+    // Check if supported
+    if (!Context::current().capabilities().hasVertexAttribBinding()) {
+        throw std::runtime_error("[VertexArrayObject] Vertex attribute bindings are not supported!");
+    }
+
+    // Check if bound
+    if (GLOOP_CHECKS && !bound()) {
+        throw std::logic_error("[VertexArrayObject] Vertex array object is not currently bound!");
+    }
+
+    // Check binding
+    if (GLOOP_CHECKS && (binding >= (GLuint) maxVertexAttribBindings())) {
+        throw std::invalid_argument("[VertexArrayObject] Binding is greater than or equal to GL_MAX_VERTEX_ATTRIB_BINDINGS!");
+    }
+
+    // Check largest index
+    if (GLOOP_CHECKS && (FORMAT::index >= maxVertexAttribs())) {
+        throw std::invalid_argument("[VertexArrayObject] Index is greater than or equal to GL_MAX_VERTEX_ATTRIBS");
+    }
+
+    // Specify formats
+    FORMAT::bind(binding);
+}
+
 } /* namespace Gloop */
 #endif
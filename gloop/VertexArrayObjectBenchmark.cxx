@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <GL/glfw.h>
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include "gloop/VertexAttribPointer.hxx"
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Benchmark for setting up vertex array objects.
+ *
+ * Sets up pointers for a position, normal, color, and texture coordinate in
+ * each of many vertex array objects, which is dominated by the checks made
+ * under the checking policy Gloop was built with.  Configure Gloop with each
+ * policy in turn to compare them.
+ */
+class VertexArrayObjectBenchmark {
+public:
+
+    /**
+     * Number of vertex array objects to set up.
+     */
+    static const int COUNT = 10000;
+
+    /**
+     * Returns the name of the checking policy Gloop was built with.
+     */
+    static const char* getCheckingPolicy() {
+        switch (GLOOP_CHECKING) {
+        case GLOOP_CHECKING_CHECKED:
+            return "checked";
+        case GLOOP_CHECKING_DEBUG:
+            return GLOOP_CHECKS ? "debug (checking)" : "debug (not checking)";
+        default:
+            return "unchecked";
+        }
+    }
+
+    /**
+     * Times setting up the vertex array objects, returning the number of seconds it took.
+     */
+    double run() {
+
+        // Make a buffer for the vertex arrays to point into
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget arrayBuffer = BufferTarget::arrayBuffer();
+        arrayBuffer.bind(bo);
+        arrayBuffer.data(1024, NULL, GL_STATIC_DRAW);
+
+        // Make the vertex array objects
+        vector<VertexArrayObject> vaos;
+        vaos.reserve(COUNT);
+        for (int i = 0; i < COUNT; ++i) {
+            vaos.push_back(VertexArrayObject::generate());
+        }
+
+        // Describe the vertex arrays
+        VertexAttribPointer pointers[4];
+        pointers[0].index(0).size(3).type(GL_FLOAT).stride(48).offset(0);
+        pointers[1].index(1).size(3).type(GL_FLOAT).stride(48).offset(12);
+        pointers[2].index(2).size(4).type(GL_UNSIGNED_BYTE).normalized(true).stride(48).offset(24);
+        pointers[3].index(3).size(2).type(GL_FLOAT).stride(48).offset(28);
+
+        // Set them up
+        glFinish();
+        const double start = glfwGetTime();
+        for (int i = 0; i < COUNT; ++i) {
+            vaos[i].bind();
+            for (int j = 0; j < 4; ++j) {
+                vaos[i].vertexAttribPointer(pointers[j]);
+                vaos[i].enableVertexAttribArray(j);
+            }
+            vaos[i].unbind();
+        }
+        glFinish();
+        const double elapsed = glfwGetTime() - start;
+
+        // Clean up
+        for (int i = 0; i < COUNT; ++i) {
+            vaos[i].dispose();
+        }
+        arrayBuffer.unbind(bo);
+        bo.dispose();
+        return elapsed;
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the benchmark
+    VertexArrayObjectBenchmark benchmark;
+    try {
+        const double elapsed = benchmark.run();
+        cout << "VertexArrayObjectBenchmark: "
+             << VertexArrayObjectBenchmark::COUNT << " vertex array objects, "
+             << VertexArrayObjectBenchmark::getCheckingPolicy() << ": "
+             << fixed << setprecision(2) << (elapsed * 1000) << " ms" << endl;
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
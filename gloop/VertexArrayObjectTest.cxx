@@ -26,12 +26,30 @@
 #include "config.h"
 #include <stdexcept>
 #include "gloop/VertexArrayObject.hxx"
+#include "gloop/Program.hxx"
+#include "gloop/Shader.hxx"
 #include <cppunit/extensions/HelperMacros.h>
 #include <GL/glfw.h>
 using namespace std;
 using namespace Gloop;
 
 
+const char* VERTEX_SHADER =
+        "#version 140\n"
+        "in vec4 MCVertex;\n"
+        "in uvec4 BoneIndices;\n"
+        "void main() {\n"
+        "    gl_Position = MCVertex + vec4(BoneIndices);\n"
+        "}\n";
+
+const char* FRAGMENT_SHADER =
+        "#version 140\n"
+        "out vec4 FragColor;\n"
+        "void main() {\n"
+        "    FragColor = vec4(1);\n"
+        "}\n";
+
+
 /**
  * Unit test for VertexArrayObject.
  */
@@ -81,6 +99,25 @@ public:
         CPPUNIT_ASSERT(vao.id() > 0);
     }
 
+    /**
+     * Ensures disabling a vertex array after enabling it works correctly.
+     */
+    void testDisableVertexAttribArray() {
+
+        // Enable then disable a vertex array
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        vao.enableVertexAttribArray(0);
+        vao.disableVertexAttribArray(0);
+
+        // Check it's disabled
+        GLint enabled;
+        glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, enabled);
+        vao.unbind();
+        vao.dispose();
+    }
+
     /**
      * Ensures unbinding a VAO that's already bound works correctly.
      */
@@ -120,6 +157,236 @@ public:
         throw runtime_error("Exception not caught in testUnbindWhileNotBound");
     }
 
+    /**
+     * Ensures a matrix attribute takes one index per column, with the same divisor.
+     */
+    void testMatrixAttribPointer() {
+
+        // Set up a mat4 for each instance
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        vao.matrixAttribPointer(VertexAttribPointer()
+                .index(2)
+                .size(4)
+                .type(GL_FLOAT)
+                .divisor(1), 4);
+        vao.enableMatrixAttribArray(2, 4);
+
+        // Check each column
+        for (GLuint i = 0; i < 4; ++i) {
+            GLint divisor, stride, enabled;
+            GLvoid* offset;
+            glGetVertexAttribiv(2 + i, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+            glGetVertexAttribiv(2 + i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride);
+            glGetVertexAttribiv(2 + i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+            glGetVertexAttribPointerv(2 + i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &offset);
+            CPPUNIT_ASSERT_EQUAL(1, divisor);
+            CPPUNIT_ASSERT_EQUAL(64, stride);
+            CPPUNIT_ASSERT_EQUAL(GL_TRUE, enabled);
+            CPPUNIT_ASSERT_EQUAL((GLintptr) (i * 16), (GLintptr) offset);
+        }
+
+        // Check a plain pointer resets the divisor
+        vao.vertexAttribPointer(VertexAttribPointer().index(2));
+        GLint divisor;
+        glGetVertexAttribiv(2, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+        CPPUNIT_ASSERT_EQUAL(0, divisor);
+
+        // Check the remembered divisors match OpenGL
+        Context& context = Context::current();
+        context.verifying(true);
+        GLuint remembered;
+        CPPUNIT_ASSERT(context.findVertexAttribDivisor(2, remembered));
+        CPPUNIT_ASSERT_EQUAL((GLuint) 0, remembered);
+        CPPUNIT_ASSERT(context.findVertexAttribDivisor(3, remembered));
+        CPPUNIT_ASSERT_EQUAL((GLuint) 1, remembered);
+        CPPUNIT_ASSERT(!context.findVertexAttribDivisor(7, remembered));
+        context.verifying(false);
+
+        // Check integer matrices are rejected
+        CPPUNIT_ASSERT_THROW(vao.matrixAttribPointer(VertexAttribPointer().type(GL_INT), 4), invalid_argument);
+
+        // Check columns of a dmat4 take two indices each
+        if (Context::current().capabilities().hasVertexAttrib64Bit()) {
+            const VertexAttribPointer dmat4 = VertexAttribPointer()
+                    .index(4)
+                    .size(4)
+                    .type(GL_DOUBLE)
+                    .shaderType(GL_DOUBLE_MAT4);
+            vao.matrixAttribPointer(dmat4, 4);
+            vao.enableMatrixAttribArray(dmat4, 4);
+            for (GLuint i = 0; i < 4; ++i) {
+                GLint enabled;
+                GLvoid* offset;
+                glGetVertexAttribiv(4 + i * 2, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+                glGetVertexAttribPointerv(4 + i * 2, GL_VERTEX_ATTRIB_ARRAY_POINTER, &offset);
+                CPPUNIT_ASSERT_EQUAL(GL_TRUE, enabled);
+                CPPUNIT_ASSERT_EQUAL((GLintptr) (i * 32), (GLintptr) offset);
+            }
+            vao.disableMatrixAttribArray(dmat4, 4);
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        vao.unbind();
+        bo.dispose();
+        vao.dispose();
+    }
+
+    /**
+     * Ensures vertex formats and buffer bindings can be specified separately.
+     */
+    void testVertexAttribFormat() {
+
+        // Skip if not supported
+        if (!Context::current().capabilities().hasVertexAttribBinding()) {
+            return;
+        }
+
+        // Specify two formats read from one binding point
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        vao.vertexAttribFormat(VertexAttribPointer()
+                .index(0)
+                .size(3)
+                .type(GL_FLOAT));
+        vao.vertexAttribFormat(VertexAttribPointer()
+                .index(1)
+                .size(4)
+                .type(GL_UNSIGNED_BYTE)
+                .normalized(GL_TRUE)
+                .offset(12));
+        vao.vertexAttribBinding(0, 2);
+        vao.vertexAttribBinding(1, 2);
+        vao.vertexBindingDivisor(2, 1);
+
+        // Check the formats
+        GLint offset, binding, type, normalized;
+        glGetVertexAttribiv(1, GL_VERTEX_ATTRIB_RELATIVE_OFFSET, &offset);
+        glGetVertexAttribiv(1, GL_VERTEX_ATTRIB_BINDING, &binding);
+        glGetVertexAttribiv(1, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+        glGetVertexAttribiv(1, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+        CPPUNIT_ASSERT_EQUAL(12, offset);
+        CPPUNIT_ASSERT_EQUAL(2, binding);
+        CPPUNIT_ASSERT_EQUAL(GL_UNSIGNED_BYTE, type);
+        CPPUNIT_ASSERT_EQUAL(GL_TRUE, normalized);
+
+        // Swap buffers in and check the binding point
+        const BufferObject b1 = BufferObject::generate();
+        const BufferObject b2 = BufferObject::generate();
+        GLint buffer, stride, divisor;
+        GLint64 start;
+        vao.bindVertexBuffer(2, b1, 0, 16);
+        glGetIntegeri_v(GL_VERTEX_BINDING_BUFFER, 2, &buffer);
+        CPPUNIT_ASSERT_EQUAL((GLint) b1.id(), buffer);
+        vao.bindVertexBuffer(2, BufferAllocation(b2, 256, 1024), 16);
+        glGetIntegeri_v(GL_VERTEX_BINDING_BUFFER, 2, &buffer);
+        glGetIntegeri_v(GL_VERTEX_BINDING_STRIDE, 2, &stride);
+        glGetIntegeri_v(GL_VERTEX_BINDING_DIVISOR, 2, &divisor);
+        glGetInteger64i_v(GL_VERTEX_BINDING_OFFSET, 2, &start);
+        CPPUNIT_ASSERT_EQUAL((GLint) b2.id(), buffer);
+        CPPUNIT_ASSERT_EQUAL(16, stride);
+        CPPUNIT_ASSERT_EQUAL(1, divisor);
+        CPPUNIT_ASSERT_EQUAL((GLint64) 256, start);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Check a bad binding point is rejected
+        if (GLOOP_CHECKS) {
+            const GLint max = Context::current().capabilities().maxVertexAttribBindings();
+            CPPUNIT_ASSERT_THROW(vao.vertexAttribBinding(0, max), invalid_argument);
+            CPPUNIT_ASSERT_THROW(vao.bindVertexBuffer(max, b1, 0, 16), invalid_argument);
+        }
+
+        // Clean up
+        vao.unbind();
+        b1.dispose();
+        b2.dispose();
+        vao.dispose();
+    }
+
+    /**
+     * Ensures integer and double-precision attributes are set up without conversion to floats.
+     */
+    void testVertexAttribPointerWithShaderType() {
+
+        // Make a program with an integer attribute
+        const Shader vs = Shader::create(GL_VERTEX_SHADER);
+        vs.source(VERTEX_SHADER);
+        vs.compile();
+        const Shader fs = Shader::create(GL_FRAGMENT_SHADER);
+        fs.source(FRAGMENT_SHADER);
+        fs.compile();
+        const Program program = Program::create();
+        program.attachShader(vs);
+        program.attachShader(fs);
+        program.link();
+        const map<string,Attribute> attributes = program.activeAttributes();
+        const Attribute& boneIndices = attributes.find("BoneIndices")->second;
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_INT_VEC4, boneIndices.type());
+
+        // Set up a pointer using the declared type
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        vao.vertexAttribPointer(VertexAttribPointer()
+                .attribute(boneIndices)
+                .size(4)
+                .type(GL_UNSIGNED_BYTE));
+        GLint integer;
+        glGetVertexAttribiv(boneIndices.location(), GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+        CPPUNIT_ASSERT_EQUAL(GL_TRUE, integer);
+
+        // Check a float attribute is still converted
+        vao.vertexAttribPointer(VertexAttribPointer()
+                .index(boneIndices.location())
+                .size(4)
+                .type(GL_UNSIGNED_BYTE));
+        glGetVertexAttribiv(boneIndices.location(), GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, integer);
+
+        // Set up a double-precision pointer
+        if (Context::current().capabilities().hasVertexAttrib64Bit()) {
+            vao.vertexAttribPointer(VertexAttribPointer()
+                    .index(0)
+                    .size(3)
+                    .type(GL_DOUBLE)
+                    .shaderType(GL_DOUBLE_VEC3));
+            GLint type;
+            glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+            CPPUNIT_ASSERT_EQUAL(GL_DOUBLE, type);
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Check types that cannot be passed through are rejected
+        if (GLOOP_CHECKS) {
+            CPPUNIT_ASSERT_THROW(vao.vertexAttribPointer(VertexAttribPointer()
+                    .shaderType(GL_INT_VEC4)
+                    .type(GL_FLOAT)), invalid_argument);
+            CPPUNIT_ASSERT_THROW(vao.vertexAttribPointer(VertexAttribPointer()
+                    .shaderType(GL_INT_VEC4)
+                    .type(GL_SHORT)
+                    .normalized(GL_TRUE)), invalid_argument);
+            CPPUNIT_ASSERT_THROW(vao.vertexAttribPointer(VertexAttribPointer()
+                    .shaderType(GL_DOUBLE_VEC4)
+                    .type(GL_FLOAT)), invalid_argument);
+        }
+
+        // Clean up
+        bt.unbind(bo);
+        vao.unbind();
+        bo.dispose();
+        vao.dispose();
+        program.dispose();
+        vs.dispose();
+        fs.dispose();
+    }
+
     /**
      * Ensures setting a pointer with a bad index throws an exception.
      */
@@ -216,6 +483,7 @@ public:
         glGenVertexArrays(1, &id);
         CPPUNIT_ASSERT(id > 0);
         glBindVertexArray(id);
+        Context::current().invalidate();
         const VertexArrayObject vao = VertexArrayObject::fromId(id);
         CPPUNIT_ASSERT_EQUAL((GLuint) id, vao.id());
     }
@@ -245,11 +513,17 @@ int main(int argc, char* argv[]) {
         test.testAddToStlMap();
         test.testAddToStlVector();
         test.testUnbindWhileBound();
-        test.testUnbindWhileNotBound();
-        test.testEnableVertexAttribArrayWithBadIndex();
-        test.testVertexAttribPointerWithBadIndex();
-        test.testVertexAttribPointerWithLowSize();
-        test.testVertexAttribPointerWithHighSize();
+        test.testDisableVertexAttribArray();
+        test.testMatrixAttribPointer();
+        test.testVertexAttribFormat();
+        test.testVertexAttribPointerWithShaderType();
+        if (GLOOP_CHECKS) {
+            test.testUnbindWhileNotBound();
+            test.testEnableVertexAttribArrayWithBadIndex();
+            test.testVertexAttribPointerWithBadIndex();
+            test.testVertexAttribPointerWithLowSize();
+            test.testVertexAttribPointerWithHighSize();
+        }
     } catch (exception& e) {
         cerr << e.what() << endl;
         throw;
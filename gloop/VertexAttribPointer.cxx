@@ -37,6 +37,8 @@ VertexAttribPointer::VertexAttribPointer() {
    _normalized = GL_FALSE;
    _stride = 0;
    _offset = 0;
+   _divisor = 0;
+   _shaderType = GL_FLOAT;
 }
 
 /**
@@ -211,4 +213,74 @@ VertexAttribPointer& VertexAttribPointer::offset(const GLsizei offset) {
     return (*this);
 }
 
+/**
+ * Specifies how many instances are drawn before advancing to the next value in the vertex array.
+ *
+ * Normally each vertex gets its own value from the vertex array.  With a
+ * non-zero _divisor_, the vertex attribute instead advances once every
+ * _divisor_ instances when drawing with an instanced command, such as
+ * `glDrawElementsInstanced`, so every vertex of an instance gets the same
+ * value.  That way per-instance data, such as a transform or a color, can be
+ * fed to thousands of instances with one draw call.
+ *
+ * By default _divisor_ is set to zero, meaning the value advances every vertex.
+ *
+ * @param divisor Number of instances drawn with each value, or zero to advance every vertex
+ * @return Reference to this _VertexAttribPointer_ to support chaining
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glVertexAttribDivisor.xml
+ */
+VertexAttribPointer& VertexAttribPointer::divisor(const GLuint divisor) {
+    this->_divisor = divisor;
+    return (*this);
+}
+
+/**
+ * Specifies the type of the vertex attribute as declared in the shader.
+ *
+ * The declared type decides how the values in the vertex array reach the
+ * shader.  Values for a floating-point attribute, such as a `vec4`, are
+ * converted to floats with `glVertexAttribPointer`.  Values for an integer
+ * attribute, such as an `ivec4` of bone indices, are passed through unchanged
+ * with `glVertexAttribIPointer`, in which case _type_ must be an integer type
+ * and _normalized_ is not allowed.  Values for a double-precision attribute,
+ * such as a `dvec3`, are passed through with `glVertexAttribLPointer`, in
+ * which case _type_ must be `GL_DOUBLE`.
+ *
+ * Any of the types reported by `glGetActiveAttrib` can be given, for example
+ * `GL_UNSIGNED_INT_VEC4` or `GL_DOUBLE_MAT4`, as well as the plain
+ * `GL_FLOAT`, `GL_INT`, `GL_UNSIGNED_INT`, and `GL_DOUBLE`.
+ *
+ * By default _shaderType_ is set to `GL_FLOAT`.
+ *
+ * @param shaderType Type of the vertex attribute as declared in the shader
+ * @return Reference to this _VertexAttribPointer_ to support chaining
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribPointer.xml
+ */
+VertexAttribPointer& VertexAttribPointer::shaderType(const GLenum shaderType) {
+    this->_shaderType = shaderType;
+    return (*this);
+}
+
+/**
+ * Specifies the index and shader type from an active attribute of a linked program.
+ *
+ * ~~~
+ *     const map<string,Attribute> attributes = myShaderProgram.activeAttributes();
+ *     vao.vertexAttribPointer(VertexAttribPointer()
+ *             .attribute(attributes.find("BoneIndices")->second)
+ *             .size(4)
+ *             .type(GL_UNSIGNED_BYTE));
+ * ~~~
+ *
+ * @param attribute Active attribute found with @ref Program::activeAttributes
+ * @return Reference to this _VertexAttribPointer_ to support chaining
+ * @see @ref index
+ * @see @ref shaderType
+ */
+VertexAttribPointer& VertexAttribPointer::attribute(const Attribute& attribute) {
+    this->_index = attribute.location();
+    this->_shaderType = attribute.type();
+    return (*this);
+}
+
 } /* namespace Gloop */
@@ -26,6 +26,7 @@
 #ifndef GLOOP_VERTEXATTRIBPOINTER_HXX
 #define GLOOP_VERTEXATTRIBPOINTER_HXX
 #include "gloop/common.h"
+#include "gloop/Attribute.hxx"
 namespace Gloop {
 
 
@@ -98,6 +99,9 @@ public:
     VertexAttribPointer& normalized(GLboolean normalized);
     VertexAttribPointer& stride(GLsizei stride);
     VertexAttribPointer& offset(GLsizei offset);
+    VertexAttribPointer& divisor(GLuint divisor);
+    VertexAttribPointer& shaderType(GLenum shaderType);
+    VertexAttribPointer& attribute(const Attribute& attribute);
 private:
 // Attributes
     GLuint _index;
@@ -106,6 +110,8 @@ private:
     GLboolean _normalized;
     GLsizei _stride;
     GLsizei _offset;
+    GLuint _divisor;
+    GLenum _shaderType;
 // Friends
     friend class VertexArrayObject;
     friend class VertexAttribPointerTest;
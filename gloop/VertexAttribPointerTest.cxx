@@ -12,6 +12,15 @@ namespace Gloop {
 class VertexAttribPointerTest : public CppUnit::TestFixture {
 public:
 
+    /**
+     * Ensures that `divisor(GLuint)` sets `_divisor` properly.
+     */
+    void testDivisor() {
+        VertexAttribPointer vap;
+        vap.divisor(2);
+        CPPUNIT_ASSERT_EQUAL((GLuint) 2, vap._divisor);
+    }
+
     /**
      * Ensures that `index(GLuint)` sets `_index` properly.
      */
@@ -39,6 +48,15 @@ public:
         CPPUNIT_ASSERT_EQUAL((GLsizei) 12, vap._offset);
     }
 
+    /**
+     * Ensures that `shaderType(GLenum)` sets `_shaderType` properly.
+     */
+    void testShaderType() {
+        VertexAttribPointer vap;
+        vap.shaderType(GL_UNSIGNED_INT_VEC4);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_UNSIGNED_INT_VEC4, vap._shaderType);
+    }
+
     /**
      * Ensures that `size(GLint)` sets `_size` properly.
      */
@@ -76,12 +94,16 @@ public:
         CPPUNIT_ASSERT_EQUAL(4, vap._size);
         CPPUNIT_ASSERT_EQUAL((GLboolean) GL_FALSE, vap._normalized);
         CPPUNIT_ASSERT_EQUAL(0, vap._stride);
+        CPPUNIT_ASSERT_EQUAL((GLuint) 0, vap._divisor);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_FLOAT, vap._shaderType);
     }
 
     CPPUNIT_TEST_SUITE(VertexAttribPointerTest);
+    CPPUNIT_TEST(testDivisor);
     CPPUNIT_TEST(testIndex);
     CPPUNIT_TEST(testNormalized);
     CPPUNIT_TEST(testOffset);
+    CPPUNIT_TEST(testShaderType);
     CPPUNIT_TEST(testSize);
     CPPUNIT_TEST(testStride);
     CPPUNIT_TEST(testType);
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include "gloop/VertexLayout.hxx"
+#include "gloop/Context.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Assigns a vertex attribute whose format was just specified to a vertex buffer binding point and enables it.
+ *
+ * @param index Location of the vertex attribute
+ * @param binding Index of the vertex buffer binding point
+ */
+void VertexLayout::attach(const GLuint index, const GLuint binding) {
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    glVertexAttribBinding(index, binding);
+    glEnableVertexAttribArray(index);
+#else
+    throw runtime_error("[VertexLayout] Vertex attribute bindings are not supported!");
+#endif
+}
+
+/**
+ * Resets the divisor of a vertex attribute whose pointer was just set up and enables it.
+ *
+ * @param index Location of the vertex attribute
+ */
+void VertexLayout::enable(const GLuint index) {
+
+    // Reset divisor unless it is known to be zero already
+    Context& context = Context::current();
+    GLuint divisor;
+    if (!context.findVertexAttribDivisor(index, divisor) || (divisor != 0)) {
+        glVertexAttribDivisor(index, 0);
+        context.vertexAttribDivisor(index, 0);
+    }
+
+    glEnableVertexAttribArray(index);
+}
+
+/**
+ * Specifies the format of a float vertex attribute, assigns it to a vertex buffer binding point and enables it.
+ *
+ * Called by the attributes of a format once their parameters are known, so it
+ * makes no checks of its own.
+ *
+ * @param index Location of the vertex attribute
+ * @param size Number of components per vertex
+ * @param type Type of each component, e.g. `GL_FLOAT`
+ * @param normalized Whether fixed-point components are mapped to `[0, 1]` or `[-1, 1]`
+ * @param offset Offset of the first component from the start of each vertex, in bytes
+ * @param binding Index of the vertex buffer binding point
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribFormat.xml
+ */
+void VertexLayout::Functions<GL_FLOAT>::format(const GLuint index,
+                                               const GLint size,
+                                               const GLenum type,
+                                               const GLboolean normalized,
+                                               const GLuint offset,
+                                               const GLuint binding) {
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    glVertexAttribFormat(index, size, type, normalized, offset);
+#endif
+    attach(index, binding);
+}
+
+/**
+ * Sets up and enables a pointer to a float vertex array in the buffer bound to `GL_ARRAY_BUFFER`.
+ *
+ * Called by the attributes of a format once their parameters are known, so it
+ * makes no checks of its own.
+ *
+ * @param index Location of the vertex attribute
+ * @param size Number of components per vertex
+ * @param type Type of each component, e.g. `GL_FLOAT`
+ * @param normalized Whether fixed-point components are mapped to `[0, 1]` or `[-1, 1]`
+ * @param stride Bytes between vertices
+ * @param offset Offset of the first component in the buffer, in bytes
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glVertexAttribPointer.xml
+ */
+void VertexLayout::Functions<GL_FLOAT>::pointer(const GLuint index,
+                                                const GLint size,
+                                                const GLenum type,
+                                                const GLboolean normalized,
+                                                const GLsizei stride,
+                                                const size_t offset) {
+    glVertexAttribPointer(index, size, type, normalized, stride, (const GLvoid*) offset);
+    enable(index);
+}
+
+/**
+ * Specifies the format of an integer vertex attribute, assigns it to a vertex buffer binding point and enables it.
+ *
+ * @param index Location of the vertex attribute
+ * @param size Number of components per vertex
+ * @param type Type of each component, e.g. `GL_INT`
+ * @param offset Offset of the first component from the start of each vertex, in bytes
+ * @param binding Index of the vertex buffer binding point
+ * @throws runtime_error if vertex attribute bindings are not supported
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribFormat.xml
+ */
+void VertexLayout::Functions<GL_INT>::format(const GLuint index,
+                                             const GLint size,
+                                             const GLenum type,
+                                             const GLboolean,
+                                             const GLuint offset,
+                                             const GLuint binding) {
+#ifdef GL_MAX_VERTEX_ATTRIB_BINDINGS
+    glVertexAttribIFormat(index, size, type, offset);
+#endif
+    attach(index, binding);
+}
+
+/**
+ * Sets up and enables a pointer to an integer vertex array in the buffer bound to `GL_ARRAY_BUFFER`.
+ *
+ * @param index Location of the vertex attribute
+ * @param size Number of components per vertex
+ * @param type Type of each component, e.g. `GL_INT`
+ * @param stride Bytes between vertices
+ * @param offset Offset of the first component in the buffer, in bytes
+ * @see http://www.opengl.org/sdk/docs/man3/xhtml/glVertexAttribPointer.xml
+ */
+void VertexLayout::Functions<GL_INT>::pointer(const GLuint index,
+                                              const GLint size,
+                                              const GLenum type,
+                                              const GLboolean,
+                                              const GLsizei stride,
+                                              const size_t offset) {
+    glVertexAttribIPointer(index, size, type, stride, (const GLvoid*) offset);
+    enable(index);
+}
+
+/**
+ * Specifies the format of a double vertex attribute, assigns it to a vertex buffer binding point and enables it.
+ *
+ * @param index Location of the vertex attribute
+ * @param size Number of components per vertex
+ * @param type Type of each component, i.e. `GL_DOUBLE`
+ * @param offset Offset of the first component from the start of each vertex, in bytes
+ * @param binding Index of the vertex buffer binding point
+ * @throws runtime_error if vertex attribute bindings or double-precision attributes are not supported
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribFormat.xml
+ */
+void VertexLayout::Functions<GL_DOUBLE>::format(const GLuint index,
+                                                const GLint size,
+                                                const GLenum type,
+                                                const GLboolean,
+                                                const GLuint offset,
+                                                const GLuint binding) {
+#if defined(GL_VERSION_4_1) && defined(GL_MAX_VERTEX_ATTRIB_BINDINGS)
+    glVertexAttribLFormat(index, size, type, offset);
+    attach(index, binding);
+#else
+    throw runtime_error("[VertexLayout] Double-precision attributes are not supported!");
+#endif
+}
+
+/**
+ * Sets up and enables a pointer to a double vertex array in the buffer bound to `GL_ARRAY_BUFFER`.
+ *
+ * @param index Location of the vertex attribute
+ * @param size Number of components per vertex
+ * @param type Type of each component, i.e. `GL_DOUBLE`
+ * @param stride Bytes between vertices
+ * @param offset Offset of the first component in the buffer, in bytes
+ * @throws runtime_error if double-precision attributes are not supported
+ * @see http://www.opengl.org/sdk/docs/man4/xhtml/glVertexAttribPointer.xml
+ */
+void VertexLayout::Functions<GL_DOUBLE>::pointer(const GLuint index,
+                                                 const GLint size,
+                                                 const GLenum type,
+                                                 const GLboolean,
+                                                 const GLsizei stride,
+                                                 const size_t offset) {
+#ifdef GL_VERSION_4_1
+    glVertexAttribLPointer(index, size, type, stride, (const GLvoid*) offset);
+    enable(index);
+#else
+    throw runtime_error("[VertexLayout] Double-precision attributes are not supported!");
+#endif
+}
+
+} /* namespace Gloop */
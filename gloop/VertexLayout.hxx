@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_VERTEXLAYOUT_HXX
+#define GLOOP_VERTEXLAYOUT_HXX
+#include "gloop/common.h"
+#include <cstddef>
+namespace Gloop {
+
+
+/**
+ * Description of the vertex arrays interleaved in a buffer of vertex structures.
+ *
+ * The size, type and offset of each attribute, and the stride between
+ * vertices, are computed from the vertex structure itself.  Describe each
+ * attribute with an _Attribute_ naming its location, the type of the member it
+ * reads and the member's offset, then collect the attributes into a _Format_
+ * for the vertex structure.
+ *
+ * ~~~
+ *     struct Vertex {
+ *         GLfloat position[3];
+ *         GLubyte color[4];
+ *         GLfloat coord[2];
+ *     };
+ *     typedef VertexLayout L;
+ *     typedef L::Attribute<0, Vertex, GLfloat[3], offsetof(Vertex, position)> Position;
+ *     typedef L::Attribute<1, Vertex, GLubyte[4], offsetof(Vertex, color), L::Normalized> Color;
+ *     typedef L::Attribute<2, Vertex, GLfloat[2], offsetof(Vertex, coord)> Coord;
+ *     typedef L::Format<Vertex, Position, Color, Coord> Format;
+ * ~~~
+ *
+ * Members that are integers reach the shader without being converted to
+ * floats, so declare them with an integer type like `int` or `ivec4`.  Doubles
+ * likewise need a `double` or `dvec` type, and OpenGL 4.1.  To read a member
+ * as floats instead, give the attribute a conversion: _Normalized_ maps
+ * integers to `[0, 1]` or `[-1, 1]`, and _AsFloat_ converts integers or
+ * doubles to floats of the same value.
+ *
+ * Every parameter of an attribute is a compile-time constant, including which
+ * of `glVertexAttribPointer`, `glVertexAttribIPointer` or
+ * `glVertexAttribLPointer` sets it up, so applying a format makes no decisions
+ * at run time.
+ *
+ * A format is applied to a vertex array object in a single call with @ref
+ * VertexArrayObject::vertexLayout, which sets up and enables a pointer for
+ * each attribute into the buffer bound to `GL_ARRAY_BUFFER`.
+ *
+ * ~~~
+ *     vao.bind();
+ *     arrayBuffer.bind(myBufferObject);
+ *     vao.vertexLayout<Format>();
+ * ~~~
+ *
+ * Where vertex attribute bindings are supported, the same format can instead
+ * be given to a vertex buffer binding point, after which any buffer of vertex
+ * structures is swapped in with one call.
+ *
+ * ~~~
+ *     vao.vertexLayout<Format>(0);
+ *     vao.bindVertexBuffer(0, myBufferObject, 0, Format::stride);
+ * ~~~
+ *
+ * Attributes with a size outside `1` to `4`, components OpenGL cannot read,
+ * members that would extend past the end of the vertex structure, normalized
+ * members that are not integers, or members of a different structure than the
+ * format's fail to compile.
+ */
+class VertexLayout {
+public:
+// Types
+    /**
+     * Fails to compile unless a condition is true.
+     */
+    template<bool CONDITION>
+    struct Check;
+
+    /**
+     * Whether two types are the same.
+     */
+    template<typename A, typename B>
+    struct Same {
+        enum { value = false };
+    };
+
+    /**
+     * Two types that are the same.
+     */
+    template<typename A>
+    struct Same<A,A> {
+        enum { value = true };
+    };
+
+    /**
+     * Whether an attribute reads a member of a vertex structure, or is unused.
+     */
+    template<typename A, typename VERTEX>
+    struct Reads {
+        enum { value = Same<typename A::Vertex, VERTEX>::value || Same<typename A::Vertex, void>::value };
+    };
+
+    /**
+     * Larger of two values.
+     */
+    template<std::size_t A, std::size_t B>
+    struct Max {
+        enum { value = (A > B) ? A : B };
+    };
+
+    /**
+     * Type, base type in the shader and number of components of a member of a vertex structure.
+     *
+     * The base type is `GL_INT` for integers and `GL_DOUBLE` for doubles, which
+     * reach the shader unconverted, or `GL_FLOAT`.
+     */
+    template<typename T>
+    struct Component;
+
+    /**
+     * Component type of an array member, with one component per element.
+     */
+    template<typename T, int N>
+    struct Component<T[N]> {
+        enum {
+            type = Component<T>::type,
+            base = Component<T>::base,
+            size = N
+        };
+    };
+
+    /**
+     * Attribute passed to the shader as stored, i.e. as integers, floats or doubles.
+     */
+    struct Unconverted {
+        enum { normalized = false, asFloat = false };
+    };
+
+    /**
+     * Attribute of integers mapped to floats in `[0, 1]` or `[-1, 1]`.
+     */
+    struct Normalized {
+        enum { normalized = true, asFloat = true };
+    };
+
+    /**
+     * Attribute of integers or doubles converted to floats of the same value.
+     */
+    struct AsFloat {
+        enum { normalized = false, asFloat = true };
+    };
+
+    /**
+     * OpenGL functions that set up attributes with one base type in the shader.
+     */
+    template<GLenum BASE>
+    struct Functions;
+
+    /**
+     * Vertex attribute read from a member of a vertex structure.
+     */
+    template<GLuint INDEX, typename VERTEX, typename T, std::size_t OFFSET, typename CONVERSION = Unconverted>
+    struct Attribute {
+        typedef VERTEX Vertex;
+        enum {
+            index = INDEX,
+            type = Component<T>::type,
+            size = Component<T>::size,
+            normalized = CONVERSION::normalized ? GL_TRUE : GL_FALSE,
+            base = CONVERSION::asFloat ? GL_FLOAT : Component<T>::base,
+            offset = OFFSET,
+            count = 1,
+            checked = Check<(size >= 1) && (size <= 4) && (OFFSET + sizeof(T) <= sizeof(VERTEX))
+                         && (!CONVERSION::normalized || (Component<T>::base == GL_INT))>::value
+        };
+        static void apply(GLsizei stride);
+        static void bind(GLuint binding);
+    };
+
+    /**
+     * Placeholder for an unused attribute of a format.
+     */
+    struct Unused {
+        typedef void Vertex;
+        enum { index = 0, count = 0 };
+        static void apply(GLsizei) {
+            // empty
+        }
+        static void bind(GLuint) {
+            // empty
+        }
+    };
+
+    /**
+     * Attributes interleaved in a buffer of vertex structures.
+     */
+    template<typename VERTEX,
+             typename A0,
+             typename A1 = Unused,
+             typename A2 = Unused,
+             typename A3 = Unused,
+             typename A4 = Unused,
+             typename A5 = Unused,
+             typename A6 = Unused,
+             typename A7 = Unused>
+    struct Format {
+        typedef VERTEX Vertex;
+        enum {
+            stride = sizeof(VERTEX),
+            count = A0::count + A1::count + A2::count + A3::count
+                  + A4::count + A5::count + A6::count + A7::count,
+            index = Max<Max<Max<A0::index, A1::index>::value, Max<A2::index, A3::index>::value>::value,
+                        Max<Max<A4::index, A5::index>::value, Max<A6::index, A7::index>::value>::value>::value,
+            checked = Check<Reads<A0,VERTEX>::value && Reads<A1,VERTEX>::value
+                         && Reads<A2,VERTEX>::value && Reads<A3,VERTEX>::value
+                         && Reads<A4,VERTEX>::value && Reads<A5,VERTEX>::value
+                         && Reads<A6,VERTEX>::value && Reads<A7,VERTEX>::value>::value
+        };
+        static void apply();
+        static void bind(GLuint binding);
+    };
+private:
+// Methods
+    static void attach(GLuint index, GLuint binding);
+    static void enable(GLuint index);
+};
+
+template<>
+struct VertexLayout::Check<true> {
+    enum { value = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLbyte> {
+    enum { type = GL_BYTE, base = GL_INT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLubyte> {
+    enum { type = GL_UNSIGNED_BYTE, base = GL_INT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLshort> {
+    enum { type = GL_SHORT, base = GL_INT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLushort> {
+    enum { type = GL_UNSIGNED_SHORT, base = GL_INT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLint> {
+    enum { type = GL_INT, base = GL_INT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLuint> {
+    enum { type = GL_UNSIGNED_INT, base = GL_INT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLfloat> {
+    enum { type = GL_FLOAT, base = GL_FLOAT, size = 1 };
+};
+
+template<>
+struct VertexLayout::Component<GLdouble> {
+    enum { type = GL_DOUBLE, base = GL_DOUBLE, size = 1 };
+};
+
+/**
+ * Functions that set up attributes read as floats in the shader.
+ */
+template<>
+struct VertexLayout::Functions<GL_FLOAT> {
+    static void format(GLuint index, GLint size, GLenum type, GLboolean normalized, GLuint offset, GLuint binding);
+    static void pointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, std::size_t offset);
+};
+
+/**
+ * Functions that set up attributes read as integers in the shader.
+ */
+template<>
+struct VertexLayout::Functions<GL_INT> {
+    static void format(GLuint index, GLint size, GLenum type, GLboolean normalized, GLuint offset, GLuint binding);
+    static void pointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, std::size_t offset);
+};
+
+/**
+ * Functions that set up attributes read as doubles in the shader.
+ */
+template<>
+struct VertexLayout::Functions<GL_DOUBLE> {
+    static void format(GLuint index, GLint size, GLenum type, GLboolean normalized, GLuint offset, GLuint binding);
+    static void pointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, std::size_t offset);
+};
+
+/**
+ * Sets up and enables a pointer for this attribute.
+ *
+ * @param stride Bytes between vertices
+ */
+template<GLuint INDEX, typename VERTEX, typename T, std::size_t OFFSET, typename CONVERSION>
+void VertexLayout::Attribute<INDEX,VERTEX,T,OFFSET,CONVERSION>::apply(const GLsizei stride) {
+    Functions<base>::pointer(index, size, type, normalized, stride, offset);
+}
+
+/**
+ * Specifies the format of this attribute, assigns it to a vertex buffer binding point and enables it.
+ *
+ * @param binding Index of the vertex buffer binding point
+ */
+template<GLuint INDEX, typename VERTEX, typename T, std::size_t OFFSET, typename CONVERSION>
+void VertexLayout::Attribute<INDEX,VERTEX,T,OFFSET,CONVERSION>::bind(const GLuint binding) {
+    Functions<base>::format(index, size, type, normalized, offset, binding);
+}
+
+/**
+ * Sets up and enables a pointer for each attribute, in order.
+ */
+template<typename VERTEX, typename A0, typename A1, typename A2, typename A3,
+         typename A4, typename A5, typename A6, typename A7>
+void VertexLayout::Format<VERTEX,A0,A1,A2,A3,A4,A5,A6,A7>::apply() {
+    A0::apply(stride);
+    A1::apply(stride);
+    A2::apply(stride);
+    A3::apply(stride);
+    A4::apply(stride);
+    A5::apply(stride);
+    A6::apply(stride);
+    A7::apply(stride);
+}
+
+/**
+ * Specifies the format of each attribute and assigns them all to one vertex buffer binding point.
+ *
+ * @param binding Index of the vertex buffer binding point
+ */
+template<typename VERTEX, typename A0, typename A1, typename A2, typename A3,
+         typename A4, typename A5, typename A6, typename A7>
+void VertexLayout::Format<VERTEX,A0,A1,A2,A3,A4,A5,A6,A7>::bind(const GLuint binding) {
+    A0::bind(binding);
+    A1::bind(binding);
+    A2::bind(binding);
+    A3::bind(binding);
+    A4::bind(binding);
+    A5::bind(binding);
+    A6::bind(binding);
+    A7::bind(binding);
+}
+
+} /* namespace Gloop */
+#endif
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cstddef>
+#include <stdexcept>
+#include "gloop/VertexLayout.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include "gloop/Context.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Vertex structure described by the layout under test.
+ */
+struct Vertex {
+    GLfloat position[3];
+    GLubyte color[4];
+    GLshort coord[2];
+    GLint material;
+};
+
+typedef VertexLayout L;
+typedef L::Attribute<0, Vertex, GLfloat[3], offsetof(Vertex, position)> Position;
+typedef L::Attribute<1, Vertex, GLubyte[4], offsetof(Vertex, color), L::Normalized> Color;
+typedef L::Attribute<4, Vertex, GLshort[2], offsetof(Vertex, coord), L::Normalized> Coord;
+typedef L::Attribute<3, Vertex, GLint, offsetof(Vertex, material)> Material;
+typedef L::Format<Vertex, Position, Color, Coord, Material> Format;
+typedef L::Attribute<3, Vertex, GLint, offsetof(Vertex, material), L::AsFloat> MaterialAsFloat;
+typedef L::Format<Vertex, Position, MaterialAsFloat> FormatAsFloat;
+
+
+/**
+ * Unit test for VertexLayout.
+ */
+class VertexLayoutTest {
+public:
+
+    /**
+     * Ensures the parameters of each attribute are computed from the vertex structure.
+     */
+    void testAttribute() {
+        CPPUNIT_ASSERT_EQUAL(3, (int) Position::size);
+        CPPUNIT_ASSERT_EQUAL(GL_FLOAT, (int) Position::type);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, (int) Position::normalized);
+        CPPUNIT_ASSERT_EQUAL(0, (int) Position::offset);
+        CPPUNIT_ASSERT_EQUAL(4, (int) Color::size);
+        CPPUNIT_ASSERT_EQUAL(GL_UNSIGNED_BYTE, (int) Color::type);
+        CPPUNIT_ASSERT_EQUAL(GL_TRUE, (int) Color::normalized);
+        CPPUNIT_ASSERT_EQUAL(12, (int) Color::offset);
+        CPPUNIT_ASSERT_EQUAL(GL_SHORT, (int) Coord::type);
+        CPPUNIT_ASSERT_EQUAL(16, (int) Coord::offset);
+        CPPUNIT_ASSERT_EQUAL(1, (int) Material::size);
+        CPPUNIT_ASSERT_EQUAL(GL_INT, (int) Material::type);
+        CPPUNIT_ASSERT_EQUAL(GL_INT, (int) Material::base);
+        CPPUNIT_ASSERT_EQUAL(GL_FLOAT, (int) Position::base);
+        CPPUNIT_ASSERT_EQUAL(GL_FLOAT, (int) Color::base);
+        CPPUNIT_ASSERT_EQUAL(20, (int) Material::offset);
+        CPPUNIT_ASSERT_EQUAL(GL_INT, (int) MaterialAsFloat::type);
+        CPPUNIT_ASSERT_EQUAL(GL_FLOAT, (int) MaterialAsFloat::base);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, (int) MaterialAsFloat::normalized);
+    }
+
+    /**
+     * Ensures the stride, count and largest index of a format are computed from its attributes.
+     */
+    void testFormat() {
+        CPPUNIT_ASSERT_EQUAL((int) sizeof(Vertex), (int) Format::stride);
+        CPPUNIT_ASSERT_EQUAL(4, (int) Format::count);
+        CPPUNIT_ASSERT_EQUAL(4, (int) Format::index);
+    }
+
+    /**
+     * Ensures a vertex array object sets up and enables every pointer of a format.
+     */
+    void testVertexLayout() {
+
+        // Apply the format
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        vao.vertexLayout<Format>();
+
+        // Check each pointer
+        const GLuint indices[] = { 0, 1, 4, 3 };
+        const GLint sizes[] = { 3, 4, 2, 1 };
+        const GLint types[] = { GL_FLOAT, GL_UNSIGNED_BYTE, GL_SHORT, GL_INT };
+        const GLint normalizeds[] = { GL_FALSE, GL_TRUE, GL_TRUE, GL_FALSE };
+        const GLintptr offsets[] = { 0, 12, 16, 20 };
+        const GLint integers[] = { GL_FALSE, GL_FALSE, GL_FALSE, GL_TRUE };
+        for (int i = 0; i < 4; ++i) {
+            GLint size, type, normalized, integer, stride, enabled;
+            GLvoid* offset;
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_SIZE, &size);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+            glGetVertexAttribPointerv(indices[i], GL_VERTEX_ATTRIB_ARRAY_POINTER, &offset);
+            CPPUNIT_ASSERT_EQUAL(sizes[i], size);
+            CPPUNIT_ASSERT_EQUAL(types[i], type);
+            CPPUNIT_ASSERT_EQUAL(normalizeds[i], normalized);
+            CPPUNIT_ASSERT_EQUAL(integers[i], integer);
+            CPPUNIT_ASSERT_EQUAL((GLint) sizeof(Vertex), stride);
+            CPPUNIT_ASSERT_EQUAL(GL_TRUE, enabled);
+            CPPUNIT_ASSERT_EQUAL(offsets[i], (GLintptr) offset);
+        }
+
+        // Check the unused index was left alone
+        GLint enabled;
+        glGetVertexAttribiv(2, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, enabled);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        vao.unbind();
+        bo.dispose();
+        vao.dispose();
+    }
+
+    /**
+     * Ensures an integer member converted to floats is set up with a float pointer.
+     */
+    void testVertexLayoutAsFloat() {
+
+        // Apply the format
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+        vao.vertexLayout<FormatAsFloat>();
+
+        // Check the pointer
+        GLint type, normalized, integer;
+        glGetVertexAttribiv(3, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+        glGetVertexAttribiv(3, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+        glGetVertexAttribiv(3, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+        CPPUNIT_ASSERT_EQUAL(GL_INT, type);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, normalized);
+        CPPUNIT_ASSERT_EQUAL(GL_FALSE, integer);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        vao.unbind();
+        bo.dispose();
+        vao.dispose();
+    }
+
+    /**
+     * Ensures a vertex array object specifies every format of a layout for one binding point.
+     */
+    void testVertexLayoutWithBinding() {
+
+        // Skip if not supported
+        if (!Context::current().capabilities().hasVertexAttribBinding()) {
+            return;
+        }
+
+        // Apply the format without a buffer bound
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        vao.vertexLayout<Format>(1);
+
+        // Check each attribute
+        const GLuint indices[] = { 0, 1, 4, 3 };
+        const GLint offsets[] = { 0, 12, 16, 20 };
+        const GLint integers[] = { GL_FALSE, GL_FALSE, GL_FALSE, GL_TRUE };
+        for (int i = 0; i < 4; ++i) {
+            GLint binding, offset, integer, enabled;
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_BINDING, &binding);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_RELATIVE_OFFSET, &offset);
+            glGetVertexAttribiv(indices[i], GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+            CPPUNIT_ASSERT_EQUAL(1, binding);
+            CPPUNIT_ASSERT_EQUAL(offsets[i], offset);
+            CPPUNIT_ASSERT_EQUAL(integers[i], integer);
+            CPPUNIT_ASSERT_EQUAL(GL_TRUE, enabled);
+        }
+
+        // Bind a buffer with the stride of the format
+        const BufferObject bo = BufferObject::generate();
+        vao.bindVertexBuffer(1, bo, 0, Format::stride);
+        GLint stride;
+        glGetIntegeri_v(GL_VERTEX_BINDING_STRIDE, 1, &stride);
+        CPPUNIT_ASSERT_EQUAL((GLint) sizeof(Vertex), stride);
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        vao.unbind();
+        bo.dispose();
+        vao.dispose();
+    }
+
+    /**
+     * Ensures applying a format without a buffer bound to `GL_ARRAY_BUFFER` throws an exception.
+     */
+    void testVertexLayoutWithoutArrayBuffer() {
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        CPPUNIT_ASSERT_THROW(vao.vertexLayout<Format>(), logic_error);
+        vao.unbind();
+        vao.dispose();
+    }
+};
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    VertexLayoutTest test;
+    try {
+        test.testAttribute();
+        test.testFormat();
+        test.testVertexLayout();
+        test.testVertexLayoutAsFloat();
+        test.testVertexLayoutWithBinding();
+        if (GLOOP_CHECKS) {
+            test.testVertexLayoutWithoutArrayBuffer();
+        }
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,583 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "gloop/VertexPacker.hxx"
+using namespace std;
+namespace Gloop {
+
+/**
+ * Returns the name of the instructions the packing methods were compiled to use.
+ *
+ * @return `AVX2`, `SSE2` or `scalar`
+ */
+const char* VertexPacker::instructionSet() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+/**
+ * Converts a float to a half float, rounding to the nearest even value.
+ *
+ * @param value Float to convert
+ * @return Bits of the half float closest to _value_
+ */
+GLhalf VertexPacker::halfOf(const GLfloat value) {
+
+    // Split off sign
+    GLuint f;
+    memcpy(&f, &value, sizeof(f));
+    const GLuint sign = f & 0x80000000u;
+    f ^= sign;
+
+    // Convert magnitude
+    GLuint h;
+    if (f >= (143u << 23)) {
+
+        // Too large, so infinity, or quiet NaN
+        h = (f > (255u << 23)) ? 0x7E00 : 0x7C00;
+    } else if (f < (113u << 23)) {
+
+        // Too small to be normal, so let adding 0.5 round away the low bits
+        GLfloat g;
+        memcpy(&g, &f, sizeof(g));
+        g += 0.5f;
+        memcpy(&f, &g, sizeof(f));
+        h = f - (126u << 23);
+    } else {
+
+        // Rebias exponent and round mantissa to nearest even
+        const GLuint odd = (f >> 13) & 1;
+        f += 0xC8000FFFu + odd;
+        h = f >> 13;
+    }
+    return (GLhalf) (h | (sign >> 16));
+}
+
+/**
+ * Packs four normalized values into a `GL_INT_2_10_10_10_REV` word.
+ *
+ * @param x Value for the lowest ten bits
+ * @param y Value for the next ten bits
+ * @param z Value for the next ten bits
+ * @param w Value for the highest two bits
+ * @return Word with _x_ in its lowest bits and _w_ in its highest
+ */
+GLuint VertexPacker::int2101010RevOf(const GLfloat x, const GLfloat y, const GLfloat z, const GLfloat w) {
+    return (((GLuint) snormOf(x, 511)) & 0x3FF)
+         | ((((GLuint) snormOf(y, 511)) & 0x3FF) << 10)
+         | ((((GLuint) snormOf(z, 511)) & 0x3FF) << 20)
+         | ((((GLuint) snormOf(w, 1)) & 0x3) << 30);
+}
+
+/**
+ * Maps a direction onto the faces of an octahedron and packs it into two normalized shorts.
+ *
+ * @param x X component of the direction
+ * @param y Y component of the direction
+ * @param z Z component of the direction
+ * @param dst Location to store the two shorts
+ */
+void VertexPacker::octahedralOf(const GLfloat x, const GLfloat y, const GLfloat z, GLshort* dst) {
+
+    // Project onto the octahedron
+    const GLfloat sum = fabs(x) + fabs(y) + fabs(z);
+    GLfloat u = x / sum;
+    GLfloat v = y / sum;
+
+    // Fold the lower half over the upper half
+    if (z < 0) {
+        const GLfloat su = (u < 0) ? -1.0f : 1.0f;
+        const GLfloat sv = (v < 0) ? -1.0f : 1.0f;
+        const GLfloat fu = (1.0f - fabs(v)) * su;
+        const GLfloat fv = (1.0f - fabs(u)) * sv;
+        u = fu;
+        v = fv;
+    }
+
+    // Pack
+    dst[0] = (GLshort) snormOf(u, 32767);
+    dst[1] = (GLshort) snormOf(v, 32767);
+}
+
+/**
+ * Converts floats to half floats.
+ *
+ * Values are rounded to the nearest half float, with ties going to the even
+ * one, like the hardware does.  Values too large become infinity, NaNs stay
+ * NaN, and values too small become denormals or zero.
+ *
+ * @param src Floats to convert
+ * @param dst Location to store the half floats, with room for _count_ of them
+ * @param count Number of floats to convert
+ */
+void VertexPacker::packHalf(const GLfloat* src, GLhalf* dst, const size_t count) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // Convert eight at a time
+    const __m256i signMask = _mm256_set1_epi32((int) 0x80000000);
+    const __m256i infinity = _mm256_set1_epi32(255 << 23);
+    const __m256i largest = _mm256_set1_epi32((143 << 23) - 1);
+    const __m256i smallest = _mm256_set1_epi32(113 << 23);
+    const __m256 magic = _mm256_set1_ps(0.5f);
+    const __m256i magicBits = _mm256_set1_epi32(126 << 23);
+    const __m256i bias = _mm256_set1_epi32((int) 0xC8000FFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i quiet = _mm256_set1_epi32(0x0200);
+    const __m256i inf = _mm256_set1_epi32(0x7C00);
+    for (; i + 8 <= count; i += 8) {
+        __m256i f = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+        const __m256i sign = _mm256_and_si256(f, signMask);
+        f = _mm256_xor_si256(f, sign);
+        const __m256i nan = _mm256_or_si256(inf, _mm256_and_si256(_mm256_cmpgt_epi32(f, infinity), quiet));
+        const __m256i small = _mm256_sub_epi32(
+                _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(f), magic)),
+                magicBits);
+        const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(f, 13), one);
+        const __m256i normal = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(f, bias), odd), 13);
+        const __m256i isLarge = _mm256_cmpgt_epi32(f, largest);
+        const __m256i isSmall = _mm256_cmpgt_epi32(smallest, f);
+        __m256i h = _mm256_blendv_epi8(normal, small, isSmall);
+        h = _mm256_blendv_epi8(h, nan, isLarge);
+        h = _mm256_or_si256(h, _mm256_srli_epi32(sign, 16));
+        h = _mm256_srai_epi32(_mm256_slli_epi32(h, 16), 16);
+        const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(h), _mm256_extracti128_si256(h, 1));
+        _mm_storeu_si128((__m128i*) (dst + i), packed);
+    }
+#elif defined(__SSE2__)
+    // Convert four at a time
+    const __m128i signMask = _mm_set1_epi32((int) 0x80000000);
+    const __m128i infinity = _mm_set1_epi32(255 << 23);
+    const __m128i largest = _mm_set1_epi32((143 << 23) - 1);
+    const __m128i smallest = _mm_set1_epi32(113 << 23);
+    const __m128 magic = _mm_set1_ps(0.5f);
+    const __m128i magicBits = _mm_set1_epi32(126 << 23);
+    const __m128i bias = _mm_set1_epi32((int) 0xC8000FFF);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i quiet = _mm_set1_epi32(0x0200);
+    const __m128i inf = _mm_set1_epi32(0x7C00);
+    for (; i + 4 <= count; i += 4) {
+        __m128i f = _mm_castps_si128(_mm_loadu_ps(src + i));
+        const __m128i sign = _mm_and_si128(f, signMask);
+        f = _mm_xor_si128(f, sign);
+        const __m128i nan = _mm_or_si128(inf, _mm_and_si128(_mm_cmpgt_epi32(f, infinity), quiet));
+        const __m128i small = _mm_sub_epi32(
+                _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(f), magic)),
+                magicBits);
+        const __m128i odd = _mm_and_si128(_mm_srli_epi32(f, 13), one);
+        const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(f, bias), odd), 13);
+        const __m128i isLarge = _mm_cmpgt_epi32(f, largest);
+        const __m128i isSmall = _mm_cmplt_epi32(f, smallest);
+        __m128i h = _mm_or_si128(_mm_and_si128(isSmall, small), _mm_andnot_si128(isSmall, normal));
+        h = _mm_or_si128(_mm_and_si128(isLarge, nan), _mm_andnot_si128(isLarge, h));
+        h = _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+        h = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+        _mm_storel_epi64((__m128i*) (dst + i), _mm_packs_epi32(h, h));
+    }
+#endif
+
+    // Convert the rest one at a time
+    for (; i < count; ++i) {
+        dst[i] = halfOf(src[i]);
+    }
+}
+
+/**
+ * Packs normalized vectors into `GL_INT_2_10_10_10_REV` words.
+ *
+ * The first three components of each vector get ten bits each, and the fourth
+ * gets two, which is enough for the handedness of a tangent frame.  Vectors
+ * with three components get a fourth component of zero.
+ *
+ * @param src Vectors to pack, one after another
+ * @param components Number of components in each vector, either `3` or `4`
+ * @param dst Location to store the words, with room for _count_ of them
+ * @param count Number of vectors to pack
+ * @throws invalid_argument if _components_ is not `3` or `4`
+ */
+void VertexPacker::packInt2101010Rev(const GLfloat* src,
+                                     const GLint components,
+                                     GLuint* dst,
+                                     const size_t count) {
+
+    if ((components != 3) && (components != 4)) {
+        throw invalid_argument("[VertexPacker] Components must be 3 or 4!");
+    }
+
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // Pack eight at a time, with vectors 0-3 in the low lane and 4-7 in the high lane
+    // Vectors of three are read as four floats, so stop one early for them
+    const size_t stop = (components == 4) ? 0 : 1;
+    const __m256 scale = _mm256_set_ps(1, 511, 511, 511, 1, 511, 511, 511);
+    const __m256 low = _mm256_set1_ps(-1);
+    const __m256 high = _mm256_set1_ps(1);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 wMask = (components == 4) ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : _mm256_setzero_ps();
+    const __m256i tenBits = _mm256_set1_epi32(0x3FF);
+    const __m256i twoBits = _mm256_set1_epi32(0x3);
+    for (; i + 8 + stop <= count; i += 8) {
+        const GLfloat* p = src + (i * components);
+        __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 4 * components), 1);
+        __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + components)), _mm_loadu_ps(p + 5 * components), 1);
+        __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 2 * components)), _mm_loadu_ps(p + 6 * components), 1);
+        __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 3 * components)), _mm_loadu_ps(p + 7 * components), 1);
+        __m256 v[4] = { r0, r1, r2, r3 };
+        for (int j = 0; j < 4; ++j) {
+            __m256 c = _mm256_min_ps(_mm256_max_ps(v[j], low), high);
+            c = _mm256_and_ps(_mm256_mul_ps(c, scale), _mm256_blend_ps(_mm256_castsi256_ps(_mm256_set1_epi32(-1)), wMask, 0x88));
+            v[j] = _mm256_add_ps(c, _mm256_or_ps(half, _mm256_and_ps(c, signMask)));
+        }
+        const __m256 t0 = _mm256_unpacklo_ps(v[0], v[1]);
+        const __m256 t1 = _mm256_unpackhi_ps(v[0], v[1]);
+        const __m256 t2 = _mm256_unpacklo_ps(v[2], v[3]);
+        const __m256 t3 = _mm256_unpackhi_ps(v[2], v[3]);
+        const __m256i x = _mm256_cvttps_epi32(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+        const __m256i y = _mm256_cvttps_epi32(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+        const __m256i z = _mm256_cvttps_epi32(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+        const __m256i w = _mm256_cvttps_epi32(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+        __m256i word = _mm256_and_si256(x, tenBits);
+        word = _mm256_or_si256(word, _mm256_slli_epi32(_mm256_and_si256(y, tenBits), 10));
+        word = _mm256_or_si256(word, _mm256_slli_epi32(_mm256_and_si256(z, tenBits), 20));
+        word = _mm256_or_si256(word, _mm256_slli_epi32(_mm256_and_si256(w, twoBits), 30));
+        _mm256_storeu_si256((__m256i*) (dst + i), word);
+    }
+#elif defined(__SSE2__)
+    // Pack four at a time
+    // Vectors of three are read as four floats, so stop one early for them
+    const size_t stop = (components == 4) ? 0 : 1;
+    const __m128 scale = _mm_set_ps(1, 511, 511, 511);
+    const __m128 low = _mm_set1_ps(-1);
+    const __m128 high = _mm_set1_ps(1);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 keep = _mm_castsi128_ps(_mm_set_epi32((components == 4) ? -1 : 0, -1, -1, -1));
+    const __m128i tenBits = _mm_set1_epi32(0x3FF);
+    const __m128i twoBits = _mm_set1_epi32(0x3);
+    for (; i + 4 + stop <= count; i += 4) {
+        const GLfloat* p = src + (i * components);
+        __m128 v[4] = {
+            _mm_loadu_ps(p),
+            _mm_loadu_ps(p + components),
+            _mm_loadu_ps(p + 2 * components),
+            _mm_loadu_ps(p + 3 * components)
+        };
+        for (int j = 0; j < 4; ++j) {
+            __m128 c = _mm_min_ps(_mm_max_ps(v[j], low), high);
+            c = _mm_and_ps(_mm_mul_ps(c, scale), keep);
+            v[j] = _mm_add_ps(c, _mm_or_ps(half, _mm_and_ps(c, signMask)));
+        }
+        _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+        __m128i word = _mm_and_si128(_mm_cvttps_epi32(v[0]), tenBits);
+        word = _mm_or_si128(word, _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(v[1]), tenBits), 10));
+        word = _mm_or_si128(word, _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(v[2]), tenBits), 20));
+        word = _mm_or_si128(word, _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(v[3]), twoBits), 30));
+        _mm_storeu_si128((__m128i*) (dst + i), word);
+    }
+#endif
+
+    // Pack the rest one at a time
+    for (; i < count; ++i) {
+        const GLfloat* p = src + (i * components);
+        dst[i] = int2101010RevOf(p[0], p[1], p[2], (components == 4) ? p[3] : 0);
+    }
+}
+
+/**
+ * Packs unit directions into pairs of normalized shorts with an octahedral mapping.
+ *
+ * Each direction is projected onto an octahedron, whose lower half is folded
+ * over its upper half so the whole sphere fits in a square.  Two shorts per
+ * normal are more accurate than three bytes, and half the size of three floats.
+ *
+ * @param src Directions to pack, three floats each
+ * @param dst Location to store the shorts, with room for twice _count_ of them
+ * @param count Number of directions to pack
+ */
+void VertexPacker::packOctahedral(const GLfloat* src, GLshort* dst, const size_t count) {
+
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // Pack eight at a time, with directions 0-3 in the low lane and 4-7 in the high lane
+    // Directions are read as four floats, so stop one early
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1);
+    const __m256 low = _mm256_set1_ps(-1);
+    const __m256 scale = _mm256_set1_ps(32767);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    for (; i + 9 <= count; i += 8) {
+        const GLfloat* p = src + (i * 3);
+        const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+        const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 3)), _mm_loadu_ps(p + 15), 1);
+        const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 6)), _mm_loadu_ps(p + 18), 1);
+        const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 9)), _mm_loadu_ps(p + 21), 1);
+        const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+        const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        const __m256 x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+
+        // Project onto the octahedron
+        const __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_and_ps(x, absMask), _mm256_and_ps(y, absMask)),
+                                         _mm256_and_ps(z, absMask));
+        __m256 u = _mm256_div_ps(x, sum);
+        __m256 v = _mm256_div_ps(y, sum);
+
+        // Fold the lower half over the upper half
+        const __m256 su = _mm256_or_ps(one, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_LT_OQ), signMask));
+        const __m256 sv = _mm256_or_ps(one, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_LT_OQ), signMask));
+        const __m256 fu = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(v, absMask)), su);
+        const __m256 fv = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(u, absMask)), sv);
+        const __m256 lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+        u = _mm256_blendv_ps(u, fu, lower);
+        v = _mm256_blendv_ps(v, fv, lower);
+
+        // Pack and interleave
+        u = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(u, low), one), scale);
+        v = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(v, low), one), scale);
+        const __m256i ui = _mm256_cvttps_epi32(_mm256_add_ps(u, _mm256_or_ps(half, _mm256_and_ps(u, signMask))));
+        const __m256i vi = _mm256_cvttps_epi32(_mm256_add_ps(v, _mm256_or_ps(half, _mm256_and_ps(v, signMask))));
+        const __m256i packed = _mm256_packs_epi32(_mm256_unpacklo_epi32(ui, vi), _mm256_unpackhi_epi32(ui, vi));
+        _mm256_storeu_si256((__m256i*) (dst + (i * 2)), packed);
+    }
+#elif defined(__SSE2__)
+    // Pack four at a time
+    // Directions are read as four floats, so stop one early
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1);
+    const __m128 low = _mm_set1_ps(-1);
+    const __m128 scale = _mm_set1_ps(32767);
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; i + 5 <= count; i += 4) {
+        const GLfloat* p = src + (i * 3);
+        __m128 x = _mm_loadu_ps(p);
+        __m128 y = _mm_loadu_ps(p + 3);
+        __m128 z = _mm_loadu_ps(p + 6);
+        __m128 w = _mm_loadu_ps(p + 9);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        // Project onto the octahedron
+        const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_and_ps(x, absMask), _mm_and_ps(y, absMask)),
+                                      _mm_and_ps(z, absMask));
+        __m128 u = _mm_div_ps(x, sum);
+        __m128 v = _mm_div_ps(y, sum);
+
+        // Fold the lower half over the upper half
+        const __m128 su = _mm_or_ps(one, _mm_and_ps(_mm_cmplt_ps(u, zero), signMask));
+        const __m128 sv = _mm_or_ps(one, _mm_and_ps(_mm_cmplt_ps(v, zero), signMask));
+        const __m128 fu = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(v, absMask)), su);
+        const __m128 fv = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(u, absMask)), sv);
+        const __m128 lower = _mm_cmplt_ps(z, zero);
+        u = _mm_or_ps(_mm_and_ps(lower, fu), _mm_andnot_ps(lower, u));
+        v = _mm_or_ps(_mm_and_ps(lower, fv), _mm_andnot_ps(lower, v));
+
+        // Pack and interleave
+        u = _mm_mul_ps(_mm_min_ps(_mm_max_ps(u, low), one), scale);
+        v = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, low), one), scale);
+        const __m128i ui = _mm_cvttps_epi32(_mm_add_ps(u, _mm_or_ps(half, _mm_and_ps(u, signMask))));
+        const __m128i vi = _mm_cvttps_epi32(_mm_add_ps(v, _mm_or_ps(half, _mm_and_ps(v, signMask))));
+        const __m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(ui, vi), _mm_unpackhi_epi32(ui, vi));
+        _mm_storeu_si128((__m128i*) (dst + (i * 2)), packed);
+    }
+#endif
+
+    // Pack the rest one at a time
+    for (; i < count; ++i) {
+        octahedralOf(src[i * 3], src[i * 3 + 1], src[i * 3 + 2], dst + (i * 2));
+    }
+}
+
+/**
+ * Converts floats in `[-1, 1]` to normalized bytes.
+ *
+ * @param src Floats to convert, clamped to `[-1, 1]`
+ * @param dst Location to store the bytes, with room for _count_ of them
+ * @param count Number of floats to convert
+ */
+void VertexPacker::packSnorm8(const GLfloat* src, GLbyte* dst, const size_t count) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // Convert thirty-two at a time
+    const __m256 low = _mm256_set1_ps(-1);
+    const __m256 high = _mm256_set1_ps(1);
+    const __m256 scale = _mm256_set1_ps(127);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 32 <= count; i += 32) {
+        __m256i n[4];
+        for (int j = 0; j < 4; ++j) {
+            __m256 c = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i + j * 8), low), high);
+            c = _mm256_mul_ps(c, scale);
+            n[j] = _mm256_cvttps_epi32(_mm256_add_ps(c, _mm256_or_ps(half, _mm256_and_ps(c, signMask))));
+        }
+        const __m256i packed = _mm256_packs_epi16(_mm256_packs_epi32(n[0], n[1]), _mm256_packs_epi32(n[2], n[3]));
+        _mm256_storeu_si256((__m256i*) (dst + i), _mm256_permutevar8x32_epi32(packed, order));
+    }
+#elif defined(__SSE2__)
+    // Convert sixteen at a time
+    const __m128 low = _mm_set1_ps(-1);
+    const __m128 high = _mm_set1_ps(1);
+    const __m128 scale = _mm_set1_ps(127);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (; i + 16 <= count; i += 16) {
+        __m128i n[4];
+        for (int j = 0; j < 4; ++j) {
+            __m128 c = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), low), high);
+            c = _mm_mul_ps(c, scale);
+            n[j] = _mm_cvttps_epi32(_mm_add_ps(c, _mm_or_ps(half, _mm_and_ps(c, signMask))));
+        }
+        const __m128i packed = _mm_packs_epi16(_mm_packs_epi32(n[0], n[1]), _mm_packs_epi32(n[2], n[3]));
+        _mm_storeu_si128((__m128i*) (dst + i), packed);
+    }
+#endif
+
+    // Convert the rest one at a time
+    for (; i < count; ++i) {
+        dst[i] = (GLbyte) snormOf(src[i], 127);
+    }
+}
+
+/**
+ * Converts floats in `[-1, 1]` to normalized shorts.
+ *
+ * @param src Floats to convert, clamped to `[-1, 1]`
+ * @param dst Location to store the shorts, with room for _count_ of them
+ * @param count Number of floats to convert
+ */
+void VertexPacker::packSnorm16(const GLfloat* src, GLshort* dst, const size_t count) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // Convert sixteen at a time
+    const __m256 low = _mm256_set1_ps(-1);
+    const __m256 high = _mm256_set1_ps(1);
+    const __m256 scale = _mm256_set1_ps(32767);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    for (; i + 16 <= count; i += 16) {
+        __m256i n[2];
+        for (int j = 0; j < 2; ++j) {
+            __m256 c = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i + j * 8), low), high);
+            c = _mm256_mul_ps(c, scale);
+            n[j] = _mm256_cvttps_epi32(_mm256_add_ps(c, _mm256_or_ps(half, _mm256_and_ps(c, signMask))));
+        }
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(n[0], n[1]), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*) (dst + i), packed);
+    }
+#elif defined(__SSE2__)
+    // Convert eight at a time
+    const __m128 low = _mm_set1_ps(-1);
+    const __m128 high = _mm_set1_ps(1);
+    const __m128 scale = _mm_set1_ps(32767);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128i n[2];
+        for (int j = 0; j < 2; ++j) {
+            __m128 c = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), low), high);
+            c = _mm_mul_ps(c, scale);
+            n[j] = _mm_cvttps_epi32(_mm_add_ps(c, _mm_or_ps(half, _mm_and_ps(c, signMask))));
+        }
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_packs_epi32(n[0], n[1]));
+    }
+#endif
+
+    // Convert the rest one at a time
+    for (; i < count; ++i) {
+        dst[i] = (GLshort) snormOf(src[i], 32767);
+    }
+}
+
+/**
+ * Makes a vertex attribute pointer that reads back vertex data packed with an encoding.
+ *
+ * The size, type and normalization are set for the encoding.  The index,
+ * stride and offset still need to be set before it is used.
+ *
+ * @param encoding Encoding the vertex data was packed with
+ * @param components Number of components in each packed value, ignored for
+ *                   `INT_2_10_10_10_REV`, which always has four, and
+ *                   `OCTAHEDRAL`, which always has two
+ * @return Vertex attribute pointer for the packed data
+ * @throws invalid_argument if encoding is unknown
+ * @see @ref VertexArrayObject::vertexAttribPointer
+ */
+VertexAttribPointer VertexPacker::pointer(const Encoding encoding, const GLint components) {
+    switch (encoding) {
+    case HALF_FLOAT:
+        return VertexAttribPointer().size(components).type(GL_HALF_FLOAT).normalized(GL_FALSE);
+    case SNORM8:
+        return VertexAttribPointer().size(components).type(GL_BYTE).normalized(GL_TRUE);
+    case SNORM16:
+        return VertexAttribPointer().size(components).type(GL_SHORT).normalized(GL_TRUE);
+    case INT_2_10_10_10_REV:
+        return VertexAttribPointer().size(4).type(GL_INT_2_10_10_10_REV).normalized(GL_TRUE);
+    case OCTAHEDRAL:
+        return VertexAttribPointer().size(2).type(GL_SHORT).normalized(GL_TRUE);
+    default:
+        throw invalid_argument("[VertexPacker] Unknown encoding!");
+    }
+}
+
+/**
+ * Converts a float to a normalized integer, rounding half away from zero.
+ *
+ * @param value Float to convert, clamped to `[-1, 1]`
+ * @param scale Largest value of the integer, e.g. `127` for a byte
+ * @return Integer in `[-scale, scale]`
+ */
+GLint VertexPacker::snormOf(const GLfloat value, const GLfloat scale) {
+    const GLfloat clamped = (value < -1) ? -1 : ((value > 1) ? 1 : value);
+    const GLfloat scaled = clamped * scale;
+    return (GLint) (scaled + ((scaled < 0) ? -0.5f : 0.5f));
+}
+
+} /* namespace Gloop */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef GLOOP_VERTEXPACKER_HXX
+#define GLOOP_VERTEXPACKER_HXX
+#include "gloop/common.h"
+#include <cstddef>
+#include "gloop/VertexAttribPointer.hxx"
+namespace Gloop {
+
+
+/**
+ * Converts streams of floating-point vertex data into smaller encodings.
+ *
+ * Meshes are usually authored with 32-bit floats, but positions, normals,
+ * tangents and texture coordinates rarely need that much precision.  Packing
+ * them into half floats, normalized bytes or shorts, or `2_10_10_10` words
+ * halves or quarters the memory they take and the bandwidth spent fetching
+ * them, with the hardware unpacking them for free.
+ *
+ * Each method converts a whole stream at once.  When Gloop is compiled for a
+ * processor with SSE2 or AVX2, for example with `CXXFLAGS=-mavx2`, several
+ * values are converted per instruction, otherwise one at a time.  Either way
+ * the results are the same.  Use @ref instructionSet to see which was chosen.
+ *
+ * ~~~
+ *     std::vector<GLuint> packed(count);
+ *     VertexPacker::packInt2101010Rev(&normals[0], 3, &packed[0], count);
+ *     arrayBuffer.data(packed.size() * sizeof(GLuint), &packed[0], GL_STATIC_DRAW);
+ * ~~~
+ *
+ * @ref pointer gives a vertex attribute pointer already set up to read each
+ * encoding back, so only the index, stride and offset need to be filled in.
+ *
+ * ~~~
+ *     vao.vertexAttribPointer(VertexPacker::pointer(VertexPacker::INT_2_10_10_10_REV, 3)
+ *             .index(myShaderProgram.attribLocation("MCNormal")));
+ * ~~~
+ *
+ * Octahedral normals arrive in the shader as two values in `[-1, 1]`, and are
+ * turned back into a unit vector with the inverse mapping.
+ *
+ * ~~~
+ *     vec3 decode(vec2 e) {
+ *         vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+ *         if (n.z < 0.0) {
+ *             n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+ *         }
+ *         return normalize(n);
+ *     }
+ * ~~~
+ *
+ * Values outside `[-1, 1]` are clamped by the normalized encodings, and
+ * values too large for a half float become infinity.  Inputs should not be
+ * NaN, except to @ref packHalf, and normals should not be zero.
+ */
+class VertexPacker {
+public:
+// Types
+    /**
+     * Ways a stream of vertex data can be packed.
+     */
+    enum Encoding {
+        HALF_FLOAT,
+        SNORM8,
+        SNORM16,
+        INT_2_10_10_10_REV,
+        OCTAHEDRAL
+    };
+// Methods
+    static const char* instructionSet();
+    static void packHalf(const GLfloat* src, GLhalf* dst, std::size_t count);
+    static void packInt2101010Rev(const GLfloat* src, GLint components, GLuint* dst, std::size_t count);
+    static void packOctahedral(const GLfloat* src, GLshort* dst, std::size_t count);
+    static void packSnorm8(const GLfloat* src, GLbyte* dst, std::size_t count);
+    static void packSnorm16(const GLfloat* src, GLshort* dst, std::size_t count);
+    static VertexAttribPointer pointer(Encoding encoding, GLint components);
+private:
+// Methods
+    static GLhalf halfOf(GLfloat value);
+    static GLuint int2101010RevOf(GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+    static void octahedralOf(GLfloat x, GLfloat y, GLfloat z, GLshort* dst);
+    static GLint snormOf(GLfloat value, GLfloat scale);
+};
+
+} /* namespace Gloop */
+#endif
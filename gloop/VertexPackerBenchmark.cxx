@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <GL/glfw.h>
+#include "gloop/VertexPacker.hxx"
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Benchmark for packing vertex data.
+ *
+ * Packs positions into half floats, normals and tangents into
+ * `GL_INT_2_10_10_10_REV` words and octahedral shorts, and texture coordinates
+ * into normalized shorts, reporting how many millions of vertices each stream
+ * is packed at per second.  Compile Gloop with and without `-mavx2` to
+ * compare the kernels.
+ */
+class VertexPackerBenchmark {
+public:
+
+    /**
+     * Number of vertices in each stream.
+     */
+    static const size_t COUNT = 1 << 20;
+
+    /**
+     * Number of times each stream is packed.
+     */
+    static const int REPEATS = 20;
+
+    /**
+     * Makes the streams to pack.
+     */
+    VertexPackerBenchmark() :
+            positions(COUNT * 3),
+            normals(COUNT * 3),
+            tangents(COUNT * 4),
+            coords(COUNT * 2),
+            halves(COUNT * 4),
+            words(COUNT),
+            shorts(COUNT * 4),
+            bytes(COUNT * 4) {
+        for (size_t i = 0; i < COUNT; ++i) {
+            const GLfloat a = (GLfloat) rand() / RAND_MAX * 6.2831853f;
+            const GLfloat b = (GLfloat) rand() / RAND_MAX * 3.1415927f;
+            normals[i * 3] = cos(a) * sin(b);
+            normals[i * 3 + 1] = sin(a) * sin(b);
+            normals[i * 3 + 2] = cos(b);
+            tangents[i * 4] = -sin(a);
+            tangents[i * 4 + 1] = cos(a);
+            tangents[i * 4 + 2] = 0;
+            tangents[i * 4 + 3] = (i % 2) ? 1.0f : -1.0f;
+            for (int j = 0; j < 3; ++j) {
+                positions[i * 3 + j] = ((GLfloat) rand() / RAND_MAX - 0.5f) * 100;
+            }
+            for (int j = 0; j < 2; ++j) {
+                coords[i * 2 + j] = (GLfloat) rand() / RAND_MAX;
+            }
+        }
+    }
+
+    /**
+     * Reports the rate a stream was packed at.
+     */
+    static void report(const char* name, const double elapsed) {
+        const double rate = ((double) COUNT * REPEATS) / elapsed / 1e6;
+        cout << "  " << left << setw(32) << name
+             << right << fixed << setprecision(1) << setw(10) << rate << " Mverts/s" << endl;
+    }
+
+    /**
+     * Times packing each stream.
+     */
+    void run() {
+        double start;
+
+        cout << "VertexPackerBenchmark: " << COUNT << " vertices, "
+             << VertexPacker::instructionSet() << endl;
+
+        start = glfwGetTime();
+        for (int i = 0; i < REPEATS; ++i) {
+            VertexPacker::packHalf(&positions[0], &halves[0], COUNT * 3);
+        }
+        report("position, half float x3", glfwGetTime() - start);
+
+        start = glfwGetTime();
+        for (int i = 0; i < REPEATS; ++i) {
+            VertexPacker::packInt2101010Rev(&normals[0], 3, &words[0], COUNT);
+        }
+        report("normal, 2_10_10_10_REV", glfwGetTime() - start);
+
+        start = glfwGetTime();
+        for (int i = 0; i < REPEATS; ++i) {
+            VertexPacker::packOctahedral(&normals[0], &shorts[0], COUNT);
+        }
+        report("normal, octahedral snorm16 x2", glfwGetTime() - start);
+
+        start = glfwGetTime();
+        for (int i = 0; i < REPEATS; ++i) {
+            VertexPacker::packInt2101010Rev(&tangents[0], 4, &words[0], COUNT);
+        }
+        report("tangent, 2_10_10_10_REV", glfwGetTime() - start);
+
+        start = glfwGetTime();
+        for (int i = 0; i < REPEATS; ++i) {
+            VertexPacker::packSnorm8(&tangents[0], &bytes[0], COUNT * 4);
+        }
+        report("tangent, snorm8 x4", glfwGetTime() - start);
+
+        start = glfwGetTime();
+        for (int i = 0; i < REPEATS; ++i) {
+            VertexPacker::packSnorm16(&coords[0], &shorts[0], COUNT * 2);
+        }
+        report("texture coordinate, snorm16 x2", glfwGetTime() - start);
+    }
+
+private:
+    vector<GLfloat> positions;
+    vector<GLfloat> normals;
+    vector<GLfloat> tangents;
+    vector<GLfloat> coords;
+    vector<GLhalf> halves;
+    vector<GLuint> words;
+    vector<GLshort> shorts;
+    vector<GLbyte> bytes;
+};
+
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW for its timer
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Run the benchmark
+    try {
+        VertexPackerBenchmark benchmark;
+        benchmark.run();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
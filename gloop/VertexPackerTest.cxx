@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2012, Andrew Brown
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "config.h"
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include "gloop/VertexPacker.hxx"
+#include "gloop/VertexArrayObject.hxx"
+#include "gloop/BufferObject.hxx"
+#include "gloop/BufferTarget.hxx"
+#include <cppunit/extensions/HelperMacros.h>
+#include <GL/glfw.h>
+using namespace std;
+using namespace Gloop;
+
+
+/**
+ * Unit test for VertexPacker.
+ */
+class VertexPackerTest {
+public:
+
+    /**
+     * Number of values packed when comparing a whole stream against one value at a time.
+     */
+    static const size_t COUNT = 67;
+
+    /**
+     * Returns a random float in `[-1.25, 1.25]`, so some values need clamping.
+     */
+    static GLfloat randomFloat() {
+        return (((GLfloat) rand() / RAND_MAX) * 2.5f) - 1.25f;
+    }
+
+    /**
+     * Makes random unit directions, three floats each.
+     */
+    static vector<GLfloat> randomDirections(const size_t count) {
+        vector<GLfloat> directions;
+        for (size_t i = 0; i < count; ++i) {
+            GLfloat x, y, z, length;
+            do {
+                x = randomFloat();
+                y = randomFloat();
+                z = randomFloat();
+                length = sqrt(x * x + y * y + z * z);
+            } while ((length < 0.1f) || (length > 1.0f));
+            directions.push_back(x / length);
+            directions.push_back(y / length);
+            directions.push_back(z / length);
+        }
+        return directions;
+    }
+
+    /**
+     * Ensures floats are converted to the nearest half float.
+     */
+    void testPackHalf() {
+
+        // Check known values
+        const GLfloat src[] = { 0.0f, 1.0f, -2.0f, 65504.0f, 1e6f, 5.9604645e-8f, 0.1f, 1.0009766f };
+        const GLhalf expected[] = { 0x0000, 0x3C00, 0xC000, 0x7BFF, 0x7C00, 0x0001, 0x2E66, 0x3C01 };
+        GLhalf dst[8];
+        VertexPacker::packHalf(src, dst, 8);
+        for (int i = 0; i < 8; ++i) {
+            CPPUNIT_ASSERT_EQUAL(expected[i], dst[i]);
+        }
+
+        // Check NaN stays NaN
+        const GLfloat nan = sqrt(-1.0f);
+        GLhalf h;
+        VertexPacker::packHalf(&nan, &h, 1);
+        CPPUNIT_ASSERT_EQUAL((GLhalf) 0x7E00, (GLhalf) (h & 0x7FFF));
+
+        // Check a stream matches packing one value at a time
+        vector<GLfloat> values;
+        for (size_t i = 0; i < COUNT; ++i) {
+            values.push_back(randomFloat() * ((i % 3 == 0) ? 1e-5f : 1e5f));
+        }
+        vector<GLhalf> all(COUNT);
+        VertexPacker::packHalf(&values[0], &all[0], COUNT);
+        for (size_t i = 0; i < COUNT; ++i) {
+            GLhalf one;
+            VertexPacker::packHalf(&values[i], &one, 1);
+            CPPUNIT_ASSERT_EQUAL(one, all[i]);
+        }
+    }
+
+    /**
+     * Ensures vectors are packed into `GL_INT_2_10_10_10_REV` words.
+     */
+    void testPackInt2101010Rev() {
+
+        // Check a known value
+        const GLfloat src[] = { 1.0f, 0.0f, -1.0f, 1.0f };
+        GLuint word;
+        VertexPacker::packInt2101010Rev(src, 4, &word, 1);
+        CPPUNIT_ASSERT_EQUAL((GLuint) (0x1FF | (0x201 << 20) | (1 << 30)), word);
+        VertexPacker::packInt2101010Rev(src, 3, &word, 1);
+        CPPUNIT_ASSERT_EQUAL((GLuint) (0x1FF | (0x201 << 20)), word);
+
+        // Check streams match packing one vector at a time
+        vector<GLfloat> values;
+        for (size_t i = 0; i < COUNT * 4; ++i) {
+            values.push_back(randomFloat());
+        }
+        for (GLint components = 3; components <= 4; ++components) {
+            vector<GLuint> all(COUNT);
+            VertexPacker::packInt2101010Rev(&values[0], components, &all[0], COUNT);
+            for (size_t i = 0; i < COUNT; ++i) {
+                GLuint one;
+                VertexPacker::packInt2101010Rev(&values[i * components], components, &one, 1);
+                CPPUNIT_ASSERT_EQUAL(one, all[i]);
+            }
+        }
+
+        // Check bad number of components
+        CPPUNIT_ASSERT_THROW(VertexPacker::packInt2101010Rev(src, 2, &word, 1), invalid_argument);
+    }
+
+    /**
+     * Ensures directions are packed with an octahedral mapping that can be undone.
+     */
+    void testPackOctahedral() {
+
+        // Check known values
+        const GLfloat src[] = { 0, 0, 1, 0, 0, -1, 1, 0, 0 };
+        const GLshort expected[] = { 0, 0, 32767, 32767, 32767, 0 };
+        GLshort dst[6];
+        VertexPacker::packOctahedral(src, dst, 3);
+        for (int i = 0; i < 6; ++i) {
+            CPPUNIT_ASSERT_EQUAL(expected[i], dst[i]);
+        }
+
+        // Check a stream matches packing one direction at a time, and decodes closely
+        const vector<GLfloat> directions = randomDirections(COUNT);
+        vector<GLshort> all(COUNT * 2);
+        VertexPacker::packOctahedral(&directions[0], &all[0], COUNT);
+        for (size_t i = 0; i < COUNT; ++i) {
+            GLshort one[2];
+            VertexPacker::packOctahedral(&directions[i * 3], one, 1);
+            CPPUNIT_ASSERT_EQUAL(one[0], all[i * 2]);
+            CPPUNIT_ASSERT_EQUAL(one[1], all[i * 2 + 1]);
+
+            // Decode like a shader would
+            GLfloat x = all[i * 2] / 32767.0f;
+            GLfloat y = all[i * 2 + 1] / 32767.0f;
+            const GLfloat z = 1.0f - fabs(x) - fabs(y);
+            if (z < 0) {
+                const GLfloat ox = x;
+                x = (1.0f - fabs(y)) * ((ox >= 0) ? 1.0f : -1.0f);
+                y = (1.0f - fabs(ox)) * ((y >= 0) ? 1.0f : -1.0f);
+            }
+            const GLfloat length = sqrt(x * x + y * y + z * z);
+            const GLfloat dot = (x * directions[i * 3] + y * directions[i * 3 + 1] + z * directions[i * 3 + 2]) / length;
+            CPPUNIT_ASSERT(dot > 0.99999f);
+        }
+    }
+
+    /**
+     * Ensures floats are converted to normalized bytes and shorts.
+     */
+    void testPackSnorm() {
+
+        // Check known values
+        const GLfloat src[] = { -2.0f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 2.0f, 0.25f };
+        const GLbyte expected8[] = { -127, -127, -64, 0, 64, 127, 127, 32 };
+        const GLshort expected16[] = { -32767, -32767, -16384, 0, 16384, 32767, 32767, 8192 };
+        GLbyte dst8[8];
+        GLshort dst16[8];
+        VertexPacker::packSnorm8(src, dst8, 8);
+        VertexPacker::packSnorm16(src, dst16, 8);
+        for (int i = 0; i < 8; ++i) {
+            CPPUNIT_ASSERT_EQUAL(expected8[i], dst8[i]);
+            CPPUNIT_ASSERT_EQUAL(expected16[i], dst16[i]);
+        }
+
+        // Check streams match packing one value at a time
+        vector<GLfloat> values;
+        for (size_t i = 0; i < COUNT; ++i) {
+            values.push_back(randomFloat());
+        }
+        vector<GLbyte> all8(COUNT);
+        vector<GLshort> all16(COUNT);
+        VertexPacker::packSnorm8(&values[0], &all8[0], COUNT);
+        VertexPacker::packSnorm16(&values[0], &all16[0], COUNT);
+        for (size_t i = 0; i < COUNT; ++i) {
+            GLbyte one8;
+            GLshort one16;
+            VertexPacker::packSnorm8(&values[i], &one8, 1);
+            VertexPacker::packSnorm16(&values[i], &one16, 1);
+            CPPUNIT_ASSERT_EQUAL(one8, all8[i]);
+            CPPUNIT_ASSERT_EQUAL(one16, all16[i]);
+        }
+    }
+
+    /**
+     * Ensures the pointer for each encoding is accepted by a vertex array object.
+     */
+    void testPointer() {
+
+        // Set up a vertex array object
+        const VertexArrayObject vao = VertexArrayObject::generate();
+        vao.bind();
+        const BufferObject bo = BufferObject::generate();
+        const BufferTarget bt = BufferTarget::arrayBuffer();
+        bt.bind(bo);
+
+        // Check each encoding
+        const VertexPacker::Encoding encodings[] = {
+            VertexPacker::HALF_FLOAT,
+            VertexPacker::SNORM8,
+            VertexPacker::SNORM16,
+            VertexPacker::INT_2_10_10_10_REV,
+            VertexPacker::OCTAHEDRAL
+        };
+        const GLint sizes[] = { 3, 3, 3, 4, 2 };
+        const GLint types[] = { GL_HALF_FLOAT, GL_BYTE, GL_SHORT, GL_INT_2_10_10_10_REV, GL_SHORT };
+        const GLint normalizeds[] = { GL_FALSE, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+        for (GLuint i = 0; i < 5; ++i) {
+            vao.vertexAttribPointer(VertexPacker::pointer(encodings[i], 3).index(i));
+            GLint size, type, normalized;
+            glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &size);
+            glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+            glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+            CPPUNIT_ASSERT_EQUAL(sizes[i], size);
+            CPPUNIT_ASSERT_EQUAL(types[i], type);
+            CPPUNIT_ASSERT_EQUAL(normalizeds[i], normalized);
+        }
+        CPPUNIT_ASSERT_EQUAL((GLenum) GL_NO_ERROR, glGetError());
+
+        // Clean up
+        bt.unbind(bo);
+        vao.unbind();
+        bo.dispose();
+        vao.dispose();
+    }
+};
+
+int main(int argc, char* argv[]) {
+
+    // Initialize GLFW
+    if (!glfwInit()) {
+        cerr << "Could not initialize GLFW!" << endl;
+        return 1;
+    }
+
+    // Open a window
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MAJOR, 3);
+    glfwOpenWindowHint(GLFW_OPENGL_VERSION_MINOR, 2);
+    glfwOpenWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwOpenWindow(512, 512, 0, 0, 0, 0, 0, 0, GLFW_WINDOW);
+
+    // Run the test
+    VertexPackerTest test;
+    try {
+        test.testPackHalf();
+        test.testPackInt2101010Rev();
+        test.testPackOctahedral();
+        test.testPackSnorm();
+        test.testPointer();
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        throw;
+    }
+
+    // Exit
+    glfwTerminate();
+    return 0;
+}
@@ -49,4 +49,29 @@
 #define SIZE_MAX ((size_t) -1)
 #endif
 
+/*
+ * Checking policies for how Gloop validates its usage, such as whether an
+ * object is bound before it is changed.  Many checks have to query OpenGL, so
+ * production builds may want to skip them.
+ *
+ * - GLOOP_CHECKING_CHECKED always checks, throwing exceptions on misuse
+ * - GLOOP_CHECKING_DEBUG checks unless NDEBUG is defined
+ * - GLOOP_CHECKING_UNCHECKED never checks
+ *
+ * The policy is chosen when Gloop is configured, with `--enable-checking`, and
+ * installed with it in `gloop/checking.h` as GLOOP_CHECKING.  Code can test
+ * GLOOP_CHECKS to see if checks are made.
+ */
+#define GLOOP_CHECKING_UNCHECKED 0
+#define GLOOP_CHECKING_DEBUG 1
+#define GLOOP_CHECKING_CHECKED 2
+#include "gloop/checking.h"
+#if (GLOOP_CHECKING == GLOOP_CHECKING_CHECKED)
+#define GLOOP_CHECKS true
+#elif (GLOOP_CHECKING == GLOOP_CHECKING_DEBUG) && !defined(NDEBUG)
+#define GLOOP_CHECKS true
+#else
+#define GLOOP_CHECKS false
+#endif
+
 #endif